@@ -18,6 +18,7 @@ import QtQuick 2.4
 import QtQuick.Controls 1.4
 import QtQuick.Controls.Styles 1.4
 import QtQuick.Dialogs 1.2
+import QtQuick.Window 2.2
 import Esri.ArcGISExtras 1.1
 
 /*!
@@ -96,6 +97,16 @@ Item {
     */
     property bool showImage: true
 
+    /*!
+        \brief The id of an image provider which decodes and caches the thumbnails.
+        When set, thumbnails are requested as \c {image://<id>/<attachment URL>}
+        so that the provider, such as the ThumbnailImageProvider of the C++ API toolkit plugin,
+        can decode them off the GUI thread and cache them by attachment URL. The full resolution
+        image is still passed to \l imageClicked.
+        The default value is an empty string, which loads the attachment data directly.
+    */
+    property string thumbnailProviderId: ""
+
     /*!
         \brief The color of the title bar of the view.
         The default color is \c "#3F51B5".
@@ -433,7 +444,20 @@ Item {
                                     width: 44 * scaleFactor
                                     height: width
                                     fillMode: Image.PreserveAspectFit
-                                    source: attachmentUrl
+
+                                    // decode a thumbnail of the displayed size off the GUI thread,
+                                    // not the full resolution attachment
+                                    asynchronous: true
+                                    sourceSize.width: width * Screen.devicePixelRatio
+                                    sourceSize.height: height * Screen.devicePixelRatio
+                                    source: {
+                                        // the provider only decodes local attachment data
+                                        var url = String(attachmentUrl);
+                                        if (thumbnailProviderId.length === 0 || !(url.indexOf("file:") === 0 || url.indexOf("qrc:") === 0))
+                                            return attachmentUrl;
+
+                                        return "image://" + thumbnailProviderId + "/" + encodeURIComponent(url);
+                                    }
 
                                     MouseArea {
                                         anchors.fill: parent
@@ -67,6 +67,17 @@ Item {
         autoHide: autoHideCompass
     }
 
+    // when tool initialization is deferred, the controller follows the view from when the compass is first shown
+    onVisibleChanged: {
+        if (visible)
+            controller.initialize();
+    }
+
+    Component.onCompleted: {
+        if (visible)
+            controller.initialize();
+    }
+
     height: 32 * scaleFactor
     width: 32 * scaleFactor
     opacity: 0.85
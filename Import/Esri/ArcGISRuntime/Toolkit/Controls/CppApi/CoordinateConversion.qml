@@ -78,6 +78,25 @@ Item {
      */
     property alias captureMode: coordinateConvController.captureMode
 
+    /*!
+      \qmlproperty bool hoverMode
+      \brief Whether the tool converts the location under the mouse cursor as it moves.
+
+      Conversions are run at most once per \c hoverInterval milliseconds, using
+      the latest cursor position.
+      \since Esri::ArcGISRuntime 100.5
+     */
+    property alias hoverMode: coordinateConvController.hoverMode
+
+    /*!
+      \qmlproperty int hoverInterval
+      \brief The minimum time, in milliseconds, between conversions in hover mode.
+
+      The default value is \c 16.
+      \since Esri::ArcGISRuntime 100.5
+     */
+    property alias hoverInterval: coordinateConvController.hoverInterval
+
     /*!
       \qmlproperty real backgroundOpacity
       \brief The opacity of the background rectangle.
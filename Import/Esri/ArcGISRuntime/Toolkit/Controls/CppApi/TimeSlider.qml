@@ -218,7 +218,7 @@ Item {
 
       The default is \c "true".
       */
-    property bool playbackLoop: true
+    property alias playbackLoop: controller.playbackLoop
 
     /*!
       \qmlproperty bool playbackReverse
@@ -230,7 +230,7 @@ Item {
 
       The default is \c "false".
       */
-    property bool playbackReverse: false
+    property alias playbackReverse: controller.playbackReverse
 
     /*!
       \qmlproperty bool startTimePinned
@@ -239,7 +239,7 @@ Item {
 
       The default is \c "false".
       */
-    property bool startTimePinned: false
+    property alias startTimePinned: controller.startTimePinned
 
     /*!
       \qmlproperty bool endTimePinned
@@ -248,16 +248,35 @@ Item {
 
       The default is \c "false".
       */
-    property bool endTimePinned: false
+    property alias endTimePinned: controller.endTimePinned
 
     /*!
       \qmlproperty int playbackInterval
       \brief The amount of time (in milliseconds) during playback
       that will elapse before the slider advances to the next time step
 
+      Playback also waits for the geoView to finish drawing each step, so
+      this is the minimum time for which a step is shown.
+
       The default is \c 500.
       */
-    property alias playbackInterval : playAnimation.interval
+    property alias playbackInterval : controller.playbackInterval
+
+    /*!
+      \qmlproperty bool skipEmptySteps
+      \brief Whether stepping and playback skip time steps which
+      contain no data.
+
+      Setting this property to \c true counts the features of the
+      time-aware feature layers in each step in the background. Steps
+      are only skipped once every count is known, and the tick marks
+      of empty steps are faded.
+
+      \since Esri.ArcGISRuntime 100.5
+
+      The default is \c "false".
+      */
+    property alias skipEmptySteps: controller.skipEmptySteps
 
     /*!
       \qmlproperty var timeStepIntervalLabelFormat
@@ -270,16 +289,6 @@ Item {
       */
     property var timeStepIntervalLabelFormat
 
-    /*!
-      /internal
-      */
-    property bool animateReverse: false
-
-    /*!
-      /internal
-      */
-    property bool needsRestart: false
-
     Rectangle {
         id: backgroundRectangle
         anchors{
@@ -304,6 +313,7 @@ Item {
 
     TimeSliderController {
         id: controller
+        densityIndexEnabled: skipEmptySteps
 
         onStartStepChanged: {
             if (startStep < 0 || numberOfSteps === -1)
@@ -400,12 +410,7 @@ Item {
             color: fullExtentFillColor
         }
 
-        onClicked: {
-            controller.setStartAndEndIntervals(startTimePinned ? controller.startStep
-                                                               : Math.max(controller.startStep - 1, 0),
-                                               endTimePinned ? controller.endStep
-                                                             : Math.max(controller.endStep - 1, 0));
-        }
+        onClicked: controller.stepBack();
     }
 
     Button {
@@ -424,8 +429,10 @@ Item {
             source: playButton.checked ? "images/pause.png" : "images/play.png"
         }
 
-        checkable: true
-        checked: false
+        // the controller owns the playback state, so the button does not toggle itself
+        checkable: false
+        checked: controller.playing
+        onClicked: controller.playing = !controller.playing
 
         contentItem: Text {
             text: playButton.text
@@ -450,50 +457,6 @@ Item {
         }
     }
 
-    Timer {
-        id: playAnimation
-        running: playButton.checked
-        repeat: true
-        interval: 500
-
-        onTriggered: {
-            var newStart = -1;
-            var newEnd = -1;
-            var atEnd = false;
-
-            if (needsRestart) {
-                newStart = 0;
-                newEnd = controller.endStep - controller.startStep;
-                needsRestart = false;
-                atEnd = newEnd === controller.numberOfSteps - 1;
-            } else {
-                var delta = animateReverse ? -1 : 1;
-                newStart = controller.startStep + delta;
-                newEnd = controller.endStep + delta;
-
-                atEnd = (!startTimePinned && (newStart < 0 || newStart > (controller.numberOfSteps - 1))) ||
-                        (!endTimePinned && (newEnd < 0 || newEnd > (controller.numberOfSteps - 1)));
-            }
-
-            if (!atEnd) {
-                controller.setStartAndEndIntervals(startTimePinned ? controller.startStep
-                                                                   : newStart,
-                                                   endTimePinned ? controller.endStep
-                                                                 : newEnd);
-                return;
-            }
-
-            if (!playbackLoop)
-                playButton.checked = false;
-            else if (playbackReverse)
-                animateReverse = !animateReverse;
-            else if (startTimePinned || endTimePinned)
-                playButton.checked = false;
-            else
-                needsRestart = true;
-        }
-    }
-
     Button {
         id: forwardsButton
         anchors {
@@ -532,12 +495,7 @@ Item {
             color: fullExtentFillColor
         }
 
-        onClicked: {
-            controller.setStartAndEndIntervals(startTimePinned ? controller.startStep
-                                                               : Math.min(controller.startStep + 1, controller.numberOfSteps - 1),
-                                               endTimePinned ? controller.endStep
-                                                             : Math.min(controller.endStep + 1, controller.numberOfSteps - 1));
-        }
+        onClicked: controller.stepForward();
     }
 
     RangeSlider {
@@ -605,9 +563,11 @@ Item {
 
                 Repeater {
                     id: steps
-                    model: controller.numberOfSteps === -1 ? 0 : controller.numberOfSteps
+                    model: controller.steps
                     Rectangle {
                         width: tickMarksRow.stepsWidth
+                        // fade the ticks of steps which are known to have no data
+                        opacity: stepCount === 0 ? 0.25 : 1.0
                         height: index % 10 === 0 ? sliderBar.height : sliderBar.height * 0.5
                         color: tickMarksRow.spacing < (5 * scaleFactor) ? (index % 5 === 0 ? "black" : "transparent")
                                                                         : "black"
@@ -620,10 +580,10 @@ Item {
                             color: textColor
                             horizontalAlignment: Text.AlignHCenter
                             visible: (labelMode === labelModeTicks) && index % labelSliderTickInterval === 0 && parent.color !== "transparent"
-                            text: controller.stepTimes[index] ? timeStepIntervalLabelFormat ?
-                                                                    Qt.formatDateTime(controller.stepTimes[index], timeStepIntervalLabelFormat)
-                                                                  : Qt.formatDateTime(controller.stepTimes[index])
-                                                              : ""
+                            // only the labels which are shown request their step time
+                            text: visible ? (timeStepIntervalLabelFormat ? Qt.formatDateTime(controller.stepTime(index), timeStepIntervalLabelFormat)
+                                                                         : Qt.formatDateTime(controller.stepTime(index)))
+                                          : ""
                         }
                     }
                 }
@@ -31,6 +31,11 @@ Item {
     property var overviewLayer: null
     property string fillColor : "#60000000"
     property real zoomRatio: 10
+    // the smallest movement of the visible area, as a fraction of its size, which redraws the overview
+    property real extentEpsilon: 1e-6
+    // the minimum time in milliseconds between redraws while the parent view moves
+    property alias updateInterval: updateTimer.interval
+    property var lastExtent: null
     property real displayScaleFactor: (Screen.logicalPixelDensity * 25.4) / (Qt.platform.os === "windows" || Qt.platform.os === "linux" ? 96 : 72)
 
     width: 200 * displayScaleFactor
@@ -50,9 +55,13 @@ Item {
         if (overviewmap.map.loadStatus !== Enums.LoadStatusLoaded)
             return;
 
+        var v = parentMapview.visibleArea.extent;
+        if (!extentMoved(v))
+            return;
+        lastExtent = {xMin: v.xMin, yMin: v.yMin, xMax: v.xMax, yMax: v.yMax};
+
         aoiLayer.graphics.clear();
         var e = parentMapview.map.initialViewpoint.extent;
-        var v = parentMapview.visibleArea.extent;
 
         var part1 = ArcGISRuntimeEnvironment.createObject("Part");
         part1.spatialReference = overviewmap.map.spatialReference
@@ -86,11 +95,34 @@ Item {
         aoiLayer.graphics.append(polygonGraphic);
     }
 
+    function extentMoved(v) {
+        if (!lastExtent)
+            return true;
+
+        var tolerance = extentEpsilon * Math.max(Math.abs(lastExtent.xMax - lastExtent.xMin),
+                                                 Math.abs(lastExtent.yMax - lastExtent.yMin));
+        return Math.abs(v.xMin - lastExtent.xMin) > tolerance ||
+               Math.abs(v.yMin - lastExtent.yMin) > tolerance ||
+               Math.abs(v.xMax - lastExtent.xMax) > tolerance ||
+               Math.abs(v.yMax - lastExtent.yMax) > tolerance;
+    }
+
+    onParentMapviewChanged: lastExtent = null
+
+    // redraw at most once per frame while the parent view moves
+    Timer {
+        id: updateTimer
+        interval: 16
+        repeat: false
+        onTriggered: updateView()
+    }
+
     Connections {
         target: parentMapview
 
         onVisibleAreaChanged: {
-            updateView();
+            if (!updateTimer.running)
+                updateTimer.start();
         }
     }
 
@@ -81,6 +81,20 @@ Item {
     */
     property var popupManagers: null
 
+    /*!
+        \brief A PopupStackModel which creates PopupManagers as they are displayed.
+
+        When set, this is used instead of \c popupManagers. Only the displayed
+        Popup and the next one have PopupManagers, which saves time and
+        memory when an identify returns many results.
+        PopupStackModel is only available with the C++ API.
+    */
+    property var popupStackModel: null
+
+    /*! \internal */
+    property int popupCount: popupStackModel ? popupStackModel.totalCount
+                                             : (popupManagers !== null ? popupManagers.length : 0)
+
     /*!
         \brief The background color of the PopupStackView.
 
@@ -199,8 +213,8 @@ Item {
     function show() {
         currentIndex = 0;
         popupStack.clear();
-        if (popupManagers !== null && popupManagers.length > 0) {
-            popup1.popupManagerInternal = popupManagers[currentIndex]
+        if (popupCount > 0) {
+            popup1.popupManagerInternal = popupManagerAt(currentIndex)
             popupStack.push(popup1);
         }
         visible = true;
@@ -292,20 +306,31 @@ Item {
     */
     signal attachmentThumbnailClicked(var index)
 
+    /*! internal */
+    function popupManagerAt(index) {
+        if (popupStackModel) {
+            // the model creates the PopupManagers of this popup and the next one
+            popupStackModel.currentIndex = index;
+            return popupStackModel.popupManager(index);
+        }
+
+        return popupManagers[index];
+    }
+
     /*! internal */
     function nextPopup() {
-        if (currentIndex + 1 === popupManagers.length)
+        if (currentIndex + 1 >= popupCount)
             return;
 
         currentIndex += 1;
 
         if (popupStack.currentItem === popup1) {
-            popup2.popupManagerInternal = popupManagers[currentIndex]
+            popup2.popupManagerInternal = popupManagerAt(currentIndex)
             popupStack.push(popup2);
         }
         else
         {
-            popup1.popupManagerInternal = popupManagers[currentIndex]
+            popup1.popupManagerInternal = popupManagerAt(currentIndex)
             popupStack.push(popup1);
         }
 
@@ -319,9 +344,9 @@ Item {
         currentIndex -= 1;
 
         if (popupStack.currentItem === popup2)
-            popup1.popupManagerInternal = popupManagers[currentIndex];
+            popup1.popupManagerInternal = popupManagerAt(currentIndex);
         else
-            popup2.popupManagerInternal = popupManagers[currentIndex];
+            popup2.popupManagerInternal = popupManagerAt(currentIndex);
 
         popupStack.pop();
     }
@@ -405,7 +430,7 @@ Item {
             radius: radius
             width: parent.width
             height: parent.height / 12
-            visible: popupManagers !== null && popupManagers.length > 1
+            visible: popupCount > 1
 
             Canvas {
                 id: previousButtonCanvas
@@ -442,7 +467,7 @@ Item {
                     margins: 5 * displayScaleFactor
                 }
                 color: attributeNameTextColor
-                text: popupManagers !== null && popupManagers.length > 0 ? (currentIndex + 1) + " of " + popupManagers.length : ""
+                text: popupCount > 0 ? (currentIndex + 1) + " of " + popupCount : ""
             }
 
             Canvas {
@@ -615,10 +615,10 @@ Item {
                             horizontalAlignment: Text.AlignHCenter
                             color: textColor
                             visible: (labelMode === labelModeTicks) && index % labelSliderTickInterval === 0 && parent.color !== "transparent"
-                            text: controller.stepTimes[index] ? timeStepIntervalLabelFormat ?
-                                                                    Qt.formatDateTime(controller.stepTimes[index], timeStepIntervalLabelFormat)
-                                                                  : Qt.formatDateTime(controller.stepTimes[index])
-                                                              : ""
+                            // only the labels which are shown request their step time
+                            text: visible && controller.stepTime(index) ? (timeStepIntervalLabelFormat ? Qt.formatDateTime(controller.stepTime(index), timeStepIntervalLabelFormat)
+                                                                                                       : Qt.formatDateTime(controller.stepTime(index)))
+                                                                        : ""
                         }
                     }
                 }
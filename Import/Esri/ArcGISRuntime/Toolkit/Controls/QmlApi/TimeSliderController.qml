@@ -29,6 +29,10 @@ import Esri.ArcGISRuntime 100.3
     These steps allow the temporal extent to be set and animated by stepping through
     the range.
 
+    When the C++ toolkit plugin is registered, the step arithmetic is shared
+    with the C++ API (see TimeSliderStepsModel) rather than calculated in
+    JavaScript.
+
     \note The controller will be automatically created by a TimeSlider
     so you do not need to create this type.
 */
@@ -122,16 +126,78 @@ Item {
      \qmlproperty int startStep
      \brief The start step of the current time extent (read-only).
      */
-    property int startStep: currentExtent && fullExtent ? (currentExtent.startTime.getTime() - fullExtent.startTime.getTime()) / intervalMS : -1
+    property int startStep: currentExtent && fullExtent ? stepIndex(currentExtent.startTime) : -1
 
     /*!
      \qmlproperty int endStep
      \brief The end step of the current time extent (read-only).
      */
-    property int endStep: currentExtent && fullExtent ? (currentExtent.endTime.getTime() - fullExtent.startTime.getTime()) / intervalMS : -1
+    property int endStep: currentExtent && fullExtent ? stepIndex(currentExtent.endTime) : -1
+
+    /*!
+     \qmlproperty list stepTimes
+     \brief The start time of every step (read-only).
 
+     This list is only filled when the C++ toolkit plugin is not available.
+     Use \l stepTime to get the time of a step in either case.
+     */
     property var stepTimes: []
 
+    /*!
+     \internal
+
+     The native steps model from the C++ toolkit plugin, or \c null when the
+     plugin has not been registered.
+     */
+    property var nativeSteps: null
+
+    /*!
+     \internal
+
+     Changes whenever the steps change, so bindings which use the native steps re-evaluate.
+     */
+    property int stepsRevision: 0
+
+    Component.onCompleted: {
+        try {
+            nativeSteps = Qt.createQmlObject("import Esri.ArcGISRuntime.Toolkit.CppApi 100.5; TimeSliderStepsModel {}",
+                                             controller, "TimeSliderStepsModel");
+        } catch (error) {
+            // the C++ toolkit plugin is not registered, so the steps are calculated in JavaScript
+            nativeSteps = null;
+        }
+
+        if (nativeSteps && numberOfSteps > 0)
+            setStepTimes();
+    }
+
+    /*!
+     \qmlmethod date stepTime(int index)
+     \brief Returns the start time of the step \a index.
+     \since Esri.ArcGISRuntime 100.5
+     */
+    function stepTime(index) {
+        // reading stepsRevision re-evaluates bindings when the steps change
+        if (stepsRevision < 0 || index < 0 || index >= numberOfSteps)
+            return null;
+
+        if (nativeSteps)
+            return nativeSteps.stepTime(index);
+
+        return stepTimes[index];
+    }
+
+    /*! \internal */
+    function stepIndex(time) {
+        if (stepsRevision < 0 || !time)
+            return -1;
+
+        if (nativeSteps)
+            return nativeSteps.stepIndex(time);
+
+        return (time.getTime() - fullExtent.startTime.getTime()) / intervalMS;
+    }
+
     function setStartAndEndIntervals(startIndex, endIndex) {
         if (!fullExtent)
             return;
@@ -305,6 +371,13 @@ Item {
 
     /*! \internal */
     function setStepTimes() {
+        if (nativeSteps) {
+            nativeSteps.setSteps(fullExtentStart, intervalMS, numberOfSteps);
+            stepTimes = [];
+            stepsRevision++;
+            return;
+        }
+
         var tempStepTimes = [];
 
         var startMs = fullExtentStart.getTime();
@@ -312,6 +385,7 @@ Item {
           tempStepTimes.push( new Date(startMs + (i * intervalMS)) );
 
         stepTimes = tempStepTimes;
+        stepsRevision++;
     }
 
     /*! \internal */
@@ -14,6 +14,10 @@
 #  limitations under the License.
 ################################################################################
 
+# build with CONFIG+=toolkit_startup to compile the toolkit QML ahead of time
+# instead of parsing it on startup
+toolkit_startup: CONFIG += qtquickcompiler
+
 HEADERS += $$PWD/ArcGISRuntimeToolkitPlugin.h
 
 SOURCES += $$PWD/ArcGISRuntimeToolkitPlugin.cpp
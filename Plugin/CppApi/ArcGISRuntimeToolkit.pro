@@ -22,6 +22,13 @@ CONFIG += c++11 plugin
 
 DEFINES += QTRUNTIME_TOOLKIT_BUILD
 
+# build with CONFIG+=toolkit_profiling to compile in the ToolkitProfiler scopes
+toolkit_profiling: DEFINES += TOOLKIT_PROFILING
+
+# build with CONFIG+=toolkit_startup to defer the initialization of each tool
+# until it is first shown or activated
+toolkit_startup: DEFINES += TOOLKIT_DEFERRED_INITIALIZATION
+
 HEADERS += $$PWD/include/*.h \
            $$PWD/include/CoordinateConversion/*.h
 SOURCES += $$PWD/source/*.cpp \
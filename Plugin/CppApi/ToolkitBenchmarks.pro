@@ -0,0 +1,50 @@
+################################################################################
+#  Copyright 2012-2018 Esri
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+################################################################################
+
+# QtTest benchmarks of the toolkit's hot paths. Build the toolkit library
+# first, then run "make benchmark" to write benchmarks.xml next to the
+# executable. The benchmarks run on the offscreen platform, so no display
+# is needed.
+
+TARGET = ToolkitBenchmarks
+TEMPLATE = app
+
+QT += core gui opengl network positioning sensors qml quick testlib
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+SOURCES += $$PWD/benchmarks/ToolkitBenchmarks.cpp
+
+RUNTIME_PRI = arcgis_runtime_qml_cpp.pri
+ARCGIS_RUNTIME_VERSION = 100.4
+
+!CONFIG(daily) {
+  include($$PWD/arcgisruntime.pri)
+} else {
+  include($$PWD/dev_build_config.pri)
+}
+
+# links against the toolkit library in the output folder
+include($$PWD/ArcGISRuntimeToolkit.pri)
+
+unix:!macx:!android:!ios: {
+  LIBS += -lstdc++
+}
+
+# machine readable results for tracking across releases, and a summary on the console
+benchmark.commands = ./$$TARGET -o benchmarks.xml,xml -o -,txt
+benchmark.depends = $$TARGET
+QMAKE_EXTRA_TARGETS += benchmark
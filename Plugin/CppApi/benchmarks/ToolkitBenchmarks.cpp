@@ -0,0 +1,431 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// toolkit headers
+#include "AbstractTool.h"
+#include "CoordinateConversionBatchResults.h"
+#include "CoordinateConversionConstants.h"
+#include "CoordinateConversionController.h"
+#include "CoordinateConversionOptions.h"
+#include "CoordinateConversionResults.h"
+#include "CoordinateFormatFactory.h"
+#include "CoordinateFormatRegistry.h"
+#include "TimeSliderLayerTimes.h"
+#include "TimeSliderSteps.h"
+#include "ToolManager.h"
+#include "ToolResourceProvider.h"
+
+// C++ API headers
+#include "FeatureCollectionTable.h"
+#include "FeatureLayer.h"
+#include "Field.h"
+#include "LayerListModel.h"
+#include "Map.h"
+#include "Point.h"
+#include "SpatialReference.h"
+#include "TimeExtent.h"
+#include "TimeValue.h"
+
+// Qt headers
+#include <QGuiApplication>
+#include <QMouseEvent>
+#include <QSignalSpy>
+#include <QtTest>
+
+// STL headers
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// a tool which only counts the mouse moves it is sent
+class CountingTool : public AbstractTool
+{
+public:
+  explicit CountingTool(QObject* parent = nullptr) :
+    AbstractTool(parent)
+  {
+  }
+
+  QString toolName() const override
+  {
+    return QStringLiteral("CountingTool");
+  }
+
+  int moves = 0;
+
+protected:
+  QList<QMetaObject::Connection> connectEventStreams(ToolResourceProvider* resourceProvider) override
+  {
+    QList<QMetaObject::Connection> connections;
+    connections.append(connect(resourceProvider, &ToolResourceProvider::mouseMoved, this, [this](QMouseEvent&)
+    {
+      ++moves;
+    }));
+    return connections;
+  }
+};
+
+// points spread over the world, so that cached conversions are not reused
+QList<Point> syntheticPoints(int count)
+{
+  QList<Point> points;
+  points.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    const double x = -179.0 + std::fmod(i * 0.7919, 358.0);
+    const double y = -79.0 + std::fmod(i * 0.3571, 158.0);
+    points.append(Point(x, y, SpatialReference::wgs84()));
+  }
+
+  return points;
+}
+
+// adds an input format and then format, so that each conversion produces a notation in format
+CoordinateConversionOptions* addOutputFormat(CoordinateConversionController& controller, const QString& format)
+{
+  const bool isDecimalDegrees = format.compare(CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT, Qt::CaseInsensitive) == 0;
+  const QString inputFormat = isDecimalDegrees ? CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT
+                                               : CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT;
+  controller.addOption(CoordinateFormatFactory::createFormat(inputFormat, &controller));
+
+  CoordinateConversionOptions* option = CoordinateFormatFactory::createFormat(format, &controller);
+  if (option)
+    controller.addOption(option);
+
+  return option;
+}
+
+// the notation the controller last published for format
+QString publishedNotation(CoordinateConversionController& controller, const QString& format)
+{
+  QAbstractListModel* results = controller.results();
+  for (int row = 0; row < results->rowCount(); ++row)
+  {
+    const QModelIndex index = results->index(row);
+    if (results->data(index, CoordinateConversionResults::CoordinateConversionResultsNameRole).toString() == format)
+      return results->data(index, CoordinateConversionResults::CoordinateConversionResultsNotationRole).toString();
+  }
+
+  return QString();
+}
+
+void addFormatRows()
+{
+  QTest::addColumn<QString>("format");
+
+  const QStringList formats = CoordinateFormatRegistry::instance().formatNames();
+  for (const QString& format : formats)
+    QTest::newRow(qPrintable(format)) << format;
+}
+
+}
+
+/*!
+  \internal
+  \brief QtTest benchmarks of the toolkit's hot paths.
+
+  Run with \c {-o benchmarks.xml,xml} for results which can be compared
+  between releases. Only the public API of the measured classes is used.
+ */
+class ToolkitBenchmarks : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void convertPoint_data();
+  void convertPoint();
+  void convertPoints_data();
+  void convertPoints();
+  void notationRoundTrip_data();
+  void notationRoundTrip();
+  void initializeTimeProperties_data();
+  void initializeTimeProperties();
+  void stepLookup_data();
+  void stepLookup();
+  void resultsUpdate_data();
+  void resultsUpdate();
+  void mouseMoveFanOut_data();
+  void mouseMoveFanOut();
+};
+
+void ToolkitBenchmarks::convertPoint_data()
+{
+  addFormatRows();
+}
+
+void ToolkitBenchmarks::convertPoint()
+{
+  QFETCH(QString, format);
+
+  CoordinateConversionController controller;
+  controller.setSpatialReference(SpatialReference::wgs84());
+  QVERIFY(addOutputFormat(controller, format));
+
+  const QList<Point> points = syntheticPoints(1024);
+  int i = 0;
+  QBENCHMARK
+  {
+    controller.setPointToConvert(points.at(i++ % points.size()));
+  }
+}
+
+void ToolkitBenchmarks::convertPoints_data()
+{
+  QTest::addColumn<QString>("format");
+  QTest::addColumn<int>("batchSize");
+
+  const QStringList formats = CoordinateFormatRegistry::instance().formatNames();
+  for (const QString& format : formats)
+  {
+    for (int batchSize : {1, 100, 10000})
+      QTest::newRow(qPrintable(QStringLiteral("%1/%2").arg(format).arg(batchSize))) << format << batchSize;
+  }
+}
+
+void ToolkitBenchmarks::convertPoints()
+{
+  QFETCH(QString, format);
+  QFETCH(int, batchSize);
+
+  CoordinateConversionController controller;
+  controller.setSpatialReference(SpatialReference::wgs84());
+  QVERIFY(addOutputFormat(controller, format));
+
+  const QList<Point> points = syntheticPoints(batchSize);
+  QSignalSpy completed(&controller, &CoordinateConversionController::batchCompleted);
+
+  QBENCHMARK
+  {
+    // every iteration converts the points again, rather than reading them from the cache
+    controller.clearCache();
+    completed.clear();
+    controller.convertPoints(points);
+    if (completed.isEmpty())
+      QVERIFY(completed.wait(60000));
+  }
+}
+
+void ToolkitBenchmarks::notationRoundTrip_data()
+{
+  addFormatRows();
+}
+
+void ToolkitBenchmarks::notationRoundTrip()
+{
+  QFETCH(QString, format);
+
+  CoordinateConversionController controller;
+  controller.setSpatialReference(SpatialReference::wgs84());
+  QVERIFY(addOutputFormat(controller, format));
+
+  controller.setPointToConvert(Point(-117.195, 34.056, SpatialReference::wgs84()));
+  const QString notation = publishedNotation(controller, format);
+  if (notation.isEmpty())
+    QSKIP("The format does not produce a notation for the sample point");
+
+  // the notation is read in format and converted back to the other format
+  controller.setInputFormat(format);
+
+  QBENCHMARK
+  {
+    controller.convertNotation(notation);
+  }
+}
+
+void ToolkitBenchmarks::initializeTimeProperties_data()
+{
+  QTest::addColumn<int>("layerCount");
+  QTest::addColumn<int>("stepCount");
+
+  QTest::newRow("1 layer/10 steps") << 1 << 10;
+  QTest::newRow("10 layers/100 steps") << 10 << 100;
+  QTest::newRow("100 layers/100 steps") << 100 << 100;
+  QTest::newRow("100 layers/1000 steps") << 100 << 1000;
+  QTest::newRow("1000 layers/100 steps") << 1000 << 100;
+}
+
+void ToolkitBenchmarks::initializeTimeProperties()
+{
+  QFETCH(int, layerCount);
+  QFETCH(int, stepCount);
+
+  Map map;
+  for (int i = 0; i < layerCount; ++i)
+  {
+    auto table = new FeatureCollectionTable(QList<Field>(), GeometryType::Point, SpatialReference::wgs84(), &map);
+    map.operationalLayers()->append(new FeatureLayer(table, &map));
+  }
+
+  // the layers never load, so their time properties are given as though they had; the last
+  // step is the one containing the end, so stepCount steps end one interval early
+  const QDateTime start(QDate(2018, 1, 1), QTime(0, 0), Qt::UTC);
+  const QDateTime end = start.addSecs(60 * (stepCount - 1));
+  TimeSliderLayerTimes layerTimes;
+  for (int layerIndex = 0; layerIndex < layerCount; ++layerIndex)
+  {
+    // staggered extents, so the union grows with the number of layers
+    const QDateTime layerStart = start.addSecs(60 * (layerIndex % stepCount));
+    Layer* layer = map.operationalLayers()->at(layerIndex);
+    layerTimes.insert(layer);
+    layerTimes.setTimeProperties(layer, TimeExtent(layerStart, end), TimeValue(1.0, TimeUnit::Minutes));
+  }
+
+  // the work of TimeSliderController::initializeTimeProperties: the union of the layers and its steps
+  TimeSliderSteps steps;
+  QBENCHMARK
+  {
+    const auto timeUnion = layerTimes.timeUnion();
+    steps = TimeSliderSteps::fromInterval(timeUnion.fullTimeExtent.startTime(), timeUnion.fullTimeExtent.endTime(),
+                                          timeUnion.timeInterval);
+  }
+
+  QCOMPARE(steps.numberOfSteps(), stepCount);
+}
+
+void ToolkitBenchmarks::stepLookup_data()
+{
+  QTest::addColumn<int>("unit");
+  QTest::addColumn<int>("years");
+
+  QTest::newRow("minutes/1 year") << static_cast<int>(TimeUnit::Minutes) << 1;
+  QTest::newRow("days/100 years") << static_cast<int>(TimeUnit::Days) << 100;
+  QTest::newRow("months/100 years") << static_cast<int>(TimeUnit::Months) << 100;
+  QTest::newRow("years/1000 years") << static_cast<int>(TimeUnit::Years) << 1000;
+}
+
+void ToolkitBenchmarks::stepLookup()
+{
+  QFETCH(int, unit);
+  QFETCH(int, years);
+
+  const QDateTime start(QDate(1900, 1, 1), QTime(0, 0), Qt::UTC);
+  const auto steps = TimeSliderSteps::fromInterval(start, start.addYears(years), TimeValue(1.0, static_cast<TimeUnit>(unit)));
+  QVERIFY(steps.numberOfSteps() > 1);
+
+  // the lookups a slider drag makes: a step to its time and back
+  const int lastStep = steps.numberOfSteps() - 1;
+  int i = 0;
+  QBENCHMARK
+  {
+    const int stepIndex = static_cast<int>((static_cast<qint64>(i++) * 7919) % lastStep);
+    QCOMPARE(steps.stepIndex(steps.stepStart(stepIndex)), stepIndex);
+  }
+}
+
+void ToolkitBenchmarks::resultsUpdate_data()
+{
+  QTest::addColumn<int>("resultCount");
+
+  for (int resultCount : {1, 8, 64, 512})
+    QTest::newRow(qPrintable(QString::number(resultCount))) << resultCount;
+}
+
+void ToolkitBenchmarks::resultsUpdate()
+{
+  QFETCH(int, resultCount);
+
+  CoordinateConversionController controller;
+  controller.setSpatialReference(SpatialReference::wgs84());
+  controller.addOption(CoordinateFormatFactory::createFormat(CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT, &controller));
+
+  // custom formats with trivial formatters, so the time goes on publishing the results
+  for (int i = 0; i < resultCount; ++i)
+  {
+    const QString name = QStringLiteral("Benchmark Format %1").arg(i);
+    CoordinateFormatRegistry::instance().registerFormat(name, [i](const Point& point)
+    {
+      return QStringLiteral("%1 %2 %3").arg(i).arg(point.x()).arg(point.y());
+    }, CoordinateFormatRegistry::Parser());
+    controller.addOption(CoordinateFormatFactory::createFormat(name, &controller));
+  }
+
+  // two points, as published by consecutive conversions with the same names
+  const Point first(1.0, 2.0, SpatialReference::wgs84());
+  const Point second(-1.0, -2.0, SpatialReference::wgs84());
+  bool useFirst = true;
+  QBENCHMARK
+  {
+    controller.setPointToConvert(useFirst ? first : second);
+    useFirst = !useFirst;
+  }
+
+  QCOMPARE(controller.results()->rowCount(), resultCount);
+}
+
+void ToolkitBenchmarks::mouseMoveFanOut_data()
+{
+  QTest::addColumn<int>("toolCount");
+
+  for (int toolCount : {1, 10, 100})
+    QTest::newRow(qPrintable(QString::number(toolCount))) << toolCount;
+}
+
+void ToolkitBenchmarks::mouseMoveFanOut()
+{
+  QFETCH(int, toolCount);
+
+  ToolResourceProvider* provider = ToolResourceProvider::instance();
+  const bool coalescing = provider->isCoalescingMouseMoves();
+  provider->setCoalescingMouseMoves(false);
+
+  std::vector<std::unique_ptr<CountingTool>> tools;
+  for (int i = 0; i < toolCount; ++i)
+  {
+    tools.emplace_back(new CountingTool);
+    ToolManager::instance().addTool(tools.back().get());
+    tools.back()->setActive(true);
+  }
+
+  QMouseEvent mouseEvent(QEvent::MouseMove, QPointF(100.0, 100.0), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+  QBENCHMARK
+  {
+    provider->onMouseMoved(mouseEvent);
+  }
+
+  QVERIFY(tools.front()->moves > 0);
+
+  for (const auto& tool : tools)
+    ToolManager::instance().removeTool(tool.get());
+
+  provider->setCoalescingMouseMoves(coalescing);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+int main(int argc, char* argv[])
+{
+  // the benchmarks run on build machines without a display
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QGuiApplication app(argc, argv);
+  Esri::ArcGISRuntime::Toolkit::ToolkitBenchmarks benchmarks;
+  return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "ToolkitBenchmarks.moc"
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// toolkit headers
+#include "CoordinateConversionPipeline.h"
+#include "CoordinateFormatRegistry.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+
+using namespace Esri::ArcGISRuntime;
+using namespace Esri::ArcGISRuntime::Toolkit;
+
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("CoordinateConversionCli");
+
+  const QString formats = CoordinateFormatRegistry::instance().formatNames().join(", ");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QString("Converts a file of coordinate notations to other notations.\n"
+                                           "Formats: %1").arg(formats));
+  parser.addHelpOption();
+  parser.addPositionalArgument("input", "The file to read, or - for standard input.");
+  parser.addPositionalArgument("output", "The file to write, or - (the default) for standard output.", "[output]");
+
+  const QCommandLineOption fromOption("from", "The format of the notations in the input.", "format");
+  const QCommandLineOption toOption("to", "A format to convert to. May be given more than once.", "format");
+  const QCommandLineOption wkidOption("wkid", "The wkid of the spatial reference to read points into (default 4326).", "wkid", "4326");
+  const QCommandLineOption columnOption("column", "The zero-based field holding the notation (default 0).", "column", "0");
+  const QCommandLineOption delimiterOption("delimiter", "The field delimiter (default ,). Use \\t for a tab.", "delimiter", ",");
+  const QCommandLineOption headerOption("header", "The first line of the input is a header.");
+  const QCommandLineOption chunkSizeOption("chunk-size", "The number of records converted together (default 4096).", "count", "4096");
+  parser.addOptions({fromOption, toOption, wkidOption, columnOption, delimiterOption, headerOption, chunkSizeOption});
+
+  parser.process(app);
+
+  QTextStream errors(stderr);
+  const QStringList arguments = parser.positionalArguments();
+  if (arguments.isEmpty() || !parser.isSet(fromOption) || !parser.isSet(toOption))
+  {
+    errors << "An input, --from and at least one --to are required." << endl;
+    parser.showHelp(1);
+  }
+
+  CoordinateConversionPipeline pipeline;
+  if (!pipeline.setInputFormat(parser.value(fromOption)))
+  {
+    errors << pipeline.errorString() << endl;
+    return 1;
+  }
+
+  for (const QString& format : parser.values(toOption))
+  {
+    if (!pipeline.addOutputFormat(format))
+    {
+      errors << pipeline.errorString() << endl;
+      return 1;
+    }
+  }
+
+  bool ok = false;
+  const int wkid = parser.value(wkidOption).toInt(&ok);
+  if (!ok)
+  {
+    errors << "The wkid must be a number." << endl;
+    return 1;
+  }
+  pipeline.setSpatialReference(SpatialReference(wkid));
+
+  pipeline.setColumn(parser.value(columnOption).toInt());
+  pipeline.setHasHeader(parser.isSet(headerOption));
+  pipeline.setChunkSize(parser.value(chunkSizeOption).toInt());
+
+  const QString delimiter = parser.value(delimiterOption);
+  if (delimiter == "\\t")
+  {
+    pipeline.setDelimiter(QLatin1Char('\t'));
+  }
+  else if (delimiter.size() == 1 && delimiter.at(0).toLatin1() != 0)
+  {
+    pipeline.setDelimiter(delimiter.at(0));
+  }
+  else
+  {
+    errors << "The delimiter must be a single character." << endl;
+    return 1;
+  }
+
+  // files are memory mapped by the pipeline, standard input is streamed
+  QFile input;
+  const QString inputPath = arguments.at(0);
+  bool inputOpened = false;
+  if (inputPath == "-")
+  {
+    inputOpened = input.open(stdin, QIODevice::ReadOnly);
+  }
+  else
+  {
+    input.setFileName(inputPath);
+    inputOpened = input.open(QIODevice::ReadOnly);
+  }
+
+  if (!inputOpened)
+  {
+    errors << "Cannot open " << inputPath << ": " << input.errorString() << endl;
+    return 1;
+  }
+
+  QFile output;
+  const QString outputPath = arguments.size() > 1 ? arguments.at(1) : QString("-");
+  bool outputOpened = false;
+  if (outputPath == "-")
+  {
+    outputOpened = output.open(stdout, QIODevice::WriteOnly);
+  }
+  else
+  {
+    output.setFileName(outputPath);
+    outputOpened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+  }
+
+  if (!outputOpened)
+  {
+    errors << "Cannot open " << outputPath << ": " << output.errorString() << endl;
+    return 1;
+  }
+
+  if (!pipeline.run(&input, &output))
+  {
+    errors << pipeline.errorString() << endl;
+    return 1;
+  }
+
+  errors << pipeline.convertedCount() << " converted, " << pipeline.failedCount() << " failed." << endl;
+
+  return 0;
+}
@@ -20,6 +20,7 @@
 #include "ToolkitCommon.h"
 
 #include <QObject>
+#include <QPointer>
 #include <QString>
 #include <QVariantMap>
 
@@ -34,6 +35,9 @@ class Point;
 namespace Toolkit
 {
 
+class ToolManager;
+class ToolResourceProvider;
+
 class TOOLKIT_EXPORT AbstractTool : public QObject
 {
   Q_OBJECT
@@ -41,6 +45,9 @@ class TOOLKIT_EXPORT AbstractTool : public QObject
   /*! \internal */
   Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
 
+  // whether the tool has connected to its resource provider and done its initial work
+  Q_PROPERTY(bool initialized READ isInitialized NOTIFY initializedChanged)
+
 public:
   AbstractTool(QObject* parent = nullptr);
   virtual ~AbstractTool();
@@ -53,13 +60,35 @@ public:
   virtual void setActive(bool active);
   bool isActive() const;
 
+  ToolResourceProvider* resourceProvider() const;
+  void setResourceProvider(ToolResourceProvider* resourceProvider);
+
+  Q_INVOKABLE void initialize();
+  bool isInitialized() const;
+
+  static bool isInitializationDeferred();
+  static void setInitializationDeferred(bool deferred);
+
 signals:
   void activeChanged();
+  void initializedChanged();
+  void resourceProviderChanged();
   void errorOccurred(const Error& error);
   void propertyChanged(const QString& propertyName, const QVariant& propertyValue);
 
 protected:
+  virtual QList<QMetaObject::Connection> connectEventStreams(ToolResourceProvider* resourceProvider);
+
+  virtual void initializeTool();
+  void initializeUnlessDeferred();
+
   bool m_active = false;
+
+private:
+  friend class ToolManager;
+
+  QPointer<ToolResourceProvider> m_resourceProvider;
+  bool m_initialized = false;
 };
 
 } // Toolkit
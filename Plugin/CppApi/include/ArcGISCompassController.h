@@ -30,6 +30,9 @@ class GeoView;
 
 namespace Toolkit
 {
+
+class ViewpointObserver;
+
 class TOOLKIT_EXPORT ArcGISCompassController : public AbstractTool
 {
   Q_OBJECT
@@ -62,7 +65,14 @@ public:
 
   QString toolName() const override;
 
+protected:
+  void initializeTool() override;
+
 private:
+  void connectResourceProvider();
+  void connectViewpointObserver(ViewpointObserver* observer);
+
+  QMetaObject::Connection m_geoViewConnection;
   double m_heading = 0.0;
   bool m_autoHide = true;
   Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
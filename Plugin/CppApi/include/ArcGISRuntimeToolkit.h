@@ -39,6 +39,7 @@ public:
   explicit ArcGISRuntimeToolkit(QObject* parent = nullptr);
 
   void registerTypes(const char* uri);
+  void initializeEngine(QQmlEngine* engine, const char* uri) override;
 
   static void registerToolkitTypes(const char* uri = "Esri.ArcGISRuntime.Toolkit.CppApi");
 
@@ -46,6 +47,7 @@ private:
   static constexpr int s_versionMajor100 = 100;
   static constexpr int s_versionMinorUpdate2 = 2;
   static constexpr int s_versionMinorUpdate3 = 3;
+  static constexpr int s_versionMinorUpdate5 = 5;
 };
 
 } // Toolkit
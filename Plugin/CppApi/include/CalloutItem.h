@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef CALLOUTITEM_H
+#define CALLOUTITEM_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QColor>
+#include <QPointF>
+#include <QQuickItem>
+#include <QVector>
+
+class QSGGeometry;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CalloutItem : public QQuickItem
+{
+  Q_OBJECT
+
+  // the point, in the coordinates of the parent item, which the tip of the leader touches
+  Q_PROPERTY(QPointF anchorPoint READ anchorPoint WRITE setAnchorPoint NOTIFY anchorPointChanged)
+  Q_PROPERTY(LeaderPosition leaderPosition READ leaderPosition WRITE setLeaderPosition NOTIFY leaderPositionChanged)
+  Q_PROPERTY(qreal leaderWidth READ leaderWidth WRITE setLeaderWidth NOTIFY leaderWidthChanged)
+  Q_PROPERTY(qreal leaderHeight READ leaderHeight WRITE setLeaderHeight NOTIFY leaderHeightChanged)
+  Q_PROPERTY(qreal cornerRadius READ cornerRadius WRITE setCornerRadius NOTIFY cornerRadiusChanged)
+  Q_PROPERTY(qreal cornerOffset READ cornerOffset WRITE setCornerOffset NOTIFY cornerOffsetChanged)
+  Q_PROPERTY(qreal borderWidth READ borderWidth WRITE setBorderWidth NOTIFY borderWidthChanged)
+  Q_PROPERTY(QColor borderColor READ borderColor WRITE setBorderColor NOTIFY borderColorChanged)
+  Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
+
+  // the rounded rectangle inside the item, where the content of the callout goes
+  Q_PROPERTY(QRectF contentRect READ contentRect NOTIFY contentRectChanged)
+
+public:
+  // the same values as LeaderPosition.js, without Automatic
+  enum LeaderPosition
+  {
+    LeaderPositionUpperLeft = 0,
+    LeaderPositionTop,
+    LeaderPositionUpperRight,
+    LeaderPositionRight,
+    LeaderPositionLowerRight,
+    LeaderPositionBottom,
+    LeaderPositionLowerLeft,
+    LeaderPositionLeft
+  };
+  Q_ENUM(LeaderPosition)
+
+  explicit CalloutItem(QQuickItem* parent = nullptr);
+  ~CalloutItem();
+
+  QPointF anchorPoint() const;
+  void setAnchorPoint(const QPointF& anchorPoint);
+
+  LeaderPosition leaderPosition() const;
+  void setLeaderPosition(LeaderPosition leaderPosition);
+
+  qreal leaderWidth() const;
+  void setLeaderWidth(qreal leaderWidth);
+
+  qreal leaderHeight() const;
+  void setLeaderHeight(qreal leaderHeight);
+
+  qreal cornerRadius() const;
+  void setCornerRadius(qreal cornerRadius);
+
+  qreal cornerOffset() const;
+  void setCornerOffset(qreal cornerOffset);
+
+  qreal borderWidth() const;
+  void setBorderWidth(qreal borderWidth);
+
+  QColor borderColor() const;
+  void setBorderColor(const QColor& borderColor);
+
+  QColor backgroundColor() const;
+  void setBackgroundColor(const QColor& backgroundColor);
+
+  QRectF contentRect() const;
+
+signals:
+  void anchorPointChanged();
+  void leaderPositionChanged();
+  void leaderWidthChanged();
+  void leaderHeightChanged();
+  void cornerRadiusChanged();
+  void cornerOffsetChanged();
+  void borderWidthChanged();
+  void borderColorChanged();
+  void backgroundColorChanged();
+  void contentRectChanged();
+
+protected:
+  QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData) override;
+  void geometryChanged(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+  void invalidateOutline();
+  void updatePosition();
+  QPointF leaderTip() const;
+  void buildOutline(QVector<QPointF>& outline, QVector<QPointF>& leader) const;
+  static void fillGeometry(QSGGeometry* geometry, const QVector<QPointF>& outline, const QVector<QPointF>& leader, const QPointF& center);
+  static void strokeGeometry(QSGGeometry* geometry, const QVector<QPointF>& outline, qreal width);
+
+  QPointF m_anchorPoint;
+  LeaderPosition m_leaderPosition = LeaderPositionBottom;
+  qreal m_leaderWidth = 20.0;
+  qreal m_leaderHeight = 10.0;
+  qreal m_cornerRadius = 5.0;
+  qreal m_cornerOffset = 15.0;
+  qreal m_borderWidth = 2.0;
+  QColor m_borderColor = QColor(Qt::black);
+  QColor m_backgroundColor = QColor(Qt::white);
+
+  QPointF m_leaderTip;
+  bool m_outlineDirty = true;
+  bool m_colorsDirty = true;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // CALLOUTITEM_H
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONBATCHRESULTS_H
+#define COORDINATECONVERSIONBATCHRESULTS_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QMetaType>
+#include <QStringList>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CoordinateConversionBatchResults
+{
+  Q_GADGET
+
+  Q_PROPERTY(int pointCount READ pointCount)
+  Q_PROPERTY(int formatCount READ formatCount)
+  Q_PROPERTY(QStringList formatNames READ formatNames)
+
+public:
+  CoordinateConversionBatchResults();
+  CoordinateConversionBatchResults(const QStringList& formatNames, int pointCount);
+  ~CoordinateConversionBatchResults();
+
+  int pointCount() const;
+  int formatCount() const;
+  QStringList formatNames() const;
+
+  Esri::ArcGISRuntime::Point point(int pointIndex) const;
+
+  Q_INVOKABLE QString notation(int pointIndex, int formatIndex) const;
+  Q_INVOKABLE QStringList notations(int pointIndex) const;
+
+private:
+  friend class CoordinateConversionController;
+
+  QStringList m_formatNames;
+  QVector<Esri::ArcGISRuntime::Point> m_points;
+  QVector<QString> m_notations; // one row of formatCount() notations per point
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+Q_DECLARE_METATYPE(Esri::ArcGISRuntime::Toolkit::CoordinateConversionBatchResults)
+
+#endif // COORDINATECONVERSIONBATCHRESULTS_H
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONCACHE_H
+#define COORDINATECONVERSIONCACHE_H
+
+// toolkit headers
+#include "CoordinateConversionParameters.h"
+
+// Qt headers
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+// STL headers
+#include <list>
+#include <utility>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \internal
+*/
+class CoordinateConversionCache
+{
+public:
+  explicit CoordinateConversionCache(int capacity);
+  ~CoordinateConversionCache() = default;
+
+  QString toNotation(const CoordinateConversionParameters& parameters, const Point& point);
+
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  int hits() const;
+  int misses() const;
+
+  void invalidate(quintptr optionId);
+  void clear();
+
+  struct Key
+  {
+    bool operator==(const Key& other) const;
+
+    double m_x = 0.0;
+    double m_y = 0.0;
+    int m_wkid = 0;
+    QString m_wkText; // only set when there is no wkid
+    quintptr m_optionId = 0;
+    int m_outputMode = 0;
+    int m_latLonFormat = 0;
+    int m_mgrsConversionMode = 0;
+    int m_utmConversionMode = 0;
+    int m_garsConversionMode = 0;
+    int m_precision = 0;
+    int m_decimalPlaces = 0;
+    bool m_addSpaces = false;
+  };
+
+private:
+  static Key makeKey(const CoordinateConversionParameters& parameters, const Point& point);
+  void trim();
+
+  using Entries = std::list<std::pair<Key, QString>>;
+
+  mutable QMutex m_mutex;
+  int m_capacity = 0;
+  int m_hits = 0;
+  int m_misses = 0;
+  Entries m_entries; // the most recently used entry is first
+  QHash<Key, Entries::iterator> m_index;
+};
+
+uint qHash(const CoordinateConversionCache::Key& key, uint seed = 0);
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONCACHE_H
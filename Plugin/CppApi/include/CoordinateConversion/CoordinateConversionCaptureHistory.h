@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONCAPTUREHISTORY_H
+#define COORDINATECONVERSIONCAPTUREHISTORY_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QAbstractListModel>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+
+class QIODevice;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class Point;
+
+namespace Toolkit
+{
+
+class Result;
+
+class TOOLKIT_EXPORT CoordinateConversionCaptureHistory : public QAbstractListModel
+{
+  Q_OBJECT
+
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  // the most captures kept, the oldest being dropped first
+  Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+
+public:
+  enum CaptureHistoryRoles
+  {
+    CaptureTimeRole = Qt::UserRole + 1,
+    XRole,
+    YRole,
+    WkidRole,
+    NotationsRole
+  };
+
+  explicit CoordinateConversionCaptureHistory(QObject* parent = nullptr);
+  ~CoordinateConversionCaptureHistory();
+
+  void append(const Esri::ArcGISRuntime::Point& point, const QList<Result>& results);
+
+  Q_INVOKABLE void clear();
+  Q_INVOKABLE QString notation(int index, const QString& formatName) const;
+  Q_INVOKABLE bool exportToFile(const QString& filePath) const;
+  bool exportTo(QIODevice* device) const;
+
+  int count() const;
+
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+signals:
+  void countChanged();
+  void capacityChanged();
+
+protected:
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  struct Notation
+  {
+    int formatIndex = -1; // into m_formatNames
+    QString notation;
+  };
+
+  struct Capture
+  {
+    qint64 captureTime = 0; // milliseconds since the epoch
+    double x = 0.0;
+    double y = 0.0;
+    int wkid = 0;
+    QVector<Notation> notations;
+  };
+
+  const Capture& captureAt(int row) const;
+  int internFormatName(const QString& formatName);
+
+  // a ring buffer of m_capacity slots, of which m_count from m_first are in use;
+  // m_capacity is declared first as it sizes the buffer in the constructor
+  int m_capacity = 500;
+  int m_first = 0;
+  int m_count = 0;
+  QVector<Capture> m_captures;
+
+  // every format name stored once, however many captures use it
+  QStringList m_formatNames;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONCAPTUREHISTORY_H
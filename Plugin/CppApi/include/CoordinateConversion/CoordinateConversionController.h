@@ -20,17 +20,28 @@
 
 // toolkit headers
 #include "AbstractTool.h"
+#include "CoordinateConversionBatchResults.h"
+#include "CoordinateConversionParameters.h"
 
 // C++ API headers
 #include "GeometryTypes.h"
 #include "Point.h"
+#include "Polyline.h"
 #include "SpatialReference.h"
 
 // Qt headers
 #include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QPointF>
+#include <QPointer>
+
+// STL headers
+#include <memory>
 
 class QMouseEvent;
+class QThreadPool;
+class QTimer;
 
 namespace Esri
 {
@@ -43,8 +54,13 @@ namespace ArcGISRuntime
 namespace Toolkit
 {
 
+class CoordinateConversionAsyncJob;
+class CoordinateConversionBatchJob;
+class CoordinateConversionCache;
+class CoordinateConversionCaptureHistory;
 class CoordinateConversionOptions;
 class CoordinateConversionResults;
+class Result;
 
 class TOOLKIT_EXPORT CoordinateConversionController : public AbstractTool
 {
@@ -53,6 +69,9 @@ class TOOLKIT_EXPORT CoordinateConversionController : public AbstractTool
   // bind to the results, which will have "name" and "notation" roles
   Q_PROPERTY(QAbstractListModel* results READ results NOTIFY resultsChanged)
 
+  // the points captured by clicks in capture mode, with their notations
+  Q_PROPERTY(QAbstractListModel* captureHistory READ captureHistory CONSTANT)
+
   // whether the controller should immediately convert on calling setPointToConvert or just
   // store the point for later
   Q_PROPERTY(bool runConversion READ runConversion WRITE setRunConversion NOTIFY runConversionChanged)
@@ -68,6 +87,26 @@ class TOOLKIT_EXPORT CoordinateConversionController : public AbstractTool
   // whether the tool is in "capture mode" (sets the target to a clicked point) or "live" mode (uses current location)
   Q_PROPERTY(bool captureMode READ isCaptureMode WRITE setCaptureMode NOTIFY captureModeChanged)
 
+  // whether the target follows the mouse cursor as it moves over the view
+  Q_PROPERTY(bool hoverMode READ isHoverMode WRITE setHoverMode NOTIFY hoverModeChanged)
+
+  // the minimum time in milliseconds between conversions in hover mode
+  Q_PROPERTY(int hoverInterval READ hoverInterval WRITE setHoverInterval NOTIFY hoverIntervalChanged)
+
+  // whether conversions of the point to convert run on a worker thread, with only the newest result published
+  Q_PROPERTY(bool asyncConversion READ isAsyncConversion WRITE setAsyncConversion NOTIFY asyncConversionChanged)
+
+  // the maximum number of times per second asynchronous results are published (0 for no limit)
+  Q_PROPERTY(double maximumPublishRate READ maximumPublishRate WRITE setMaximumPublishRate NOTIFY maximumPublishRateChanged)
+
+  // whether batch conversions format the simpler notations natively rather than through the CoordinateFormatter
+  Q_PROPERTY(bool nativeBatchConversion READ isNativeBatchConversion WRITE setNativeBatchConversion NOTIFY nativeBatchConversionChanged)
+
+  // the number of notations remembered for reuse by later conversions (0 to disable caching)
+  Q_PROPERTY(int cacheSize READ cacheSize WRITE setCacheSize NOTIFY cacheSizeChanged)
+  Q_PROPERTY(int cacheHits READ cacheHits NOTIFY cacheStatisticsChanged)
+  Q_PROPERTY(int cacheMisses READ cacheMisses NOTIFY cacheStatisticsChanged)
+
 public:
 
   // convert the following notation using the input options specified
@@ -96,6 +135,15 @@ public:
 
   Q_INVOKABLE void setGeoView(QObject* geoView);
 
+  // convert the following notations using the input options specified, on worker threads
+  Q_INVOKABLE int convertNotations(const QStringList& notations);
+
+  // stop a batch conversion which is still running
+  Q_INVOKABLE void cancelBatch(int batchId);
+
+  // empty the notation cache and reset its statistics
+  Q_INVOKABLE void clearCache();
+
 signals:
   void optionsChanged();
   void resultsChanged();
@@ -106,6 +154,15 @@ signals:
   void coordinateFormatsChanged();
   void inputFormatChanged();
   void captureModeChanged();
+  void hoverModeChanged();
+  void hoverIntervalChanged();
+  void asyncConversionChanged();
+  void maximumPublishRateChanged();
+  void nativeBatchConversionChanged();
+  void cacheSizeChanged();
+  void cacheStatisticsChanged();
+  void batchProgressChanged(int batchId, int convertedCount, int totalCount);
+  void batchCompleted(int batchId, const Esri::ArcGISRuntime::Toolkit::CoordinateConversionBatchResults& results);
 
 public:
   CoordinateConversionController(QObject* parent = nullptr);
@@ -114,6 +171,8 @@ public:
   void setSpatialReference(const Esri::ArcGISRuntime::SpatialReference& spatialReference);
   void setPointToConvert(const Esri::ArcGISRuntime::Point& point);
 
+  int convertPoints(const QList<Esri::ArcGISRuntime::Point>& points);
+
   bool runConversion() const;
   void setRunConversion(bool runConversion);
 
@@ -122,6 +181,8 @@ public:
 
   QAbstractListModel* results();
 
+  QAbstractListModel* captureHistory();
+
   QString toolName() const override;
 
   void setProperties(const QVariantMap& properties) override;
@@ -136,31 +197,121 @@ public:
   bool isCaptureMode() const;
   void setCaptureMode(bool captureMode);
 
+  bool isHoverMode() const;
+  void setHoverMode(bool hoverMode);
+
+  int hoverInterval() const;
+  void setHoverInterval(int hoverInterval);
+
+  bool isAsyncConversion() const;
+  void setAsyncConversion(bool asyncConversion);
+
+  double maximumPublishRate() const;
+  void setMaximumPublishRate(double maximumPublishRate);
+
+  bool isNativeBatchConversion() const;
+  void setNativeBatchConversion(bool nativeBatchConversion);
+
+  int cacheSize() const;
+  void setCacheSize(int cacheSize);
+
+  int cacheHits() const;
+  int cacheMisses() const;
+
 public slots:
   void onMouseClicked(QMouseEvent& mouseEvent);
+  void onMouseMoved(QMouseEvent& mouseEvent);
   void onLocationChanged(const Esri::ArcGISRuntime::Point& location);
 
+private slots:
+  void onBatchChunkCompleted(int batchId, int convertedCount);
+  void onAsyncConversionCompleted();
+  void onPublishTimeout();
+  void onHoverTimeout();
+
 private:
   CoordinateConversionResults* resultsInternal();
+  CoordinateConversionCaptureHistory* captureHistoryInternal();
   bool setGeoViewInternal(GeoView* geoView);
+  void connectResourceProvider();
+
+protected:
+  QList<QMetaObject::Connection> connectEventStreams(ToolResourceProvider* resourceProvider) override;
+  void initializeTool() override;
+
+private:
+  void connectViewChanges();
+  void invalidateViewBoundary();
+  bool updateViewBoundary(double screenWidth, double screenHeight, double padding) const;
   Esri::ArcGISRuntime::Point pointFromNotation(const QString& incomingNotation);
   QString convertPointInternal(CoordinateConversionOptions* option, const Esri::ArcGISRuntime::Point& point) const;
+  QList<Result> convertPointResults(const Esri::ArcGISRuntime::Point& point) const;
+  const CoordinateConversionParameters& optionParameters(CoordinateConversionOptions* option) const;
+  int startBatch(std::shared_ptr<CoordinateConversionBatchJob> job, int pointCount);
+  QThreadPool* threadPool();
+  void publishResults(QList<Result>&& results);
+  void requestAsyncConversion();
+  void startAsyncConversion();
+  void queueAsyncPublish(std::shared_ptr<CoordinateConversionAsyncJob> job);
+  void publishAsyncConversion(std::shared_ptr<CoordinateConversionAsyncJob> job);
 
   bool isInputFormat(CoordinateConversionOptions* option) const;
-  bool isFormat(CoordinateConversionOptions* option, const QString& formatName) const;
+  bool isFormat(CoordinateConversionOptions* option, int formatId, const QString& formatName) const;
+  void updateInputOption();
 
   Esri::ArcGISRuntime::Point m_pointToConvert;
   Esri::ArcGISRuntime::SpatialReference m_spatialReference;
   CoordinateConversionResults* m_results = nullptr;
+  CoordinateConversionCaptureHistory* m_captureHistory = nullptr;
 
   QList<CoordinateConversionOptions*> m_options;
   bool m_runConversion = true;
 
+  // copied from m_options when first needed, and dropped when the option changes
+  mutable QHash<const CoordinateConversionOptions*, CoordinateConversionParameters> m_optionParameters;
+  mutable int m_optionParametersRevision = 0; // of the format registry
+
   QStringList m_coordinateFormats;
   QString m_inputFormat;
+  mutable int m_inputFormatId = -1; // looked up again if a format is registered while the name is unknown
+  mutable int m_inputFormatRevision = -1; // of the format registry when m_inputFormatId was looked up
+  CoordinateConversionOptions* m_inputOption = nullptr;
   bool m_captureMode = false;
+  QList<Esri::ArcGISRuntime::Point> m_pendingCaptures; // clicks waiting for an asynchronous conversion
+  bool m_hoverMode = false;
+  int m_hoverInterval = 16;
+  QPointF m_hoverPosition;
+  QTimer* m_hoverTimer = nullptr;
   Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
   Esri::ArcGISRuntime::SceneQuickView* m_sceneView = nullptr;
+  QList<QMetaObject::Connection> m_viewConnections;
+  QList<QMetaObject::Connection> m_resourceConnections;
+  QPointer<QObject> m_pendingGeoView;
+
+  // the edges of the view and the projected target are cached between screenCoordinate calls
+  mutable bool m_viewBoundaryValid = false;
+  mutable Esri::ArcGISRuntime::Polyline m_viewBoundary;
+  mutable Esri::ArcGISRuntime::SpatialReference m_viewBoundarySpatialReference;
+  mutable Esri::ArcGISRuntime::Point m_projectedSource;
+  mutable Esri::ArcGISRuntime::Point m_projectedPoint;
+
+  QThreadPool* m_threadPool = nullptr;
+  QHash<int, std::shared_ptr<CoordinateConversionBatchJob>> m_batchJobs;
+  int m_nextBatchId = 1;
+  bool m_nativeBatchConversion = false;
+
+  bool m_asyncConversion = false;
+  double m_maximumPublishRate = 0.0;
+  std::shared_ptr<CoordinateConversionAsyncJob> m_asyncJob;
+  std::shared_ptr<CoordinateConversionAsyncJob> m_readyAsyncJob;
+  bool m_asyncConversionPending = false;
+  int m_supersededCount = 0;
+  QElapsedTimer m_lastPublish;
+  QTimer* m_publishTimer = nullptr;
+  QString m_publishedNotation;
+  bool m_publishedNotationValid = false;
+
+  std::shared_ptr<CoordinateConversionCache> m_cache;
 };
 
 } // Toolkit
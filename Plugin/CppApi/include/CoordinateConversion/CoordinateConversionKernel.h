@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONKERNEL_H
+#define COORDINATECONVERSIONKERNEL_H
+
+// toolkit headers
+#include "CoordinateConversionParameters.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QString>
+
+// STL headers
+#include <memory>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \internal
+*/
+class CoordinateConversionKernel
+{
+public:
+  static std::shared_ptr<const CoordinateConversionKernel> create(const CoordinateConversionParameters& parameters);
+
+  static bool accepts(const Point& point);
+
+  void format(const double* longitudes, const double* latitudes, int count, QString* notations) const;
+
+private:
+  enum class Kind
+  {
+    DecimalDegrees,
+    DegreesDecimalMinutes,
+    DegreesMinutesSeconds,
+    Utm
+  };
+
+  CoordinateConversionKernel(Kind kind, const CoordinateConversionParameters& parameters);
+
+  bool validate() const;
+
+  void formatLatitudeLongitude(const double* longitudes, const double* latitudes, int count, QString* notations) const;
+  void formatUtm(const double* longitudes, const double* latitudes, int count, QString* notations) const;
+
+  Kind m_kind = Kind::DecimalDegrees;
+  CoordinateConversionParameters m_parameters;
+  int m_decimalPlaces = 0;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONKERNEL_H
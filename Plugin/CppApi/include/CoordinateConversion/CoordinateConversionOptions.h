@@ -80,6 +80,8 @@ public:
   QString name() const;
   void setName(const QString& name);
 
+  int formatId() const;
+
   CoordinateType outputMode() const;
   void setOutputMode(CoordinateType outputMode);
 
@@ -106,6 +108,7 @@ public:
 
 private:
   QString m_name;
+  mutable int m_formatId = -1; // looked up again while the name is not a known format
   CoordinateType m_outputMode = CoordinateTypeUsng;
   bool m_addSpaces = true;
   int m_precision = 8;
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONPARAMETERS_H
+#define COORDINATECONVERSIONPARAMETERS_H
+
+// toolkit headers
+#include "CoordinateConversionOptions.h"
+#include "CoordinateFormatRegistry.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QString>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \internal
+*/
+class TOOLKIT_EXPORT CoordinateConversionParameters
+{
+public:
+  CoordinateConversionParameters() = default;
+  explicit CoordinateConversionParameters(const CoordinateConversionOptions* option);
+  ~CoordinateConversionParameters() = default;
+
+  QString toNotation(const Point& point) const;
+  Point fromNotation(const QString& notation, const SpatialReference& spatialReference) const;
+
+  quintptr m_optionId = 0; // identifies the options object these parameters were copied from
+  QString m_name;
+  CoordinateConversionOptions::CoordinateType m_outputMode = CoordinateConversionOptions::CoordinateTypeUsng;
+  bool m_addSpaces = true;
+  int m_precision = 8;
+  int m_decimalPlaces = 6;
+  MgrsConversionMode m_mgrsConversionMode = MgrsConversionMode::Automatic;
+  LatitudeLongitudeFormat m_latLonFormat = LatitudeLongitudeFormat::DecimalDegrees;
+  UtmConversionMode m_utmConversionMode = UtmConversionMode::LatitudeBandIndicators;
+  GarsConversionMode m_garsConversionMode = GarsConversionMode::Center;
+
+  // set for formats registered by the application
+  int m_formatId = CoordinateFormatRegistry::InvalidFormatId;
+  bool m_customFormat = false;
+  CoordinateFormatRegistry::Formatter m_formatter;
+  CoordinateFormatRegistry::Parser m_parser;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONPARAMETERS_H
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONPIPELINE_H
+#define COORDINATECONVERSIONPIPELINE_H
+
+// toolkit headers
+#include "CoordinateConversionParameters.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QList>
+#include <QString>
+
+class QIODevice;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CoordinateConversionPipeline
+{
+public:
+  CoordinateConversionPipeline();
+  ~CoordinateConversionPipeline();
+
+  bool setInputFormat(const QString& formatName);
+  bool addOutputFormat(const QString& formatName);
+
+  Esri::ArcGISRuntime::SpatialReference spatialReference() const;
+  void setSpatialReference(const Esri::ArcGISRuntime::SpatialReference& spatialReference);
+
+  int column() const;
+  void setColumn(int column);
+
+  QChar delimiter() const;
+  void setDelimiter(QChar delimiter);
+
+  bool hasHeader() const;
+  void setHasHeader(bool hasHeader);
+
+  int chunkSize() const;
+  void setChunkSize(int chunkSize);
+
+  int maximumChunksInFlight() const;
+  void setMaximumChunksInFlight(int maximumChunksInFlight);
+
+  bool run(QIODevice* input, QIODevice* output);
+
+  qint64 convertedCount() const;
+  qint64 failedCount() const;
+  QString errorString() const;
+
+private:
+  class Chunk;
+  class LineReader;
+
+  void convertChunk(Chunk* chunk) const;
+  QByteArray outputHeader(const QByteArray& header) const;
+
+  CoordinateConversionParameters m_inputParameters;
+  QList<CoordinateConversionParameters> m_outputParameters;
+  bool m_hasInputFormat = false;
+  Esri::ArcGISRuntime::SpatialReference m_spatialReference;
+  int m_column = 0;
+  QChar m_delimiter = QLatin1Char(',');
+  bool m_hasHeader = false;
+  int m_chunkSize = 4096;
+  int m_maximumChunksInFlight = 0;
+  qint64 m_convertedCount = 0;
+  qint64 m_failedCount = 0;
+  QString m_errorString;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONPIPELINE_H
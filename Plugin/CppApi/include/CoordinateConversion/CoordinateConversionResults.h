@@ -76,6 +76,7 @@ private:
   void setResults(QList<Result>&& results);
   void removeResult(const QString& name);
   void clearResults();
+  void emitDataChanged(int firstRow, int lastRow);
   void setupRoles();
 
   QHash<int, QByteArray> m_roles;
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONRUNNABLE_H
+#define COORDINATECONVERSIONRUNNABLE_H
+
+// Qt headers
+#include <QRunnable>
+
+// STL headers
+#include <functional>
+#include <utility>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \internal
+
+  Runs a function on a QThreadPool, which deletes the runnable once it has
+  run. Used for the conversions of the controller and the pipeline.
+*/
+class CoordinateConversionRunnable : public QRunnable
+{
+public:
+  explicit CoordinateConversionRunnable(std::function<void()> function) :
+    m_function(std::move(function))
+  {
+  }
+
+  void run() override
+  {
+    m_function();
+  }
+
+private:
+  std::function<void()> m_function;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONRUNNABLE_H
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONTRACKINGMODEL_H
+#define COORDINATECONVERSIONTRACKINGMODEL_H
+
+// toolkit headers
+#include "CoordinateConversionParameters.h"
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
+
+// STL headers
+#include <vector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class CoordinateConversionOptions;
+
+class TOOLKIT_EXPORT CoordinateConversionTrackingModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  // the names of the formats, one per column
+  Q_PROPERTY(QStringList coordinateFormats READ coordinateFormats NOTIFY coordinateFormatsChanged)
+
+  // the number of tracked points, one per row
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  // the number of rows converted by the last update
+  Q_PROPERTY(int lastUpdateConversions READ lastUpdateConversions NOTIFY updated)
+
+public:
+  enum TrackingModelRoles
+  {
+    KeyRole = Qt::UserRole + 1,
+    XRole,
+    YRole,
+    NotationsRole
+  };
+
+  explicit CoordinateConversionTrackingModel(QObject* parent = nullptr);
+  ~CoordinateConversionTrackingModel();
+
+  void addOption(CoordinateConversionOptions* option);
+  Q_INVOKABLE void addCoordinateFormat(const QString& formatName);
+  Q_INVOKABLE void clearOptions();
+
+  QStringList coordinateFormats() const;
+
+  void updatePoints(const QHash<QString, Esri::ArcGISRuntime::Point>& points);
+  Q_INVOKABLE void updateFromGraphicsOverlay(QObject* graphicsOverlay, const QString& keyAttribute = QString());
+  void setPoint(const QString& key, const Esri::ArcGISRuntime::Point& point);
+  Q_INVOKABLE void removePoint(const QString& key);
+  Q_INVOKABLE void clear();
+
+  Q_INVOKABLE int rowOf(const QString& key) const;
+  Q_INVOKABLE QString notation(const QString& key, const QString& formatName) const;
+
+  int count() const;
+  int lastUpdateConversions() const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+signals:
+  void coordinateFormatsChanged();
+  void countChanged();
+  void updated(int conversions);
+
+protected:
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  struct TrackedRow
+  {
+    QString key;
+    Esri::ArcGISRuntime::Point point;
+    QVector<QString> notations; // one per column
+  };
+
+  using TrackedPoints = QVector<QPair<QString, Esri::ArcGISRuntime::Point>>;
+
+  void updatePointsInternal(const TrackedPoints& points);
+  void removeMarkedRows(const std::vector<bool>& marked);
+  void rebuildKeyIndex();
+  void convertRow(TrackedRow& row) const;
+  void emitRowsChanged(QVector<int>& rows);
+  void refreshOption(CoordinateConversionOptions* option);
+  void removeOption(CoordinateConversionOptions* option);
+
+  QList<CoordinateConversionOptions*> m_options;
+  QList<CoordinateConversionParameters> m_parameters; // copied from m_options, in column order
+
+  QVector<TrackedRow> m_rows;
+  QHash<QString, int> m_rowByKey;
+  int m_lastUpdateConversions = 0;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONTRACKINGMODEL_H
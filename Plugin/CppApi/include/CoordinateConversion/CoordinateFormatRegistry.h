@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATEFORMATREGISTRY_H
+#define COORDINATEFORMATREGISTRY_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QAtomicInt>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QStringList>
+#include <QVector>
+
+// STL headers
+#include <functional>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class CoordinateConversionOptions;
+
+class TOOLKIT_EXPORT CoordinateFormatRegistry
+{
+public:
+  using Formatter = std::function<QString(const Esri::ArcGISRuntime::Point& point)>;
+  using Parser = std::function<Esri::ArcGISRuntime::Point(const QString& notation,
+                                                          const Esri::ArcGISRuntime::SpatialReference& spatialReference)>;
+
+  static constexpr int InvalidFormatId = -1;
+
+  static CoordinateFormatRegistry& instance(); // singleton
+
+  ~CoordinateFormatRegistry();
+
+  int formatId(const QString& formatName) const;
+  QString formatName(int formatId) const;
+
+  bool isRegistered(int formatId) const;
+  QStringList formatNames() const;
+
+  int registerFormat(const QString& formatName, Formatter formatter, Parser parser);
+  int revision() const;
+
+  Formatter formatter(int formatId) const;
+  Parser parser(int formatId) const;
+
+  void configure(int formatId, CoordinateConversionOptions* option) const;
+
+private:
+  using Configure = std::function<void(CoordinateConversionOptions* option)>;
+
+  struct Entry
+  {
+    QString m_name;
+    bool m_registered = false;
+    Configure m_configure;
+    Formatter m_formatter;
+    Parser m_parser;
+  };
+
+  CoordinateFormatRegistry();
+
+  void registerBuiltInFormat(const QString& formatName, Configure configure);
+  int formatIdInternal(const QString& formatName);
+
+  mutable QReadWriteLock m_lock;
+  QHash<QString, int> m_ids; // keyed by the case folded name
+  QVector<Entry> m_entries;  // indexed by format id
+  QAtomicInt m_revision;     // counts the registrations
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATEFORMATREGISTRY_H
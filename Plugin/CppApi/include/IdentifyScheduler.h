@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef IDENTIFYSCHEDULER_H
+#define IDENTIFYSCHEDULER_H
+
+// toolkit headers
+#include "TaskScheduler.h"
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QPointF>
+#include <QUuid>
+
+class QTimer;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class IdentifyGraphicsOverlayResult;
+class IdentifyLayerResult;
+
+namespace Toolkit
+{
+
+class ToolResourceProvider;
+
+class TOOLKIT_EXPORT IdentifyScheduler : public QObject
+{
+  Q_OBJECT
+
+  Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+  Q_PROPERTY(int maximumConcurrentTasks READ maximumConcurrentTasks WRITE setMaximumConcurrentTasks NOTIFY maximumConcurrentTasksChanged)
+  Q_PROPERTY(int coalesceInterval READ coalesceInterval WRITE setCoalesceInterval NOTIFY coalesceIntervalChanged)
+  Q_PROPERTY(double tolerance READ tolerance WRITE setTolerance NOTIFY toleranceChanged)
+  Q_PROPERTY(bool returnPopupsOnly READ returnPopupsOnly WRITE setReturnPopupsOnly NOTIFY returnPopupsOnlyChanged)
+  Q_PROPERTY(int maximumResults READ maximumResults WRITE setMaximumResults NOTIFY maximumResultsChanged)
+
+public:
+  explicit IdentifyScheduler(ToolResourceProvider* resourceProvider = nullptr, QObject* parent = nullptr);
+  ~IdentifyScheduler();
+
+  ToolResourceProvider* resourceProvider() const;
+  void setResourceProvider(ToolResourceProvider* resourceProvider);
+
+  Q_INVOKABLE void identifyLayers(const QPointF& screenPoint);
+  Q_INVOKABLE void identifyGraphicsOverlays(const QPointF& screenPoint);
+  Q_INVOKABLE void cancel();
+
+  bool isBusy() const;
+
+  int maximumConcurrentTasks() const;
+  void setMaximumConcurrentTasks(int maximumConcurrentTasks);
+
+  int coalesceInterval() const;
+  void setCoalesceInterval(int coalesceInterval);
+
+  double tolerance() const;
+  void setTolerance(double tolerance);
+
+  bool returnPopupsOnly() const;
+  void setReturnPopupsOnly(bool returnPopupsOnly);
+
+  int maximumResults() const;
+  void setMaximumResults(int maximumResults);
+
+signals:
+  void identifyLayersCompleted(const QPointF& screenPoint, QList<Esri::ArcGISRuntime::IdentifyLayerResult*> identifyResults);
+  void identifyGraphicsOverlaysCompleted(const QPointF& screenPoint, QList<Esri::ArcGISRuntime::IdentifyGraphicsOverlayResult*> identifyResults);
+  void busyChanged();
+  void maximumConcurrentTasksChanged();
+  void coalesceIntervalChanged();
+  void toleranceChanged();
+  void returnPopupsOnlyChanged();
+  void maximumResultsChanged();
+
+private:
+  enum RequestKind
+  {
+    LayersRequest = 0,
+    GraphicsOverlaysRequest = 1,
+    RequestKindCount = 2
+  };
+
+  // each task keeps the screen point it identifies
+  using Scheduler = TaskScheduler<QPointF>;
+
+  void request(RequestKind kind, const QPointF& screenPoint);
+  void startPendingRequests();
+  void connectGeoView();
+  void onErrorOccurred();
+  void onIdentifyLayersCompleted(QUuid taskId, QList<Esri::ArcGISRuntime::IdentifyLayerResult*> identifyResults);
+  void onIdentifyGraphicsOverlaysCompleted(QUuid taskId, QList<Esri::ArcGISRuntime::IdentifyGraphicsOverlayResult*> identifyResults);
+  void updateBusy();
+
+  QPointer<ToolResourceProvider> m_resourceProvider;
+  QList<QMetaObject::Connection> m_providerConnections;
+  QList<QMetaObject::Connection> m_viewConnections;
+  QTimer* m_coalesceTimer = nullptr;
+  QPointF m_screenPoints[RequestKindCount]; // of the waiting requests
+  Scheduler m_scheduler;
+  double m_tolerance = 12.0;
+  bool m_returnPopupsOnly = false;
+  int m_maximumResults = 1;
+  bool m_busy = false;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // IDENTIFYSCHEDULER_H
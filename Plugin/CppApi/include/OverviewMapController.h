@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef OVERVIEWMAPCONTROLLER_H
+#define OVERVIEWMAPCONTROLLER_H
+
+// toolkit headers
+#include "AbstractTool.h"
+
+// C++ API headers
+#include "Envelope.h"
+
+// Qt headers
+#include <QColor>
+#include <QList>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class Graphic;
+class GraphicsOverlay;
+class MapQuickView;
+class SimpleFillSymbol;
+
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT OverviewMapController : public AbstractTool
+{
+  Q_OBJECT
+
+  // how many times larger the scale of the overview is than the scale of the main view
+  Q_PROPERTY(double zoomRatio READ zoomRatio WRITE setZoomRatio NOTIFY zoomRatioChanged)
+
+  // the smallest movement of the visible area, in device independent pixels of the overview, which is drawn
+  Q_PROPERTY(double pixelThreshold READ pixelThreshold WRITE setPixelThreshold NOTIFY pixelThresholdChanged)
+
+  // the color used to shade the area outside the visible area
+  Q_PROPERTY(QColor fillColor READ fillColor WRITE setFillColor NOTIFY fillColorChanged)
+
+signals:
+  void zoomRatioChanged();
+  void pixelThresholdChanged();
+  void fillColorChanged();
+
+public:
+  OverviewMapController(QObject* parent = nullptr);
+  ~OverviewMapController();
+
+  Q_INVOKABLE void setGeoView(QObject* geoView);
+  Q_INVOKABLE void setOverviewView(QObject* overviewView);
+
+  // zooms the overview to the initial viewpoint of the main map
+  Q_INVOKABLE void zoomAll();
+
+  // redraws the area of interest even if the visible area has not moved
+  Q_INVOKABLE void update();
+
+  double zoomRatio() const;
+  void setZoomRatio(double zoomRatio);
+
+  double pixelThreshold() const;
+  void setPixelThreshold(double pixelThreshold);
+
+  QColor fillColor() const;
+  void setFillColor(const QColor& fillColor);
+
+  QString toolName() const override;
+
+private:
+  void connectMaps();
+  void removeOverlayFromOverview();
+  void updateAreaOfInterest(bool force);
+  bool movedEnough(const Esri::ArcGISRuntime::Envelope& extent) const;
+
+  Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
+  Esri::ArcGISRuntime::MapQuickView* m_overviewView = nullptr;
+  Esri::ArcGISRuntime::GraphicsOverlay* m_aoiOverlay = nullptr;
+  Esri::ArcGISRuntime::Graphic* m_aoiGraphic = nullptr;
+  Esri::ArcGISRuntime::SimpleFillSymbol* m_fillSymbol = nullptr;
+  QList<QMetaObject::Connection> m_viewConnections;
+  QList<QMetaObject::Connection> m_mapConnections;
+  QMetaObject::Connection m_overviewConnection;
+
+  // the visible area last drawn, in the spatial reference of the overview
+  Esri::ArcGISRuntime::Envelope m_drawnExtent;
+
+  double m_zoomRatio = 10.0;
+  double m_pixelThreshold = 1.0;
+  QColor m_fillColor = QColor(0, 0, 0, 0x60);
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // OVERVIEWMAPCONTROLLER_H
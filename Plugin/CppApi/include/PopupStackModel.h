@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef POPUPSTACKMODEL_H
+#define POPUPSTACKMODEL_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class IdentifyLayerResult;
+class Popup;
+class PopupManager;
+
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT PopupStackModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+  // the number of rows fetched so far
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  // the number of popups in the stack, including those not fetched yet
+  Q_PROPERTY(int totalCount READ totalCount NOTIFY totalCountChanged)
+
+  Q_PROPERTY(int currentIndex READ currentIndex WRITE setCurrentIndex NOTIFY currentIndexChanged)
+  Q_PROPERTY(QObject* currentPopupManager READ currentPopupManager NOTIFY currentPopupManagerChanged)
+
+  // the number of popups after the current one whose PopupManagers are created ahead of time
+  Q_PROPERTY(int lookAhead READ lookAhead WRITE setLookAhead NOTIFY lookAheadChanged)
+
+  // the most PopupManagers which are kept, including the current one and the look-ahead
+  Q_PROPERTY(int maximumLoadedPages READ maximumLoadedPages WRITE setMaximumLoadedPages NOTIFY maximumLoadedPagesChanged)
+
+  // the number of rows added by each fetchMore
+  Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+
+public:
+  enum PopupStackRoles
+  {
+    PopupRole = Qt::UserRole + 1,
+    PopupManagerRole,
+    TitleRole,
+    LoadedRole
+  };
+
+  explicit PopupStackModel(QObject* parent = nullptr);
+  ~PopupStackModel();
+
+  void setPopups(const QList<Esri::ArcGISRuntime::Popup*>& popups);
+  void appendPopups(const QList<Esri::ArcGISRuntime::Popup*>& popups);
+  void appendIdentifyResults(const QList<Esri::ArcGISRuntime::IdentifyLayerResult*>& identifyResults);
+
+  Q_INVOKABLE void clear();
+  Q_INVOKABLE QObject* popup(int index) const;
+  Q_INVOKABLE QObject* popupManager(int index);
+  Q_INVOKABLE void releaseOffscreenPages();
+
+  int count() const;
+  int totalCount() const;
+
+  int currentIndex() const;
+  void setCurrentIndex(int currentIndex);
+
+  QObject* currentPopupManager() const;
+
+  int lookAhead() const;
+  void setLookAhead(int lookAhead);
+
+  int maximumLoadedPages() const;
+  void setMaximumLoadedPages(int maximumLoadedPages);
+
+  int pageSize() const;
+  void setPageSize(int pageSize);
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  bool canFetchMore(const QModelIndex& parent) const override;
+  void fetchMore(const QModelIndex& parent) override;
+
+signals:
+  void countChanged();
+  void totalCountChanged();
+  void currentIndexChanged();
+  void currentPopupManagerChanged();
+  void lookAheadChanged();
+  void maximumLoadedPagesChanged();
+  void pageSizeChanged();
+
+protected:
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  bool isInWindow(int index) const;
+  void fetchTo(int index);
+  void loadWindow();
+  void updateCurrentPopupManager();
+  void releasePages(bool offscreenOnly);
+  void releasePage(int index);
+  void touchPage(int index);
+  void collectPopups(Esri::ArcGISRuntime::IdentifyLayerResult* identifyResult, QList<Esri::ArcGISRuntime::Popup*>& popups) const;
+
+  QList<Esri::ArcGISRuntime::Popup*> m_popups;
+  QHash<int, Esri::ArcGISRuntime::PopupManager*> m_managers;
+  Esri::ArcGISRuntime::PopupManager* m_currentPopupManager = nullptr; // of m_managers, at m_currentIndex
+  QList<int> m_recentPages; // least recently used first
+  int m_fetchedCount = 0;
+  int m_currentIndex = 0;
+  int m_lookAhead = 1;
+  int m_maximumLoadedPages = 3;
+  int m_pageSize = 20;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // POPUPSTACKMODEL_H
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef SEARCHCONTROLLER_H
+#define SEARCHCONTROLLER_H
+
+// toolkit headers
+#include "AbstractTool.h"
+#include "TaskScheduler.h"
+
+// C++ API headers
+#include "GeocodeResult.h"
+#include "SuggestResult.h"
+
+// Qt headers
+#include <QCache>
+#include <QList>
+#include <QStringList>
+#include <QUrl>
+#include <QUuid>
+#include <QVariantList>
+
+class QTimer;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class LocatorTask;
+class MapQuickView;
+
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT SearchController : public AbstractTool
+{
+  Q_OBJECT
+
+  Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
+  Q_PROPERTY(QUrl locatorUrl READ locatorUrl WRITE setLocatorUrl NOTIFY locatorUrlChanged)
+  Q_PROPERTY(QStringList suggestions READ suggestions NOTIFY suggestionsChanged)
+  Q_PROPERTY(QVariantList geocodeResults READ geocodeResults NOTIFY geocodeResultsChanged)
+  Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+  Q_PROPERTY(int debounceInterval READ debounceInterval WRITE setDebounceInterval NOTIFY debounceIntervalChanged)
+  Q_PROPERTY(int minimumSearchLength READ minimumSearchLength WRITE setMinimumSearchLength NOTIFY minimumSearchLengthChanged)
+  Q_PROPERTY(int maximumConcurrentTasks READ maximumConcurrentTasks WRITE setMaximumConcurrentTasks NOTIFY maximumConcurrentTasksChanged)
+  Q_PROPERTY(int maximumResults READ maximumResults WRITE setMaximumResults NOTIFY maximumResultsChanged)
+  Q_PROPERTY(int cacheSize READ cacheSize WRITE setCacheSize NOTIFY cacheSizeChanged)
+
+public:
+  explicit SearchController(QObject* parent = nullptr);
+  ~SearchController();
+
+  Q_INVOKABLE void setGeoView(QObject* geoView);
+
+  // geocodes the search text, or the suggestion at suggestionIndex
+  Q_INVOKABLE void geocode();
+  Q_INVOKABLE void geocodeSuggestion(int suggestionIndex);
+
+  Q_INVOKABLE void cancel();
+  Q_INVOKABLE void clearCache();
+
+  Esri::ArcGISRuntime::LocatorTask* locatorTask() const;
+  void setLocatorTask(Esri::ArcGISRuntime::LocatorTask* locatorTask);
+
+  QString searchText() const;
+  void setSearchText(const QString& searchText);
+
+  QUrl locatorUrl() const;
+  void setLocatorUrl(const QUrl& locatorUrl);
+
+  QStringList suggestions() const;
+  QList<Esri::ArcGISRuntime::SuggestResult> suggestResults() const;
+
+  QVariantList geocodeResults() const;
+  QList<Esri::ArcGISRuntime::GeocodeResult> geocodeResultList() const;
+
+  bool isBusy() const;
+
+  int debounceInterval() const;
+  void setDebounceInterval(int debounceInterval);
+
+  int minimumSearchLength() const;
+  void setMinimumSearchLength(int minimumSearchLength);
+
+  int maximumConcurrentTasks() const;
+  void setMaximumConcurrentTasks(int maximumConcurrentTasks);
+
+  int maximumResults() const;
+  void setMaximumResults(int maximumResults);
+
+  int cacheSize() const;
+  void setCacheSize(int cacheSize);
+
+  QString toolName() const override;
+
+signals:
+  void searchTextChanged();
+  void locatorUrlChanged();
+  void suggestionsChanged();
+  void geocodeResultsChanged();
+  void geocodeCompleted(const QList<Esri::ArcGISRuntime::GeocodeResult>& geocodeResults);
+  void busyChanged();
+  void debounceIntervalChanged();
+  void minimumSearchLengthChanged();
+  void maximumConcurrentTasksChanged();
+  void maximumResultsChanged();
+  void cacheSizeChanged();
+
+private:
+  enum RequestKind
+  {
+    SuggestRequest = 0,
+    GeocodeRequest = 1,
+    RequestKindCount = 2
+  };
+
+  struct Request
+  {
+    QString text;
+    QString cacheKey;
+    Esri::ArcGISRuntime::SuggestResult suggestResult;
+    bool fromSuggestion = false;
+  };
+
+  // each task keeps the cache key its results are stored under
+  using Scheduler = TaskScheduler<QString>;
+
+  void connectLocatorTask();
+  void requestSuggestions();
+  void request(RequestKind kind, const QString& text, const QString& cacheKey);
+  void startPendingRequests();
+  void onSuggestCompleted(QUuid taskId, const QList<Esri::ArcGISRuntime::SuggestResult>& suggestResults);
+  void onGeocodeCompleted(QUuid taskId, const QList<Esri::ArcGISRuntime::GeocodeResult>& geocodeResults);
+  void onErrorOccurred();
+  void setSuggestResults(const QList<Esri::ArcGISRuntime::SuggestResult>& suggestResults);
+  void setGeocodeResults(const QList<Esri::ArcGISRuntime::GeocodeResult>& geocodeResults);
+  QString cacheKey(const QString& prefix, const QString& text) const;
+  void updateBusy();
+
+  Esri::ArcGISRuntime::LocatorTask* m_locatorTask = nullptr;
+  Esri::ArcGISRuntime::LocatorTask* m_ownedLocatorTask = nullptr;
+  Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
+  QList<QMetaObject::Connection> m_locatorConnections;
+  QMetaObject::Connection m_viewConnection;
+  QTimer* m_debounceTimer = nullptr;
+  Request m_requests[RequestKindCount]; // the waiting requests
+  Scheduler m_scheduler;
+
+  QCache<QString, QList<Esri::ArcGISRuntime::SuggestResult>> m_suggestCache;
+  QCache<QString, QList<Esri::ArcGISRuntime::GeocodeResult>> m_geocodeCache;
+
+  QString m_searchText;
+  QUrl m_locatorUrl;
+  QList<Esri::ArcGISRuntime::SuggestResult> m_suggestResults;
+  QList<Esri::ArcGISRuntime::GeocodeResult> m_geocodeResults;
+  int m_minimumSearchLength = 3;
+  int m_maximumResults = 6;
+  bool m_busy = false;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // SEARCHCONTROLLER_H
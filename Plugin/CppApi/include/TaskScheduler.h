@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+// C++ API headers
+#include "TaskWatcher.h"
+
+// Qt headers
+#include <QHash>
+#include <QUuid>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \internal
+
+  The bookkeeping of a tool which sends requests of a few kinds as tasks.
+
+  Each kind has at most one waiting request, and a newer request replaces
+  it. Starting a request cancels the running tasks of the same kind, no
+  more than maximumConcurrentTasks tasks run at once, and a finished task
+  is only the newest of its kind if no request of that kind has been made
+  since it started. \c TaskData is kept with each task, for use when it
+  finishes.
+*/
+template <typename TaskData>
+class TaskScheduler
+{
+public:
+  struct Task
+  {
+    int kind = 0;
+    quint64 serial = 0;
+    TaskData data;
+    Esri::ArcGISRuntime::TaskWatcher taskWatcher;
+  };
+
+  explicit TaskScheduler(int kindCount) :
+    m_requests(kindCount)
+  {
+  }
+
+  // replaces any waiting request of kind
+  void request(int kind)
+  {
+    Request& request = m_requests[kind];
+    request.serial = m_nextSerial++;
+    request.pending = true;
+  }
+
+  // drops the waiting request of kind and cancels its running tasks
+  void supersede(int kind)
+  {
+    Request& request = m_requests[kind];
+    request.pending = false;
+    // results of tasks still on their way are stale from now on
+    request.serial = m_nextSerial++;
+    cancelTasks(kind);
+  }
+
+  void cancel()
+  {
+    for (int kind = 0; kind < m_requests.size(); ++kind)
+      supersede(kind);
+  }
+
+  bool isPending(int kind) const
+  {
+    return m_requests.at(kind).pending;
+  }
+
+  bool isBusy() const
+  {
+    if (!m_tasks.isEmpty())
+      return true;
+
+    for (const Request& request : m_requests)
+    {
+      if (request.pending)
+        return true;
+    }
+
+    return false;
+  }
+
+  int maximumConcurrentTasks() const
+  {
+    return m_maximumConcurrentTasks;
+  }
+
+  void setMaximumConcurrentTasks(int maximumConcurrentTasks)
+  {
+    m_maximumConcurrentTasks = qMax(1, maximumConcurrentTasks);
+  }
+
+  // starts the waiting requests for which there is room; startTask(kind, data)
+  // fills in the data of the task and returns its watcher, which is invalid
+  // if the request could not be sent
+  template <typename StartTask>
+  void startPendingRequests(StartTask startTask)
+  {
+    for (int kind = 0; kind < m_requests.size(); ++kind)
+    {
+      Request& request = m_requests[kind];
+      if (!request.pending)
+        continue;
+
+      // the new request makes the running ones of the same kind obsolete
+      cancelTasks(kind);
+
+      if (m_tasks.size() >= m_maximumConcurrentTasks)
+        continue;
+
+      Task task;
+      task.kind = kind;
+      task.serial = request.serial;
+      task.taskWatcher = startTask(kind, task.data);
+
+      request.pending = false;
+      if (task.taskWatcher.isValid())
+        m_tasks.insert(task.taskWatcher.taskId(), task);
+    }
+  }
+
+  // removes the task taskId, and returns true if it was started here
+  bool takeTask(const QUuid& taskId, Task& task)
+  {
+    auto it = m_tasks.find(taskId);
+    if (it == m_tasks.end())
+      return false;
+
+    task = it.value();
+    m_tasks.erase(it);
+    return true;
+  }
+
+  // whether no request of the kind of task has been made since it started
+  bool isNewest(const Task& task) const
+  {
+    return task.serial == m_requests.at(task.kind).serial;
+  }
+
+  // frees the slots of the tasks which have finished without completing
+  void removeFinishedTasks()
+  {
+    for (auto it = m_tasks.begin(); it != m_tasks.end();)
+    {
+      if (it->taskWatcher.isDone())
+        it = m_tasks.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  // forgets the running tasks without cancelling them, once whatever ran them has gone
+  void clearTasks()
+  {
+    m_tasks.clear();
+  }
+
+private:
+  struct Request
+  {
+    quint64 serial = 0;
+    bool pending = false;
+  };
+
+  void cancelTasks(int kind)
+  {
+    for (auto it = m_tasks.begin(); it != m_tasks.end();)
+    {
+      if (it->kind == kind)
+      {
+        it->taskWatcher.cancel();
+        it = m_tasks.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  QVector<Request> m_requests; // indexed by kind
+  QHash<QUuid, Task> m_tasks;
+  quint64 m_nextSerial = 1;
+  int m_maximumConcurrentTasks = 2;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TASKSCHEDULER_H
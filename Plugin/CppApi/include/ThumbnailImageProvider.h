@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef THUMBNAILIMAGEPROVIDER_H
+#define THUMBNAILIMAGEPROVIDER_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QQuickAsyncImageProvider>
+#include <QThreadPool>
+
+// STL headers
+#include <memory>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class ThumbnailCache;
+
+class TOOLKIT_EXPORT ThumbnailImageProvider : public QQuickAsyncImageProvider
+{
+public:
+  explicit ThumbnailImageProvider(int memoryCacheSize = 32 * 1024 * 1024, const QString& diskCachePath = QString());
+  ~ThumbnailImageProvider();
+
+  static QString providerId();
+
+  QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
+
+  int memoryCacheSize() const;
+  void setMemoryCacheSize(int memoryCacheSize);
+
+  QString diskCachePath() const;
+  void setDiskCachePath(const QString& diskCachePath);
+
+  int defaultThumbnailSize() const;
+  void setDefaultThumbnailSize(int defaultThumbnailSize);
+
+  void clearCache();
+
+private:
+  Q_DISABLE_COPY(ThumbnailImageProvider)
+
+  std::shared_ptr<ThumbnailCache> m_cache;
+  QThreadPool m_threadPool;
+  int m_defaultThumbnailSize = 256;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // THUMBNAILIMAGEPROVIDER_H
@@ -19,19 +19,29 @@
 
 // toolkit headers
 #include "AbstractTool.h"
+#include "TimeSliderLayerTimes.h"
+#include "TimeSliderSteps.h"
 
 // C++ API headers
 #include "TimeExtent.h"
+#include "TimeValue.h"
 
 // Qt headers
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QVariantList>
 
+class QTimer;
+
 namespace Esri
 {
 namespace ArcGISRuntime
 {
 
+class FeatureTable;
 class GeoView;
+class Layer;
 class LayerListModel;
 class MapQuickView;
 class SceneQuickView;
@@ -39,6 +49,9 @@ class SceneQuickView;
 namespace Toolkit
 {
 
+class TimeSliderDensityIndex;
+class TimeSliderStepsModel;
+
 class TOOLKIT_EXPORT TimeSliderController : public AbstractTool
 {
   Q_OBJECT
@@ -51,7 +64,18 @@ class TOOLKIT_EXPORT TimeSliderController : public AbstractTool
   Q_PROPERTY(int startStep READ startStep NOTIFY startStepChanged)
   Q_PROPERTY(int endStep READ endStep NOTIFY endStepChanged)
   Q_PROPERTY(QVariantList stepTimes READ stepTimes NOTIFY stepTimesChanged)
+  Q_PROPERTY(QAbstractListModel* steps READ steps CONSTANT)
   Q_PROPERTY(QObject* geoView READ geoView WRITE setGeoView NOTIFY geoViewChanged)
+  Q_PROPERTY(bool playing READ isPlaying WRITE setPlaying NOTIFY playingChanged)
+  Q_PROPERTY(bool playbackLoop READ playbackLoop WRITE setPlaybackLoop NOTIFY playbackLoopChanged)
+  Q_PROPERTY(bool playbackReverse READ playbackReverse WRITE setPlaybackReverse NOTIFY playbackReverseChanged)
+  Q_PROPERTY(int playbackInterval READ playbackInterval WRITE setPlaybackInterval NOTIFY playbackIntervalChanged)
+  Q_PROPERTY(bool waitForDrawing READ waitForDrawing WRITE setWaitForDrawing NOTIFY waitForDrawingChanged)
+  Q_PROPERTY(bool startTimePinned READ isStartTimePinned WRITE setStartTimePinned NOTIFY startTimePinnedChanged)
+  Q_PROPERTY(bool endTimePinned READ isEndTimePinned WRITE setEndTimePinned NOTIFY endTimePinnedChanged)
+  Q_PROPERTY(bool densityIndexEnabled READ isDensityIndexEnabled WRITE setDensityIndexEnabled NOTIFY densityIndexEnabledChanged)
+  Q_PROPERTY(bool densityIndexReady READ isDensityIndexReady NOTIFY densityIndexReadyChanged)
+  Q_PROPERTY(bool skipEmptySteps READ skipEmptySteps WRITE setSkipEmptySteps NOTIFY skipEmptyStepsChanged)
 
 signals:
   void numberOfStepsChanged();
@@ -61,6 +85,17 @@ signals:
   void endStepChanged();
   void stepTimesChanged();
   void geoViewChanged();
+  void playingChanged();
+  void playbackLoopChanged();
+  void playbackReverseChanged();
+  void playbackIntervalChanged();
+  void waitForDrawingChanged();
+  void startTimePinnedChanged();
+  void endTimePinnedChanged();
+  void densityIndexEnabledChanged();
+  void densityIndexReadyChanged();
+  void skipEmptyStepsChanged();
+  void stepCountsChanged(int firstStep, int lastStep);
 
 public:
   TimeSliderController(QObject* parent = nullptr);
@@ -85,18 +120,70 @@ public:
   int endStep() const;
 
   QVariantList stepTimes() const;
+  QAbstractListModel* steps() const;
+
+  Q_INVOKABLE QDateTime stepTime(int stepIndex) const;
+  Q_INVOKABLE qint64 stepCount(int stepIndex) const;
 
   Q_INVOKABLE void setStartInterval(int intervalIndex);
   Q_INVOKABLE void setEndInterval(int intervalIndex);
   Q_INVOKABLE void setStartAndEndIntervals(int startIndex, int endIndex);
 
+  Q_INVOKABLE void play();
+  Q_INVOKABLE void pause();
+  Q_INVOKABLE void stepForward();
+  Q_INVOKABLE void stepBack();
+
+  bool isPlaying() const;
+  void setPlaying(bool playing);
+
+  bool playbackLoop() const;
+  void setPlaybackLoop(bool playbackLoop);
+
+  bool playbackReverse() const;
+  void setPlaybackReverse(bool playbackReverse);
+
+  int playbackInterval() const;
+  void setPlaybackInterval(int playbackInterval);
+
+  bool waitForDrawing() const;
+  void setWaitForDrawing(bool waitForDrawing);
+
+  bool isStartTimePinned() const;
+  void setStartTimePinned(bool startTimePinned);
+
+  bool isEndTimePinned() const;
+  void setEndTimePinned(bool endTimePinned);
+
+  bool isDensityIndexEnabled() const;
+  void setDensityIndexEnabled(bool densityIndexEnabled);
+
+  bool isDensityIndexReady() const;
+
+  bool skipEmptySteps() const;
+  void setSkipEmptySteps(bool skipEmptySteps);
+
 private slots:
   void onOperationalLayersChanged();
   void onMapChanged();
   void onSceneChanged();
+  void initializeTimeProperties();
+  void onPlaybackTimeout();
 
 private:
-  void initializeTimeProperties();
+  void setOperationalLayers(Esri::ArcGISRuntime::LayerListModel* operationalLayers);
+  void scheduleTimePropertiesUpdate();
+  void syncLayerTimeInfo();
+  void addLayerTimeInfo(Esri::ArcGISRuntime::Layer* layer);
+  void updateLayerTimeInfo(Esri::ArcGISRuntime::Layer* layer);
+  void removeLayerTimeInfo(Esri::ArcGISRuntime::Layer* layer);
+  void clearLayerTimeInfo();
+  void connectDrawStatus();
+  void advancePlayback();
+  void scheduleNextFrame(bool awaitDrawing);
+  void onDrawCompleted();
+  void updateDensityIndex(QList<Esri::ArcGISRuntime::FeatureTable*> featureTables, bool stepsChanged);
+  int stepDelta(int direction, bool stopAtEnd) const;
 
   void setNumberOfSteps(int numberOfSteps);
   void setStepTimes();
@@ -104,15 +191,41 @@ private:
   void setStartStep(int startStep);
   void setEndStep(int endStep);
   void calculateStepPositions();
+  void applyTimeExtent(const Esri::ArcGISRuntime::TimeExtent& timeExtent, int startStep, int endStep);
 
   Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
   Esri::ArcGISRuntime::SceneQuickView* m_sceneView = nullptr;
   Esri::ArcGISRuntime::LayerListModel* m_operationalLayers = nullptr;
   Esri::ArcGISRuntime::TimeExtent m_fullTimeExtent;
-  QVariantList m_stepTimes;
+  TimeSliderStepsModel* m_steps = nullptr;
+  TimeSliderLayerTimes m_layerTimes;
+  QHash<Esri::ArcGISRuntime::Layer*, QList<QMetaObject::Connection>> m_layerConnections;
+  QList<QMetaObject::Connection> m_operationalLayersConnections;
+  QTimer* m_updateTimer = nullptr;
+  bool m_layersDirty = true;
+
+  QTimer* m_playbackTimer = nullptr;
+  QElapsedTimer m_frameClock;
+  QMetaObject::Connection m_drawStatusConnection;
+  bool m_playing = false;
+  bool m_playbackLoop = true;
+  bool m_playbackReverse = false;
+  int m_playbackInterval = 500;
+  bool m_waitForDrawing = true;
+  bool m_startTimePinned = false;
+  bool m_endTimePinned = false;
+  bool m_animateReverse = false;
+  bool m_needsRestart = false;
+  bool m_awaitingDraw = false;
+  bool m_viewDrawing = false; // whether the view's last draw status was in progress
+
+  TimeSliderDensityIndex* m_densityIndex = nullptr;
+  QList<Esri::ArcGISRuntime::FeatureTable*> m_densityFeatureTables;
+  bool m_densityIndexEnabled = false;
+  bool m_skipEmptySteps = false;
 
   int m_numberOfSteps = -1;
-  double m_intervalMS = -1;
+  TimeSliderSteps m_timeSteps;
   int m_startStep = -1;
   int m_endStep = -1;
 };
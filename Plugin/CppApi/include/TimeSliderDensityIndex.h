@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TIMESLIDERDENSITYINDEX_H
+#define TIMESLIDERDENSITYINDEX_H
+
+// toolkit headers
+#include "TimeSliderSteps.h"
+
+// C++ API headers
+#include "TaskWatcher.h"
+
+// Qt headers
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QUuid>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class FeatureTable;
+
+namespace Toolkit
+{
+
+class TimeSliderDensityIndex : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TimeSliderDensityIndex(QObject* parent = nullptr);
+  ~TimeSliderDensityIndex();
+
+  void build(const QList<Esri::ArcGISRuntime::FeatureTable*>& featureTables, const TimeSliderSteps& steps);
+  void clear();
+
+  bool isReady() const;
+  int numberOfSteps() const;
+
+  qint64 count(int stepIndex) const;
+  qint64 count(int firstStep, int lastStep) const;
+
+  int maximumQueriesInFlight() const;
+  void setMaximumQueriesInFlight(int maximumQueriesInFlight);
+
+  static int maximumIndexedSteps();
+
+signals:
+  void countsChanged(int firstStep, int lastStep);
+  void readyChanged();
+
+private:
+  struct PendingQuery
+  {
+    QPointer<Esri::ArcGISRuntime::FeatureTable> featureTable;
+    int stepIndex = -1;
+  };
+
+  void startQueries();
+  void onQueryFeatureCountCompleted(Esri::ArcGISRuntime::FeatureTable* featureTable, QUuid taskId, qint64 count);
+  void onQueryError(Esri::ArcGISRuntime::FeatureTable* featureTable);
+  void onTableDestroyed();
+  void abandon();
+  void addCount(int stepIndex, qint64 count);
+  void finishStep(int stepIndex);
+  void setReady(bool ready);
+
+  TimeSliderSteps m_steps;
+
+  QVector<qint64> m_counts;           // the number of features in each step, -1 while the step is unknown
+  QVector<qint64> m_partialCounts;    // the totals so far of steps which some tables have not reported
+  QVector<int> m_outstanding;         // the number of tables still to report for each step
+  QVector<qint64> m_cumulativeCounts; // running totals once every step is known
+  // the queries are made in step order from this cursor, rather than queued up front
+  QList<QPointer<Esri::ArcGISRuntime::FeatureTable>> m_featureTables;
+  int m_nextStep = 0;
+  int m_nextTable = 0;
+  QHash<QUuid, PendingQuery> m_running;
+  QHash<QUuid, Esri::ArcGISRuntime::TaskWatcher> m_taskWatchers;
+  QList<QMetaObject::Connection> m_connections;
+  int m_maximumQueriesInFlight = 4;
+  int m_remainingSteps = 0;
+  bool m_ready = false;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TIMESLIDERDENSITYINDEX_H
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TIMESLIDERLAYERTIMES_H
+#define TIMESLIDERLAYERTIMES_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "TimeExtent.h"
+#include "TimeValue.h"
+
+// Qt headers
+#include <QHash>
+#include <QList>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class FeatureTable;
+class Layer;
+
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT TimeSliderLayerTimes
+{
+public:
+  // the combined time properties of the layers taking part in time filtering
+  struct Union
+  {
+    bool anyTimeAware = false;
+    Esri::ArcGISRuntime::TimeExtent fullTimeExtent;
+    Esri::ArcGISRuntime::TimeValue timeInterval;
+    QList<Esri::ArcGISRuntime::FeatureTable*> featureTables;
+  };
+
+  TimeSliderLayerTimes() = default;
+
+  bool contains(Esri::ArcGISRuntime::Layer* layer) const;
+  bool isTimeAware(Esri::ArcGISRuntime::Layer* layer) const;
+  QList<Esri::ArcGISRuntime::Layer*> layers() const;
+
+  void insert(Esri::ArcGISRuntime::Layer* layer);
+  void setTimeProperties(Esri::ArcGISRuntime::Layer* layer,
+                         const Esri::ArcGISRuntime::TimeExtent& fullTimeExtent,
+                         const Esri::ArcGISRuntime::TimeValue& timeInterval);
+  void remove(Esri::ArcGISRuntime::Layer* layer);
+  void clear();
+
+  Union timeUnion() const;
+
+private:
+  // the time properties of a layer, which are only read again when the layer finishes loading
+  struct Entry
+  {
+    bool timeAware = false;
+    bool loaded = false;
+    Esri::ArcGISRuntime::TimeExtent fullTimeExtent;
+    Esri::ArcGISRuntime::TimeValue timeInterval;
+  };
+
+  QHash<Esri::ArcGISRuntime::Layer*, Entry> m_entries;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TIMESLIDERLAYERTIMES_H
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TIMESLIDERSTEPS_H
+#define TIMESLIDERSTEPS_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "TimeValue.h"
+
+// Qt headers
+#include <QDateTime>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT TimeSliderSteps
+{
+public:
+  TimeSliderSteps() = default;
+
+  static TimeSliderSteps fromInterval(const QDateTime& startTime, const QDateTime& endTime,
+                                      const Esri::ArcGISRuntime::TimeValue& interval);
+  static TimeSliderSteps fixed(const QDateTime& startTime, qint64 intervalMSecs, int numberOfSteps);
+
+  bool isEmpty() const;
+  bool isCalendar() const;
+  int numberOfSteps() const;
+  qint64 intervalMSecs() const;
+
+  qint64 stepStart(int stepIndex) const;
+  QDateTime stepTime(int stepIndex) const;
+  int stepIndex(qint64 msecsSinceEpoch) const;
+  QDateTime toDateTime(qint64 msecsSinceEpoch) const;
+
+  bool operator==(const TimeSliderSteps& other) const;
+  bool operator!=(const TimeSliderSteps& other) const;
+
+private:
+  qint64 m_startMSecs = 0;
+  qint64 m_intervalMSecs = 0; // the average interval of calendar steps
+  int m_numberOfSteps = 0;
+  Qt::TimeSpec m_timeSpec = Qt::LocalTime;
+  int m_offsetFromUtc = 0;
+
+  // the starts of the steps and the end of the last step, only for calendar units
+  QVector<qint64> m_calendarStepStarts;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TIMESLIDERSTEPS_H
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TIMESLIDERSTEPSMODEL_H
+#define TIMESLIDERSTEPSMODEL_H
+
+// toolkit headers
+#include "TimeSliderSteps.h"
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QAbstractListModel>
+#include <QDateTime>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TimeSliderDensityIndex;
+
+class TOOLKIT_EXPORT TimeSliderStepsModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+  enum TimeSliderStepsRoles
+  {
+    StepTimeRole = Qt::UserRole + 1,
+    StepIndexRole = Qt::UserRole + 2,
+    StepCountRole = Qt::UserRole + 3
+  };
+
+  explicit TimeSliderStepsModel(QObject* parent = nullptr);
+  ~TimeSliderStepsModel();
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+  int count() const;
+
+  Q_INVOKABLE QDateTime stepTime(int stepIndex) const;
+  Q_INVOKABLE int stepIndex(const QDateTime& time) const;
+
+  Q_INVOKABLE void setSteps(const QDateTime& startTime, double intervalMS, int numberOfSteps);
+  void setSteps(const TimeSliderSteps& steps);
+  const TimeSliderSteps& steps() const;
+  void setDensityIndex(const TimeSliderDensityIndex* densityIndex);
+  void updateStepCounts(int firstStep, int lastStep);
+
+signals:
+  void countChanged();
+
+protected:
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  TimeSliderSteps m_timeSteps;
+  const TimeSliderDensityIndex* m_densityIndex = nullptr;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TIMESLIDERSTEPSMODEL_H
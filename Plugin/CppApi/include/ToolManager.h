@@ -19,8 +19,10 @@
 
 #include "ToolkitCommon.h"
 
+#include <QHash>
+#include <QList>
+#include <QMultiMap>
 #include <QObject>
-#include <QMap>
 #include <memory>
 
 namespace Esri
@@ -36,7 +38,7 @@ class TOOLKIT_EXPORT ToolManager : public QObject
 {
   Q_OBJECT
 
-  using ToolsList = QMap<QString, AbstractTool*>;
+  using ToolsList = QMultiMap<QString, AbstractTool*>;
 
 public:
 
@@ -53,10 +55,16 @@ public:
   void clearTools();
 
   AbstractTool* tool(const QString& toolName) const;
+  QList<AbstractTool*> tools(const QString& toolName) const;
 
   template<class T>
   T* tool() const;
 
+  template<class T>
+  QList<T*> tools() const;
+
+  bool isSubscribed(AbstractTool* tool) const;
+
   ToolsList::iterator begin();
   ToolsList::iterator end();
 
@@ -68,9 +76,24 @@ signals:
   void toolRemoved(const QString& toolName);
 
 private:
+  // the bookkeeping for one registered tool
+  struct ToolEntry
+  {
+    QString toolName;
+    QList<QMetaObject::Connection> toolConnections;
+    QList<QMetaObject::Connection> eventConnections;
+    bool subscribed = false;
+  };
+
   ToolManager();
 
+  void updateSubscription(AbstractTool* tool);
+  void subscribe(AbstractTool* tool, ToolEntry& entry);
+  void unsubscribe(ToolEntry& entry);
+  void forgetTool(AbstractTool* tool, bool notify);
+
   ToolsList m_tools;
+  QHash<AbstractTool*, ToolEntry> m_entries;
 };
 
 template<class T>
@@ -92,6 +115,22 @@ T* ToolManager::tool() const
   return nullptr;
 }
 
+template<class T>
+QList<T*> ToolManager::tools() const
+{
+  QList<T*> matchingTools;
+  auto it = begin();
+  const auto itEnd = end();
+  for (; it != itEnd; ++it)
+  {
+    T* tool = qobject_cast<T*>(it.value());
+    if (tool)
+      matchingTools.append(tool);
+  }
+
+  return matchingTools;
+}
+
 } // Toolkit
 } // ArcGISRuntime
 } // Esri
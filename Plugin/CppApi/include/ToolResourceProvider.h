@@ -24,6 +24,10 @@
 #include <QMouseEvent>
 #include <QUuid>
 #include <QCursor>
+#include <QHash>
+#include <QPoint>
+
+class QTimer;
 
 namespace Esri
 {
@@ -49,6 +53,7 @@ class TOOLKIT_EXPORT ToolResourceProvider : public QObject
 public:
 
   static ToolResourceProvider* instance();
+  static ToolResourceProvider* forGeoView(GeoView* geoView);
 
   ~ToolResourceProvider();
 
@@ -69,6 +74,9 @@ public:
 
   void setMouseCursor(const QCursor& cursor);
 
+  bool isCoalescingMouseMoves() const;
+  void setCoalescingMouseMoves(bool coalescingMouseMoves);
+
   void clear();
 
 public slots:
@@ -113,11 +121,31 @@ signals:
   void mouseDoubleClickedPoint(const Point& point);
 
 private:
+  enum class ViewType
+  {
+    None,
+    Map,
+    Scene
+  };
+
   explicit ToolResourceProvider(QObject* parent = nullptr);
 
+  void emitMousePoint(void (ToolResourceProvider::*pointSignal)(const Point&), const QMouseEvent& mouseEvent);
+  Point screenToPoint(const QPoint& screenPoint) const;
+  void flushMouseMove();
+
   GeoView* m_geoView = nullptr;
   Map* m_map = nullptr;
   Scene* m_scene = nullptr;
+  ViewType m_viewType = ViewType::None;
+
+  bool m_coalescingMouseMoves = false;
+  bool m_mouseMovePending = false;
+  QPoint m_pendingMousePosition;
+  QTimer* m_mouseMoveTimer = nullptr;
+
+  // the per-view contexts, which are only held by the global instance
+  QHash<GeoView*, ToolResourceProvider*> m_viewContexts;
 };
 
 } // Toolkit
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TOOLKITPROFILER_H
+#define TOOLKITPROFILER_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+Q_DECLARE_LOGGING_CATEGORY(lcToolkitProfiling)
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT ToolkitProfiler : public QObject
+{
+  Q_OBJECT
+
+  // whether the toolkit was built with CONFIG+=toolkit_profiling
+  Q_PROPERTY(bool available READ isAvailable CONSTANT)
+  Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+
+public:
+  static ToolkitProfiler* instance();
+  static bool isActive();
+
+  ~ToolkitProfiler();
+
+  bool isAvailable() const;
+
+  bool isEnabled() const;
+  void setEnabled(bool enabled);
+
+  void record(const QString& scope, qint64 nanoseconds);
+
+  Q_INVOKABLE QStringList scopes() const;
+  Q_INVOKABLE QVariantMap statistics(const QString& scope) const;
+  Q_INVOKABLE QVariantMap allStatistics() const;
+  Q_INVOKABLE QString toJson() const;
+  Q_INVOKABLE bool dumpToFile(const QString& filePath) const;
+  Q_INVOKABLE void reset();
+
+signals:
+  void enabledChanged();
+
+private:
+  explicit ToolkitProfiler(QObject* parent = nullptr);
+
+  struct ScopeStatistics
+  {
+    qint64 count = 0;
+    qint64 totalNanoseconds = 0;
+    qint64 minimumNanoseconds = 0;
+    qint64 maximumNanoseconds = 0;
+    // bucket i counts durations in [2^i, 2^(i+1)) microseconds, bucket 0 everything below 2
+    QVector<qint64> histogram;
+  };
+
+  static QVariantMap toVariantMap(const ScopeStatistics& statistics);
+
+  mutable QMutex m_mutex;
+  QHash<QString, ScopeStatistics> m_statistics;
+};
+
+class TOOLKIT_EXPORT ToolkitProfileScope
+{
+public:
+  explicit ToolkitProfileScope(const char* scope);
+  explicit ToolkitProfileScope(const QString& scope);
+  ~ToolkitProfileScope();
+
+private:
+  Q_DISABLE_COPY(ToolkitProfileScope)
+
+  QString m_scope;
+  QElapsedTimer m_timer;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#define TOOLKIT_PROFILE_CONCAT_INNER(a, b) a##b
+#define TOOLKIT_PROFILE_CONCAT(a, b) TOOLKIT_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef TOOLKIT_PROFILING
+  // times the rest of the enclosing block under a fixed scope name
+  #define TOOLKIT_PROFILE_SCOPE(scope) \
+    Esri::ArcGISRuntime::Toolkit::ToolkitProfileScope TOOLKIT_PROFILE_CONCAT(toolkitProfileScope, __LINE__)(scope)
+  // as TOOLKIT_PROFILE_SCOPE, but the name is only built while profiling is enabled
+  #define TOOLKIT_PROFILE_SCOPE_DYNAMIC(scope) \
+    Esri::ArcGISRuntime::Toolkit::ToolkitProfileScope TOOLKIT_PROFILE_CONCAT(toolkitProfileScope, __LINE__)( \
+      Esri::ArcGISRuntime::Toolkit::ToolkitProfiler::isActive() ? QString(scope) : QString())
+#else
+  #define TOOLKIT_PROFILE_SCOPE(scope) do {} while (false)
+  #define TOOLKIT_PROFILE_SCOPE_DYNAMIC(scope) do {} while (false)
+#endif // TOOLKIT_PROFILING
+
+#endif // TOOLKITPROFILER_H
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TOOLKITSTARTUPREPORT_H
+#define TOOLKITSTARTUPREPORT_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QLoggingCategory>
+#include <QObject>
+#include <QVariantMap>
+
+// STL headers
+#include <atomic>
+
+Q_DECLARE_LOGGING_CATEGORY(lcToolkitStartup)
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT ToolkitStartupReport : public QObject
+{
+  Q_OBJECT
+
+  // whether the toolkit was built with CONFIG+=toolkit_startup
+  Q_PROPERTY(bool startupOptimized READ isStartupOptimized CONSTANT)
+
+  // the times in milliseconds the toolkit spent before the first frame
+  Q_PROPERTY(double registrationTime READ registrationTime NOTIFY reportChanged)
+  Q_PROPERTY(double toolInitializationTime READ toolInitializationTime NOTIFY reportChanged)
+
+  // the time in milliseconds from the toolkit being loaded to the first frame, or -1 until then
+  Q_PROPERTY(double firstFrameTime READ firstFrameTime NOTIFY reportChanged)
+
+public:
+  static ToolkitStartupReport* instance();
+
+  ~ToolkitStartupReport();
+
+  bool isStartupOptimized() const;
+
+  double registrationTime() const;
+  double toolInitializationTime() const;
+  double firstFrameTime() const;
+
+  void start();
+  bool isRecording() const;
+  void addRegistrationTime(qint64 nanoseconds);
+  void addToolInitializationTime(const QString& toolName, qint64 nanoseconds);
+
+  Q_INVOKABLE void watchWindow(QObject* window);
+  Q_INVOKABLE QVariantMap toVariantMap() const;
+
+signals:
+  void reportChanged();
+
+private slots:
+  void reportFirstFrame();
+
+private:
+  explicit ToolkitStartupReport(QObject* parent = nullptr);
+
+  QElapsedTimer m_timer;
+  qint64 m_registrationNanoseconds = 0;
+  qint64 m_toolInitializationNanoseconds = 0;
+  QHash<QString, qint64> m_toolNanoseconds;
+  QList<QMetaObject::Connection> m_windowConnections;
+
+  // written from the render thread
+  std::atomic<qint64> m_firstFrameNanoseconds{-1};
+  bool m_firstFrameReported = false;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TOOLKITSTARTUPREPORT_H
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef VIEWPOINTOBSERVER_H
+#define VIEWPOINTOBSERVER_H
+
+// toolkit headers
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Envelope.h"
+
+// Qt headers
+#include <QHash>
+#include <QObject>
+
+class QTimer;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class GeoView;
+class MapQuickView;
+class SceneQuickView;
+
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT ViewpointObserver : public QObject
+{
+  Q_OBJECT
+
+  Q_PROPERTY(double heading READ heading NOTIFY headingChanged)
+  Q_PROPERTY(double scale READ scale NOTIFY scaleChanged)
+  Q_PROPERTY(int sampleInterval READ sampleInterval WRITE setSampleInterval NOTIFY sampleIntervalChanged)
+  Q_PROPERTY(double headingEpsilon READ headingEpsilon WRITE setHeadingEpsilon NOTIFY headingEpsilonChanged)
+  Q_PROPERTY(double scaleEpsilon READ scaleEpsilon WRITE setScaleEpsilon NOTIFY scaleEpsilonChanged)
+  Q_PROPERTY(double extentEpsilon READ extentEpsilon WRITE setExtentEpsilon NOTIFY extentEpsilonChanged)
+
+public:
+  static ViewpointObserver* forGeoView(Esri::ArcGISRuntime::GeoView* geoView);
+
+  ~ViewpointObserver();
+
+  Esri::ArcGISRuntime::GeoView* geoView() const;
+
+  double heading() const;
+  double scale() const;
+  Esri::ArcGISRuntime::Envelope extent() const;
+
+  int sampleInterval() const;
+  void setSampleInterval(int sampleInterval);
+
+  double headingEpsilon() const;
+  void setHeadingEpsilon(double headingEpsilon);
+
+  double scaleEpsilon() const;
+  void setScaleEpsilon(double scaleEpsilon);
+
+  double extentEpsilon() const;
+  void setExtentEpsilon(double extentEpsilon);
+
+  Q_INVOKABLE void sample();
+
+signals:
+  void headingChanged(double heading, double delta);
+  void scaleChanged(double scale, double delta);
+  void extentChanged(const Esri::ArcGISRuntime::Envelope& extent);
+  void viewpointSampled();
+  void sampleIntervalChanged();
+  void headingEpsilonChanged();
+  void scaleEpsilonChanged();
+  void extentEpsilonChanged();
+
+private:
+  explicit ViewpointObserver(Esri::ArcGISRuntime::GeoView* geoView, QObject* parent = nullptr);
+
+  void scheduleSample();
+  bool extentMoved(const Esri::ArcGISRuntime::Envelope& extent) const;
+
+  static QHash<Esri::ArcGISRuntime::GeoView*, ViewpointObserver*>& observers();
+
+  Esri::ArcGISRuntime::GeoView* m_geoView = nullptr;
+  Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
+  Esri::ArcGISRuntime::SceneQuickView* m_sceneView = nullptr;
+  QTimer* m_sampleTimer = nullptr;
+
+  bool m_sampled = false;
+  double m_heading = 0.0;
+  double m_scale = 0.0;
+  Esri::ArcGISRuntime::Envelope m_extent;
+
+  double m_headingEpsilon = 0.01;
+  double m_scaleEpsilon = 1e-6;
+  double m_extentEpsilon = 1e-6;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // VIEWPOINTOBSERVER_H
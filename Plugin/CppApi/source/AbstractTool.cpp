@@ -15,6 +15,15 @@
  ******************************************************************************/
 
 #include "AbstractTool.h"
+#include "ToolkitProfiler.h"
+#include "ToolkitStartupReport.h"
+#include "ToolResourceProvider.h"
+
+// Qt headers
+#include <QElapsedTimer>
+
+// STL headers
+#include <atomic>
 
 namespace Esri
 {
@@ -22,6 +31,18 @@ namespace ArcGISRuntime
 {
 namespace Toolkit
 {
+
+namespace
+{
+
+// builds with CONFIG+=toolkit_startup defer the initialization of every tool
+#ifdef TOOLKIT_DEFERRED_INITIALIZATION
+std::atomic<bool> s_initializationDeferred(true);
+#else
+std::atomic<bool> s_initializationDeferred(false);
+#endif
+
+}
 /*!
   \class Esri::ArcGISRuntime::Toolkit::AbstractTool
   \inmodule ArcGISQtToolkit
@@ -88,6 +109,10 @@ void AbstractTool::setActive(bool active)
   if (m_active == active)
     return;
 
+  // a tool is wired up at the latest when it is first used
+  if (active)
+    initialize();
+
   m_active = active;
 
   emit activeChanged();
@@ -101,6 +126,162 @@ bool AbstractTool::isActive() const
   return m_active;
 }
 
+/*!
+   \brief Returns the resource provider this tool takes its view and events from.
+
+   Unless \l setResourceProvider has been called, this is the global
+   \l {ToolResourceProvider::instance}{ToolResourceProvider::instance()}.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+ToolResourceProvider* AbstractTool::resourceProvider() const
+{
+  return m_resourceProvider ? m_resourceProvider.data() : ToolResourceProvider::instance();
+}
+
+/*!
+   \brief Sets the resource provider this tool takes its view and events from
+   to \a resourceProvider.
+
+   Pass a per-view context from \l {ToolResourceProvider::forGeoView}{forGeoView}
+   so that the tool only receives the events of that view. Pass \c nullptr to
+   return to the global provider.
+
+   \since Esri::ArcGISRuntime 100.5
+   \sa resourceProviderChanged
+ */
+void AbstractTool::setResourceProvider(ToolResourceProvider* resourceProvider)
+{
+  if (resourceProvider == ToolResourceProvider::instance())
+    resourceProvider = nullptr;
+
+  if (m_resourceProvider == resourceProvider)
+    return;
+
+  m_resourceProvider = resourceProvider;
+
+  emit resourceProviderChanged();
+}
+
+/*!
+   \brief Reimplement this method in subclasses to receive pointer and
+   location events from \a resourceProvider.
+
+   The \l ToolManager calls this when the tool becomes active, and
+   disconnects the returned connections when it becomes inactive or its
+   resource provider changes. Tools therefore receive no events while they
+   are inactive.
+
+   Returns an empty list.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+QList<QMetaObject::Connection> AbstractTool::connectEventStreams(ToolResourceProvider* resourceProvider)
+{
+  Q_UNUSED(resourceProvider)
+  return QList<QMetaObject::Connection>();
+}
+
+/*!
+   \brief Connects the tool to its resource provider and does its initial
+   work, if that has not happened yet.
+
+   Unless \l isInitializationDeferred is \c true, tools initialize themselves
+   when they are constructed. Otherwise this happens when the tool is first
+   activated, or when its view calls this method as it is first shown.
+
+   \since Esri::ArcGISRuntime 100.5
+   \sa initializedChanged
+ */
+void AbstractTool::initialize()
+{
+  if (m_initialized)
+    return;
+
+  m_initialized = true;
+
+  TOOLKIT_PROFILE_SCOPE_DYNAMIC(toolName() + QStringLiteral("::initialize"));
+
+  // tools are only timed until the startup report has its first frame
+  ToolkitStartupReport* startupReport = ToolkitStartupReport::instance();
+  const bool timed = startupReport->isRecording();
+  QElapsedTimer timer;
+  if (timed)
+    timer.start();
+
+  initializeTool();
+
+  if (timed)
+    startupReport->addToolInitializationTime(toolName(), timer.nsecsElapsed());
+
+  emit initializedChanged();
+}
+
+/*!
+   \property AbstractTool::initialized
+   \brief Whether the tool has connected to its resource provider and done
+   its initial work.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+bool AbstractTool::isInitialized() const
+{
+  return m_initialized;
+}
+
+/*!
+   \brief Returns whether tools wait to be activated or shown before they
+   initialize.
+
+   The default is \c false, unless the toolkit was built with
+   \c {CONFIG+=toolkit_startup}.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+bool AbstractTool::isInitializationDeferred()
+{
+  return s_initializationDeferred;
+}
+
+/*!
+   \brief Sets whether tools constructed from now on wait to be activated or
+   shown before they initialize to \a deferred.
+
+   Call this before the QML which creates the tools is loaded.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+void AbstractTool::setInitializationDeferred(bool deferred)
+{
+  s_initializationDeferred = deferred;
+}
+
+/*!
+   \brief Reimplement this method in subclasses to connect to the resource
+   provider and do the initial work of the tool.
+
+   It is called once, from \l initialize.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+void AbstractTool::initializeTool()
+{
+}
+
+/*!
+   \brief Initializes the tool now, unless initialization is deferred.
+
+   Call this at the end of the constructor of the most derived tool, so that
+   its \l initializeTool is the one which runs.
+
+   \since Esri::ArcGISRuntime 100.5
+ */
+void AbstractTool::initializeUnlessDeferred()
+{
+  if (!s_initializationDeferred)
+    initialize();
+}
+
 // Signals
 /*!
   \fn void Esri::ArcGISRuntime::Toolkit::AbstractTool::errorOccurred(const Error& error)
@@ -111,6 +292,17 @@ bool AbstractTool::isActive() const
   \endlist
  */
 
+/*!
+  \fn void Esri::ArcGISRuntime::Toolkit::AbstractTool::initializedChanged()
+  \brief Signal emitted when the \l initialized property changes.
+  \since Esri::ArcGISRuntime 100.5
+ */
+
+/*!
+  \fn void Esri::ArcGISRuntime::Toolkit::AbstractTool::resourceProviderChanged()
+  \brief Signal emitted when the resource provider of this tool changes.
+ */
+
 /*!
   \fn void Esri::ArcGISRuntime::Toolkit::AbstractTool::propertyChanged(const QString& propertyName, const QVariant& propertyValue)
   \brief Signal emitted when a property of this tool changes.
@@ -21,6 +21,7 @@
 #include "ArcGISCompassController.h"
 #include "ToolResourceProvider.h"
 #include "ToolManager.h"
+#include "ViewpointObserver.h"
 
 using namespace Esri::ArcGISRuntime;
 
@@ -49,12 +50,38 @@ ArcGISCompassController::ArcGISCompassController(QObject *parent):
 {
   ToolManager::instance().addTool(this);
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::geoViewChanged, this, [this]()
+  initializeUnlessDeferred();
+}
+
+/*!
+  \internal
+ */
+void ArcGISCompassController::initializeTool()
+{
+  connectResourceProvider();
+  connect(this, &AbstractTool::resourceProviderChanged, this, &ArcGISCompassController::connectResourceProvider);
+}
+
+/*!
+  \internal
+
+  Follows the view of the current \l {AbstractTool::resourceProvider}{resourceProvider}.
+ */
+void ArcGISCompassController::connectResourceProvider()
+{
+  disconnect(m_geoViewConnection);
+
+  ToolResourceProvider* provider = resourceProvider();
+  m_geoViewConnection = connect(provider, &ToolResourceProvider::geoViewChanged, this, [this, provider]()
   {
-    GeoView* geoView = ToolResourceProvider::instance()->geoView();
+    GeoView* geoView = provider->geoView();
     if (geoView)
       setView(geoView);
   });
+
+  // a per-view context already knows its view
+  if (provider != ToolResourceProvider::instance() && provider->geoView())
+    setView(provider->geoView());
 }
 
 /*!
@@ -132,14 +159,7 @@ bool ArcGISCompassController::setView(MapQuickView* mapView)
   // set mapView
   m_mapView = mapView;
 
-  connect(m_mapView, &MapQuickView::mapRotationChanged, this,
-  [this]()
-  {
-    m_heading = m_mapView->mapRotation();
-    emit headingChanged();
-  });
-
-  m_heading = mapView->mapRotation();
+  connectViewpointObserver(ViewpointObserver::forGeoView(m_mapView));
 
   return true;
 }
@@ -156,16 +176,32 @@ bool ArcGISCompassController::setView(SceneQuickView* sceneView)
   // set SceneView
   m_sceneView = sceneView;
 
-  connect(m_sceneView, &SceneQuickView::viewpointChanged, this,
-  [this]()
+  connectViewpointObserver(ViewpointObserver::forGeoView(m_sceneView));
+
+  return true;
+}
+
+/*!
+  \internal
+
+  Follows the heading published by the shared \a observer of the view, which
+  reads the camera at most once per frame and ignores insignificant changes.
+ */
+void ArcGISCompassController::connectViewpointObserver(ViewpointObserver* observer)
+{
+  if (!observer)
+    return;
+
+  connect(observer, &ViewpointObserver::headingChanged, this, [this](double heading)
   {
-    m_heading = m_sceneView->currentViewpointCamera().heading();
+    if (m_heading == heading)
+      return;
+
+    m_heading = heading;
     emit headingChanged();
   });
 
-  m_heading = m_sceneView->currentViewpointCamera().heading();
-
-  return true;
+  m_heading = observer->heading();
 }
 
 double ArcGISCompassController::heading() const
@@ -17,10 +17,21 @@
 
 #include "ArcGISRuntimeToolkit.h"
 #include <QtQml>
+#include <QElapsedTimer>
 
 #include "ArcGISCompassController.h"
+#include "CalloutItem.h"
+#include "CoordinateConversionBatchResults.h"
 #include "CoordinateConversionController.h"
+#include "CoordinateConversionTrackingModel.h"
+#include "OverviewMapController.h"
+#include "PopupStackModel.h"
+#include "SearchController.h"
+#include "ThumbnailImageProvider.h"
 #include "TimeSliderController.h"
+#include "TimeSliderStepsModel.h"
+#include "ToolkitProfiler.h"
+#include "ToolkitStartupReport.h"
 
 namespace Esri
 {
@@ -64,6 +75,37 @@ void ArcGISRuntimeToolkit::registerTypes(const char* uri)
   registerToolkitTypes(uri);
 }
 
+/*!
+  \brief Adds the toolkit's image providers to \a engine, and measures the
+  first frame of the windows it creates for the ToolkitStartupReport.
+
+  \list
+  \li \a uri - The namespace in which the types were registered.
+  \endlist
+ */
+void ArcGISRuntimeToolkit::initializeEngine(QQmlEngine* engine, const char* uri)
+{
+  QQmlExtensionPlugin::initializeEngine(engine, uri);
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // the engine takes ownership of the provider
+  if (!engine->imageProvider(ThumbnailImageProvider::providerId()))
+    engine->addImageProvider(ThumbnailImageProvider::providerId(), new ThumbnailImageProvider);
+
+  auto applicationEngine = qobject_cast<QQmlApplicationEngine*>(engine);
+  if (applicationEngine)
+  {
+    connect(applicationEngine, &QQmlApplicationEngine::objectCreated, ToolkitStartupReport::instance(), [](QObject* object)
+    {
+      ToolkitStartupReport::instance()->watchWindow(object);
+    });
+  }
+
+  ToolkitStartupReport::instance()->addRegistrationTime(timer.nsecsElapsed());
+}
+
 /*!
   \brief Static type registration function to ensure the types are accessible
   in the QML environment.
@@ -79,10 +121,43 @@ void ArcGISRuntimeToolkit::registerTypes(const char* uri)
  */
 void ArcGISRuntimeToolkit::registerToolkitTypes(const char* uri)
 {
+  ToolkitStartupReport* startupReport = ToolkitStartupReport::instance();
+  startupReport->start();
+  QElapsedTimer timer;
+  timer.start();
+
   // types
   qmlRegisterType<CoordinateConversionController>(uri, s_versionMajor100, s_versionMinorUpdate2, "CoordinateConversionController");
   qmlRegisterType<ArcGISCompassController>(uri, s_versionMajor100, s_versionMinorUpdate2, "ArcGISCompassController");
   qmlRegisterType<TimeSliderController>(uri, s_versionMajor100, s_versionMinorUpdate3, "TimeSliderController");
+  qmlRegisterType<TimeSliderStepsModel>(uri, s_versionMajor100, s_versionMinorUpdate5, "TimeSliderStepsModel");
+  qmlRegisterType<OverviewMapController>(uri, s_versionMajor100, s_versionMinorUpdate5, "OverviewMapController");
+  qmlRegisterType<CalloutItem>(uri, s_versionMajor100, s_versionMinorUpdate5, "CalloutItem");
+  qmlRegisterType<PopupStackModel>(uri, s_versionMajor100, s_versionMinorUpdate5, "PopupStackModel");
+  qmlRegisterType<SearchController>(uri, s_versionMajor100, s_versionMinorUpdate5, "SearchController");
+  qmlRegisterType<CoordinateConversionTrackingModel>(uri, s_versionMajor100, s_versionMinorUpdate5, "CoordinateConversionTrackingModel");
+
+  // singletons
+  qmlRegisterSingletonType<ToolkitProfiler>(uri, s_versionMajor100, s_versionMinorUpdate5, "ToolkitProfiler",
+                                            [](QQmlEngine*, QJSEngine*) -> QObject*
+  {
+    // the profiler outlives every engine
+    QObject* profiler = ToolkitProfiler::instance();
+    QQmlEngine::setObjectOwnership(profiler, QQmlEngine::CppOwnership);
+    return profiler;
+  });
+  qmlRegisterSingletonType<ToolkitStartupReport>(uri, s_versionMajor100, s_versionMinorUpdate5, "ToolkitStartupReport",
+                                                 [](QQmlEngine*, QJSEngine*) -> QObject*
+  {
+    QObject* report = ToolkitStartupReport::instance();
+    QQmlEngine::setObjectOwnership(report, QQmlEngine::CppOwnership);
+    return report;
+  });
+
+  // value types
+  qRegisterMetaType<CoordinateConversionBatchResults>();
+
+  startupReport->addRegistrationTime(timer.nsecsElapsed());
 }
 
 } // Toolkit
@@ -0,0 +1,643 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CalloutItem.h"
+
+// Qt headers
+#include <QSGFlatColorMaterial>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QtMath>
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// the number of segments used for each rounded corner
+const int cornerSegments = 8;
+
+// the longest miter at a sharp join, as a multiple of half the border width
+const qreal maximumMiter = 4.0;
+
+void appendPoint(QVector<QPointF>& points, const QPointF& point)
+{
+  if (!points.isEmpty() && qFuzzyCompare(points.last().x() + 1.0, point.x() + 1.0) &&
+      qFuzzyCompare(points.last().y() + 1.0, point.y() + 1.0))
+  {
+    return;
+  }
+
+  points.append(point);
+}
+
+void appendCorner(QVector<QPointF>& points, const QPointF& center, qreal radius, qreal startDegrees)
+{
+  if (radius <= 0.0)
+  {
+    appendPoint(points, center);
+    return;
+  }
+
+  for (int i = 0; i <= cornerSegments; ++i)
+  {
+    const qreal angle = qDegreesToRadians(startDegrees + 90.0 * i / cornerSegments);
+    appendPoint(points, QPointF(center.x() + radius * std::cos(angle), center.y() + radius * std::sin(angle)));
+  }
+}
+
+QPointF normalized(const QPointF& vector)
+{
+  const qreal length = std::hypot(vector.x(), vector.y());
+  return length > 0.0 ? vector / length : QPointF();
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CalloutItem
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief A native frame for a callout: a rounded rectangle with a leader
+  pointing at \l anchorPoint.
+
+  The frame is built as scene graph geometry instead of being painted on a
+  Canvas. The geometry is only rebuilt when the size of the item, the leader
+  or the corner radius and border change, and a color change only updates
+  the material. Moving \l anchorPoint just moves the item, which the scene
+  graph applies as a translation of the existing nodes. This makes it cheap to
+  keep several callouts attached to points on a moving map.
+
+  The item's size includes room for the leader on every side. Place the
+  content of the callout inside \l contentRect.
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent item.
+ */
+CalloutItem::CalloutItem(QQuickItem* parent) :
+  QQuickItem(parent)
+{
+  setFlag(ItemHasContents, true);
+}
+
+/*!
+  \brief The destructor.
+ */
+CalloutItem::~CalloutItem()
+{
+}
+
+/*!
+  \property CalloutItem::anchorPoint
+  \brief The point, in the coordinates of the parent item, which the tip of
+  the leader touches.
+
+  Changing the anchor point only moves the item.
+ */
+QPointF CalloutItem::anchorPoint() const
+{
+  return m_anchorPoint;
+}
+
+void CalloutItem::setAnchorPoint(const QPointF& anchorPoint)
+{
+  if (anchorPoint == m_anchorPoint)
+    return;
+
+  m_anchorPoint = anchorPoint;
+  updatePosition();
+  emit anchorPointChanged();
+}
+
+/*!
+  \property CalloutItem::leaderPosition
+  \brief The side or corner of the callout the leader is drawn on.
+
+  The values match \c LeaderPosition.js, apart from \c Automatic.
+  The default is \c LeaderPositionBottom.
+ */
+CalloutItem::LeaderPosition CalloutItem::leaderPosition() const
+{
+  return m_leaderPosition;
+}
+
+void CalloutItem::setLeaderPosition(LeaderPosition leaderPosition)
+{
+  if (leaderPosition == m_leaderPosition)
+    return;
+
+  m_leaderPosition = leaderPosition;
+  invalidateOutline();
+  emit leaderPositionChanged();
+}
+
+/*!
+  \property CalloutItem::leaderWidth
+  \brief The width of the base of the leader.
+
+  The default is \c 20.
+ */
+qreal CalloutItem::leaderWidth() const
+{
+  return m_leaderWidth;
+}
+
+void CalloutItem::setLeaderWidth(qreal leaderWidth)
+{
+  if (leaderWidth == m_leaderWidth)
+    return;
+
+  m_leaderWidth = leaderWidth;
+  invalidateOutline();
+  emit leaderWidthChanged();
+}
+
+/*!
+  \property CalloutItem::leaderHeight
+  \brief The distance from the base of the leader to its tip.
+
+  The default is \c 10.
+ */
+qreal CalloutItem::leaderHeight() const
+{
+  return m_leaderHeight;
+}
+
+void CalloutItem::setLeaderHeight(qreal leaderHeight)
+{
+  if (leaderHeight == m_leaderHeight)
+    return;
+
+  m_leaderHeight = leaderHeight;
+  invalidateOutline();
+  emit leaderHeightChanged();
+  emit contentRectChanged();
+}
+
+/*!
+  \property CalloutItem::cornerRadius
+  \brief The radius of the corners of the rectangle.
+
+  The default is \c 5.
+ */
+qreal CalloutItem::cornerRadius() const
+{
+  return m_cornerRadius;
+}
+
+void CalloutItem::setCornerRadius(qreal cornerRadius)
+{
+  if (cornerRadius == m_cornerRadius)
+    return;
+
+  m_cornerRadius = cornerRadius;
+  invalidateOutline();
+  emit cornerRadiusChanged();
+}
+
+/*!
+  \property CalloutItem::cornerOffset
+  \brief The distance from the corner to the leader for the corner leader positions.
+
+  The default is \c 15.
+ */
+qreal CalloutItem::cornerOffset() const
+{
+  return m_cornerOffset;
+}
+
+void CalloutItem::setCornerOffset(qreal cornerOffset)
+{
+  if (cornerOffset == m_cornerOffset)
+    return;
+
+  m_cornerOffset = cornerOffset;
+  invalidateOutline();
+  emit cornerOffsetChanged();
+}
+
+/*!
+  \property CalloutItem::borderWidth
+  \brief The width of the border.
+
+  The default is \c 2.
+ */
+qreal CalloutItem::borderWidth() const
+{
+  return m_borderWidth;
+}
+
+void CalloutItem::setBorderWidth(qreal borderWidth)
+{
+  if (borderWidth == m_borderWidth)
+    return;
+
+  m_borderWidth = borderWidth;
+  invalidateOutline();
+  emit borderWidthChanged();
+  emit contentRectChanged();
+}
+
+/*!
+  \property CalloutItem::borderColor
+  \brief The color of the border.
+
+  The default is black.
+ */
+QColor CalloutItem::borderColor() const
+{
+  return m_borderColor;
+}
+
+void CalloutItem::setBorderColor(const QColor& borderColor)
+{
+  if (borderColor == m_borderColor)
+    return;
+
+  m_borderColor = borderColor;
+  m_colorsDirty = true;
+  update();
+  emit borderColorChanged();
+}
+
+/*!
+  \property CalloutItem::backgroundColor
+  \brief The color the callout is filled with.
+
+  The default is white.
+ */
+QColor CalloutItem::backgroundColor() const
+{
+  return m_backgroundColor;
+}
+
+void CalloutItem::setBackgroundColor(const QColor& backgroundColor)
+{
+  if (backgroundColor == m_backgroundColor)
+    return;
+
+  m_backgroundColor = backgroundColor;
+  m_colorsDirty = true;
+  update();
+  emit backgroundColorChanged();
+}
+
+/*!
+  \property CalloutItem::contentRect
+  \brief The rounded rectangle of the callout, in item coordinates.
+
+  The item leaves room for the leader and the border around this rectangle
+  on every side, so the rectangle does not move when the leader does.
+ */
+QRectF CalloutItem::contentRect() const
+{
+  const qreal margin = qMax(0.0, m_leaderHeight) + qMax(0.0, m_borderWidth);
+  return QRectF(margin, margin, qMax(0.0, width() - 2.0 * margin), qMax(0.0, height() - 2.0 * margin));
+}
+
+/*!
+  \internal
+ */
+QSGNode* CalloutItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*)
+{
+  QSGNode* root = oldNode;
+  QSGGeometryNode* fillNode = nullptr;
+  QSGGeometryNode* strokeNode = nullptr;
+
+  if (!root)
+  {
+    root = new QSGNode();
+
+    fillNode = new QSGGeometryNode();
+    auto fill = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    fill->setDrawingMode(QSGGeometry::DrawTriangles);
+    fillNode->setGeometry(fill);
+    fillNode->setMaterial(new QSGFlatColorMaterial());
+    fillNode->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    root->appendChildNode(fillNode);
+
+    strokeNode = new QSGGeometryNode();
+    auto stroke = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    stroke->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    strokeNode->setGeometry(stroke);
+    strokeNode->setMaterial(new QSGFlatColorMaterial());
+    strokeNode->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    root->appendChildNode(strokeNode);
+
+    m_outlineDirty = true;
+    m_colorsDirty = true;
+  }
+  else
+  {
+    fillNode = static_cast<QSGGeometryNode*>(root->firstChild());
+    strokeNode = static_cast<QSGGeometryNode*>(fillNode->nextSibling());
+  }
+
+  if (m_outlineDirty)
+  {
+    QVector<QPointF> outline;
+    QVector<QPointF> leader;
+    buildOutline(outline, leader);
+
+    fillGeometry(fillNode->geometry(), outline, leader, contentRect().center());
+    fillNode->markDirty(QSGNode::DirtyGeometry);
+
+    strokeGeometry(strokeNode->geometry(), outline, m_borderWidth);
+    strokeNode->markDirty(QSGNode::DirtyGeometry);
+
+    m_outlineDirty = false;
+  }
+
+  if (m_colorsDirty)
+  {
+    static_cast<QSGFlatColorMaterial*>(fillNode->material())->setColor(m_backgroundColor);
+    fillNode->markDirty(QSGNode::DirtyMaterial);
+
+    static_cast<QSGFlatColorMaterial*>(strokeNode->material())->setColor(m_borderColor);
+    strokeNode->markDirty(QSGNode::DirtyMaterial);
+
+    m_colorsDirty = false;
+  }
+
+  return root;
+}
+
+/*!
+  \internal
+ */
+void CalloutItem::geometryChanged(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+  QQuickItem::geometryChanged(newGeometry, oldGeometry);
+
+  if (newGeometry.size() == oldGeometry.size())
+    return;
+
+  invalidateOutline();
+  emit contentRectChanged();
+}
+
+/*!
+  \internal
+ */
+void CalloutItem::invalidateOutline()
+{
+  m_outlineDirty = true;
+  m_leaderTip = leaderTip();
+  updatePosition();
+  update();
+}
+
+/*!
+  \internal
+
+  Moves the item so the tip of the leader is on the anchor point.
+ */
+void CalloutItem::updatePosition()
+{
+  setPosition(m_anchorPoint - m_leaderTip);
+}
+
+/*!
+  \internal
+
+  Returns the tip of the leader in item coordinates. This is cached in
+  m_leaderTip, so moving the anchor point does not rebuild the outline.
+ */
+QPointF CalloutItem::leaderTip() const
+{
+  QVector<QPointF> outline;
+  QVector<QPointF> leader;
+  buildOutline(outline, leader);
+
+  return leader.size() == 3 ? leader.at(1) : QPointF();
+}
+
+/*!
+  \internal
+
+  Builds the closed outline of the callout clockwise from the top left
+  corner, and the base, tip and base of its leader as \a leader.
+ */
+void CalloutItem::buildOutline(QVector<QPointF>& outline, QVector<QPointF>& leader) const
+{
+  const QRectF rect = contentRect();
+  if (rect.isEmpty())
+    return;
+
+  const qreal radius = qBound(0.0, m_cornerRadius, qMin(rect.width(), rect.height()) * 0.5);
+  const qreal leaderHeight = qMax(0.0, m_leaderHeight);
+
+  // keep the base of the leader on the straight part of its edge
+  const bool horizontal = m_leaderPosition != LeaderPositionLeft && m_leaderPosition != LeaderPositionRight;
+  const qreal edgeLength = (horizontal ? rect.width() : rect.height()) - 2.0 * radius;
+  const qreal leaderWidth = qBound(0.0, m_leaderWidth, qMax(0.0, edgeLength));
+  const qreal halfLeader = leaderWidth * 0.5;
+  const qreal cornerOffset = qBound(radius, m_cornerOffset, qMax(radius, rect.width() - radius - leaderWidth));
+
+  auto appendLeader = [&outline, &leader](const QPointF& baseStart, const QPointF& tip, const QPointF& baseEnd)
+  {
+    leader = {baseStart, tip, baseEnd};
+    appendPoint(outline, baseStart);
+    outline.append(tip);
+    appendPoint(outline, baseEnd);
+  };
+
+  const qreal left = rect.left();
+  const qreal top = rect.top();
+  const qreal right = rect.right();
+  const qreal bottom = rect.bottom();
+  const QPointF center = rect.center();
+
+  appendPoint(outline, QPointF(left + radius, top));
+
+  // top edge, left to right
+  if (m_leaderPosition == LeaderPositionUpperLeft)
+    appendLeader(QPointF(left + cornerOffset, top), QPointF(left + cornerOffset + halfLeader, top - leaderHeight), QPointF(left + cornerOffset + leaderWidth, top));
+  else if (m_leaderPosition == LeaderPositionTop)
+    appendLeader(QPointF(center.x() - halfLeader, top), QPointF(center.x(), top - leaderHeight), QPointF(center.x() + halfLeader, top));
+  else if (m_leaderPosition == LeaderPositionUpperRight)
+    appendLeader(QPointF(right - cornerOffset - leaderWidth, top), QPointF(right - cornerOffset - halfLeader, top - leaderHeight), QPointF(right - cornerOffset, top));
+
+  appendCorner(outline, QPointF(right - radius, top + radius), radius, -90.0);
+
+  // right edge, top to bottom
+  if (m_leaderPosition == LeaderPositionRight)
+    appendLeader(QPointF(right, center.y() - halfLeader), QPointF(right + leaderHeight, center.y()), QPointF(right, center.y() + halfLeader));
+
+  appendCorner(outline, QPointF(right - radius, bottom - radius), radius, 0.0);
+
+  // bottom edge, right to left
+  if (m_leaderPosition == LeaderPositionLowerRight)
+    appendLeader(QPointF(right - cornerOffset, bottom), QPointF(right - cornerOffset - halfLeader, bottom + leaderHeight), QPointF(right - cornerOffset - leaderWidth, bottom));
+  else if (m_leaderPosition == LeaderPositionBottom)
+    appendLeader(QPointF(center.x() + halfLeader, bottom), QPointF(center.x(), bottom + leaderHeight), QPointF(center.x() - halfLeader, bottom));
+  else if (m_leaderPosition == LeaderPositionLowerLeft)
+    appendLeader(QPointF(left + cornerOffset + leaderWidth, bottom), QPointF(left + cornerOffset + halfLeader, bottom + leaderHeight), QPointF(left + cornerOffset, bottom));
+
+  appendCorner(outline, QPointF(left + radius, bottom - radius), radius, 90.0);
+
+  // left edge, bottom to top
+  if (m_leaderPosition == LeaderPositionLeft)
+    appendLeader(QPointF(left, center.y() + halfLeader), QPointF(left - leaderHeight, center.y()), QPointF(left, center.y() - halfLeader));
+
+  appendCorner(outline, QPointF(left + radius, top + radius), radius, 180.0);
+
+  // the outline is closed, so the start is not repeated
+  if (outline.size() > 1 && outline.last() == outline.first())
+    outline.removeLast();
+}
+
+/*!
+  \internal
+
+  Fills \a geometry with triangles covering the rectangle, as a fan about
+  \a center, and the \a leader.
+ */
+void CalloutItem::fillGeometry(QSGGeometry* geometry, const QVector<QPointF>& outline,
+                               const QVector<QPointF>& leader, const QPointF& center)
+{
+  // the rectangle is convex once the tip of the leader is left out
+  QVector<QPointF> body;
+  body.reserve(outline.size());
+  for (const QPointF& point : outline)
+  {
+    if (leader.size() != 3 || point != leader.at(1))
+      body.append(point);
+  }
+
+  const int bodyCount = body.size() >= 3 ? body.size() : 0;
+  const int leaderCount = leader.size() == 3 && bodyCount > 0 ? 3 : 0;
+  geometry->allocate(bodyCount * 3 + leaderCount);
+
+  QSGGeometry::Point2D* vertices = geometry->vertexDataAsPoint2D();
+  for (int i = 0; i < bodyCount; ++i)
+  {
+    const QPointF& from = body.at(i);
+    const QPointF& to = body.at((i + 1) % bodyCount);
+    (vertices++)->set(center.x(), center.y());
+    (vertices++)->set(from.x(), from.y());
+    (vertices++)->set(to.x(), to.y());
+  }
+
+  for (int i = 0; i < leaderCount; ++i)
+    (vertices++)->set(leader.at(i).x(), leader.at(i).y());
+}
+
+/*!
+  \internal
+
+  Fills \a geometry with a triangle strip of \a width along the closed \a outline.
+ */
+void CalloutItem::strokeGeometry(QSGGeometry* geometry, const QVector<QPointF>& outline, qreal width)
+{
+  const int count = outline.size();
+  if (count < 3 || width <= 0.0)
+  {
+    geometry->allocate(0);
+    return;
+  }
+
+  geometry->allocate((count + 1) * 2);
+  QSGGeometry::Point2D* vertices = geometry->vertexDataAsPoint2D();
+  const qreal halfWidth = width * 0.5;
+
+  for (int i = 0; i <= count; ++i)
+  {
+    const QPointF& point = outline.at(i % count);
+    const QPointF& previous = outline.at((i + count - 1) % count);
+    const QPointF& next = outline.at((i + 1) % count);
+
+    const QPointF incoming = normalized(point - previous);
+    const QPointF outgoing = normalized(next - point);
+    const QPointF incomingNormal(-incoming.y(), incoming.x());
+    const QPointF outgoingNormal(-outgoing.y(), outgoing.x());
+
+    // miter join, limited so the sharp tip of the leader does not spike
+    QPointF miter = normalized(incomingNormal + outgoingNormal);
+    if (miter.isNull())
+      miter = incomingNormal;
+
+    const qreal cosine = QPointF::dotProduct(miter, incomingNormal);
+    miter *= cosine > 1.0 / maximumMiter ? halfWidth / cosine : halfWidth * maximumMiter;
+
+    (vertices++)->set(point.x() + miter.x(), point.y() + miter.y());
+    (vertices++)->set(point.x() - miter.x(), point.y() - miter.y());
+  }
+}
+
+/*!
+  \fn void CalloutItem::anchorPointChanged()
+  \brief Signal emitted when the \l anchorPoint property changes.
+ */
+
+/*!
+  \fn void CalloutItem::leaderPositionChanged()
+  \brief Signal emitted when the \l leaderPosition property changes.
+ */
+
+/*!
+  \fn void CalloutItem::leaderWidthChanged()
+  \brief Signal emitted when the \l leaderWidth property changes.
+ */
+
+/*!
+  \fn void CalloutItem::leaderHeightChanged()
+  \brief Signal emitted when the \l leaderHeight property changes.
+ */
+
+/*!
+  \fn void CalloutItem::cornerRadiusChanged()
+  \brief Signal emitted when the \l cornerRadius property changes.
+ */
+
+/*!
+  \fn void CalloutItem::cornerOffsetChanged()
+  \brief Signal emitted when the \l cornerOffset property changes.
+ */
+
+/*!
+  \fn void CalloutItem::borderWidthChanged()
+  \brief Signal emitted when the \l borderWidth property changes.
+ */
+
+/*!
+  \fn void CalloutItem::borderColorChanged()
+  \brief Signal emitted when the \l borderColor property changes.
+ */
+
+/*!
+  \fn void CalloutItem::backgroundColorChanged()
+  \brief Signal emitted when the \l backgroundColor property changes.
+ */
+
+/*!
+  \fn void CalloutItem::contentRectChanged()
+  \brief Signal emitted when the \l contentRect property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionBatchResults.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionBatchResults
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A table of results from a batch conversion run by the
+  CoordinateConversionController.
+  \since Esri::ArcGISRuntime 100.5
+
+  The table holds one row per converted point and one column per output
+  format. Rows are in the same order as the points or notations passed to
+  \l {CoordinateConversionController::convertPoints}{convertPoints} or
+  \l {CoordinateConversionController::convertNotations}{convertNotations}.
+
+  \sa {Coordinate Conversion Tool}
+ */
+
+/*!
+  \brief Constructs an empty table.
+ */
+CoordinateConversionBatchResults::CoordinateConversionBatchResults()
+{
+}
+
+/*!
+  \internal
+ */
+CoordinateConversionBatchResults::CoordinateConversionBatchResults(const QStringList& formatNames, int pointCount) :
+  m_formatNames(formatNames),
+  m_points(pointCount),
+  m_notations(pointCount * formatNames.size())
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+CoordinateConversionBatchResults::~CoordinateConversionBatchResults()
+{
+}
+
+/*!
+  \property CoordinateConversionBatchResults::pointCount
+  \brief The number of points (rows) in the table.
+ */
+int CoordinateConversionBatchResults::pointCount() const
+{
+  return m_points.size();
+}
+
+/*!
+  \property CoordinateConversionBatchResults::formatCount
+  \brief The number of output formats (columns) in the table.
+ */
+int CoordinateConversionBatchResults::formatCount() const
+{
+  return m_formatNames.size();
+}
+
+/*!
+  \property CoordinateConversionBatchResults::formatNames
+  \brief The names of the output formats, in column order.
+ */
+QStringList CoordinateConversionBatchResults::formatNames() const
+{
+  return m_formatNames;
+}
+
+/*!
+  \brief Returns the input point for row \a pointIndex.
+
+  When the batch was started from notation strings, this is the point parsed
+  from the notation. The point is empty if the notation could not be parsed.
+ */
+Point CoordinateConversionBatchResults::point(int pointIndex) const
+{
+  if (pointIndex < 0 || pointIndex >= m_points.size())
+    return Point();
+
+  return m_points.at(pointIndex);
+}
+
+/*!
+  \brief Returns the notation for the point at \a pointIndex in the
+  format at \a formatIndex.
+ */
+QString CoordinateConversionBatchResults::notation(int pointIndex, int formatIndex) const
+{
+  if (pointIndex < 0 || pointIndex >= pointCount() || formatIndex < 0 || formatIndex >= formatCount())
+    return QString();
+
+  return m_notations.at(pointIndex * formatCount() + formatIndex);
+}
+
+/*!
+  \brief Returns all the notations for the point at \a pointIndex, in the
+  same order as \l formatNames.
+ */
+QStringList CoordinateConversionBatchResults::notations(int pointIndex) const
+{
+  QStringList rowNotations;
+  if (pointIndex < 0 || pointIndex >= pointCount())
+    return rowNotations;
+
+  const int columns = formatCount();
+  rowNotations.reserve(columns);
+  for (int i = 0; i < columns; ++i)
+    rowNotations.append(m_notations.at(pointIndex * columns + i));
+
+  return rowNotations;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionCache.h"
+
+// Qt headers
+#include <QMutexLocker>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionCache
+  \internal
+
+  A bounded, least recently used cache of notations produced by the
+  CoordinateFormatter.
+
+  Entries are keyed on the exact coordinates of the point, its spatial
+  reference, and the settings of the option used to format it. Points are
+  not snapped to a grid, as the notation of two points in the same cell
+  can still differ where the cell straddles a rounding boundary, so only
+  repeated conversions of the same point share an entry.
+
+  The cache may be used from several threads at once.
+ */
+
+/*!
+  \internal
+ */
+CoordinateConversionCache::CoordinateConversionCache(int capacity) :
+  m_capacity(qMax(0, capacity))
+{
+}
+
+/*!
+  \internal
+
+  Returns \a point formatted with \a parameters, reusing an earlier result
+  where possible.
+ */
+QString CoordinateConversionCache::toNotation(const CoordinateConversionParameters& parameters, const Point& point)
+{
+  if (point.isEmpty())
+    return parameters.toNotation(point);
+
+  const Key key = makeKey(parameters, point);
+
+  {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+      ++m_hits;
+      m_entries.splice(m_entries.begin(), m_entries, it.value());
+      return it.value()->second;
+    }
+
+    ++m_misses;
+  }
+
+  // the conversion itself runs without holding the lock
+  const QString notation = parameters.toNotation(point);
+
+  QMutexLocker locker(&m_mutex);
+  if (m_capacity == 0 || m_index.contains(key))
+    return notation;
+
+  m_entries.emplace_front(key, notation);
+  m_index.insert(key, m_entries.begin());
+  trim();
+
+  return notation;
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionCache::capacity() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_capacity;
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionCache::setCapacity(int capacity)
+{
+  QMutexLocker locker(&m_mutex);
+  m_capacity = qMax(0, capacity);
+  trim();
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionCache::hits() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_hits;
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionCache::misses() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_misses;
+}
+
+/*!
+  \internal
+
+  Removes the entries created for the option \a optionId.
+ */
+void CoordinateConversionCache::invalidate(quintptr optionId)
+{
+  QMutexLocker locker(&m_mutex);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->first.m_optionId != optionId)
+    {
+      ++it;
+      continue;
+    }
+
+    m_index.remove(it->first);
+    it = m_entries.erase(it);
+  }
+}
+
+/*!
+  \internal
+
+  Removes all the entries and resets the hit and miss counts.
+ */
+void CoordinateConversionCache::clear()
+{
+  QMutexLocker locker(&m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+/*!
+  \internal
+ */
+CoordinateConversionCache::Key CoordinateConversionCache::makeKey(const CoordinateConversionParameters& parameters,
+                                                                  const Point& point)
+{
+  const SpatialReference spatialReference = point.spatialReference();
+
+  Key key;
+  key.m_x = point.x();
+  key.m_y = point.y();
+  key.m_wkid = spatialReference.wkid();
+
+  // spatial references made from well-known text all have no wkid
+  if (key.m_wkid <= 0)
+    key.m_wkText = spatialReference.wkText();
+  key.m_optionId = parameters.m_optionId;
+  key.m_outputMode = static_cast<int>(parameters.m_outputMode);
+  key.m_latLonFormat = static_cast<int>(parameters.m_latLonFormat);
+  key.m_mgrsConversionMode = static_cast<int>(parameters.m_mgrsConversionMode);
+  key.m_utmConversionMode = static_cast<int>(parameters.m_utmConversionMode);
+  key.m_garsConversionMode = static_cast<int>(parameters.m_garsConversionMode);
+  key.m_precision = parameters.m_precision;
+  key.m_decimalPlaces = parameters.m_decimalPlaces;
+  key.m_addSpaces = parameters.m_addSpaces;
+
+  return key;
+}
+
+/*!
+  \internal
+
+  Removes the least recently used entries until the cache is within its
+  capacity. The mutex must be held.
+ */
+void CoordinateConversionCache::trim()
+{
+  while (static_cast<int>(m_index.size()) > m_capacity)
+  {
+    m_index.remove(m_entries.back().first);
+    m_entries.pop_back();
+  }
+}
+
+/*!
+  \internal
+ */
+bool CoordinateConversionCache::Key::operator==(const Key& other) const
+{
+  return m_x == other.m_x &&
+         m_y == other.m_y &&
+         m_wkid == other.m_wkid &&
+         m_wkText == other.m_wkText &&
+         m_optionId == other.m_optionId &&
+         m_outputMode == other.m_outputMode &&
+         m_latLonFormat == other.m_latLonFormat &&
+         m_mgrsConversionMode == other.m_mgrsConversionMode &&
+         m_utmConversionMode == other.m_utmConversionMode &&
+         m_garsConversionMode == other.m_garsConversionMode &&
+         m_precision == other.m_precision &&
+         m_decimalPlaces == other.m_decimalPlaces &&
+         m_addSpaces == other.m_addSpaces;
+}
+
+/*!
+  \internal
+ */
+uint qHash(const CoordinateConversionCache::Key& key, uint seed)
+{
+  uint hash = ::qHash(key.m_x, seed);
+  hash = hash * 31 + ::qHash(key.m_y, seed);
+  hash = hash * 31 + ::qHash(key.m_wkid, seed);
+  hash = hash * 31 + ::qHash(key.m_wkText, seed);
+  hash = hash * 31 + ::qHash(key.m_optionId, seed);
+  hash = hash * 31 + static_cast<uint>(key.m_outputMode);
+  hash = hash * 31 + static_cast<uint>(key.m_latLonFormat);
+  hash = hash * 31 + static_cast<uint>(key.m_mgrsConversionMode);
+  hash = hash * 31 + static_cast<uint>(key.m_utmConversionMode);
+  hash = hash * 31 + static_cast<uint>(key.m_garsConversionMode);
+  hash = hash * 31 + static_cast<uint>(key.m_precision);
+  hash = hash * 31 + static_cast<uint>(key.m_decimalPlaces);
+  hash = hash * 31 + (key.m_addSpaces ? 1u : 0u);
+  return hash;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
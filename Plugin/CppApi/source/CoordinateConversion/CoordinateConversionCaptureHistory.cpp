@@ -0,0 +1,408 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionCaptureHistory.h"
+
+// toolkit headers
+#include "CoordinateConversionResults.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QDateTime>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QVariantMap>
+
+// STL headers
+#include <utility>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// quotes a CSV field when it holds a delimiter, quote or line break
+QString csvField(const QString& field)
+{
+  if (!field.contains(QLatin1Char(',')) && !field.contains(QLatin1Char('"')) && !field.contains(QLatin1Char('\n')))
+    return field;
+
+  QString quoted = field;
+  quoted.replace(QLatin1Char('"'), QStringLiteral("\"\""));
+  return QLatin1Char('"') + quoted + QLatin1Char('"');
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionCaptureHistory
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief A list model of the last points captured by the
+  CoordinateConversionController, with their notations.
+
+  The captures are kept in a ring buffer of \l capacity slots which is
+  allocated once, so a long session of captures does not grow the memory
+  used: once the buffer is full each capture replaces the oldest, reusing
+  its storage. Format names are stored once for the whole history rather
+  than once per notation.
+
+  The history can be written out with \l exportToFile, which streams one CSV
+  line per capture without building the file in memory.
+
+  The following roles are available:
+  \table
+    \header
+        \li Role
+        \li Type
+        \li Description
+    \row
+        \li captureTime
+        \li QDateTime
+        \li When the point was captured.
+    \row
+        \li x
+        \li double
+        \li The x coordinate of the point.
+    \row
+        \li y
+        \li double
+        \li The y coordinate of the point.
+    \row
+        \li wkid
+        \li int
+        \li The well-known ID of the spatial reference of the point.
+    \row
+        \li notations
+        \li QVariantMap
+        \li The notation of the point in each format, keyed by format name.
+  \endtable
+
+  \sa CoordinateConversionController
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent object.
+ */
+CoordinateConversionCaptureHistory::CoordinateConversionCaptureHistory(QObject* parent) :
+  QAbstractListModel(parent),
+  m_captures(m_capacity)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+CoordinateConversionCaptureHistory::~CoordinateConversionCaptureHistory()
+{
+}
+
+/*!
+  \brief Adds a capture of \a point with its notations in \a results.
+
+  When the history is full, the oldest capture is removed first.
+ */
+void CoordinateConversionCaptureHistory::append(const Point& point, const QList<Result>& results)
+{
+  if (m_capacity == 0)
+    return;
+
+  if (m_count == m_capacity)
+  {
+    beginRemoveRows(QModelIndex(), 0, 0);
+    m_first = (m_first + 1) % m_capacity;
+    --m_count;
+    endRemoveRows();
+  }
+
+  beginInsertRows(QModelIndex(), m_count, m_count);
+
+  // the slot is overwritten in place, so its notation storage is reused
+  Capture& capture = m_captures[(m_first + m_count) % m_capacity];
+  capture.captureTime = QDateTime::currentMSecsSinceEpoch();
+  capture.x = point.x();
+  capture.y = point.y();
+  capture.wkid = point.spatialReference().wkid();
+  capture.notations.resize(results.size());
+  for (int i = 0; i < results.size(); ++i)
+  {
+    capture.notations[i].formatIndex = internFormatName(results.at(i).m_name);
+    capture.notations[i].notation = results.at(i).m_notation;
+  }
+
+  ++m_count;
+  endInsertRows();
+
+  emit countChanged();
+}
+
+/*!
+  \brief Removes all captures.
+
+  The storage of the ring buffer is kept for the next captures.
+ */
+void CoordinateConversionCaptureHistory::clear()
+{
+  if (m_count == 0)
+    return;
+
+  beginResetModel();
+  m_first = 0;
+  m_count = 0;
+  m_formatNames.clear();
+  endResetModel();
+
+  emit countChanged();
+}
+
+/*!
+  \brief Returns the notation of the capture at \a index in the format
+  \a formatName, or an empty string if it has none.
+ */
+QString CoordinateConversionCaptureHistory::notation(int index, const QString& formatName) const
+{
+  if (index < 0 || index >= m_count)
+    return QString();
+
+  const int formatIndex = m_formatNames.indexOf(formatName);
+  if (formatIndex < 0)
+    return QString();
+
+  for (const Notation& notation : captureAt(index).notations)
+  {
+    if (notation.formatIndex == formatIndex)
+      return notation.notation;
+  }
+
+  return QString();
+}
+
+/*!
+  \brief Writes the history to \a filePath as CSV, and returns whether it
+  succeeded.
+
+  The file is only replaced once it has been written completely.
+
+  \sa exportTo
+ */
+bool CoordinateConversionCaptureHistory::exportToFile(const QString& filePath) const
+{
+  QSaveFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    qWarning("Could not open %s to export the capture history", qPrintable(filePath));
+    return false;
+  }
+
+  if (!exportTo(&file))
+    return false;
+
+  return file.commit();
+}
+
+/*!
+  \brief Writes the history to \a device as CSV, oldest capture first, and
+  returns whether it succeeded.
+
+  The header is \c captureTime, \c x, \c y, \c wkid and then one column per
+  format name. Each capture is written as soon as it is formatted.
+ */
+bool CoordinateConversionCaptureHistory::exportTo(QIODevice* device) const
+{
+  if (!device || !device->isWritable())
+    return false;
+
+  QTextStream stream(device);
+  stream.setCodec("UTF-8");
+  stream.setRealNumberPrecision(12);
+
+  stream << "captureTime,x,y,wkid";
+  for (const QString& formatName : m_formatNames)
+    stream << ',' << csvField(formatName);
+  stream << '\n';
+
+  // one row of columns, reused for every capture
+  QVector<const QString*> columns(m_formatNames.size());
+  for (int row = 0; row < m_count; ++row)
+  {
+    const Capture& capture = captureAt(row);
+
+    columns.fill(nullptr);
+    for (const Notation& notation : capture.notations)
+      columns[notation.formatIndex] = &notation.notation;
+
+    stream << QDateTime::fromMSecsSinceEpoch(capture.captureTime, Qt::UTC).toString(Qt::ISODateWithMs)
+           << ',' << capture.x << ',' << capture.y << ',' << capture.wkid;
+    for (const QString* column : qAsConst(columns))
+    {
+      stream << ',';
+      if (column)
+        stream << csvField(*column);
+    }
+    stream << '\n';
+  }
+
+  stream.flush();
+  return stream.status() == QTextStream::Ok;
+}
+
+/*!
+  \property CoordinateConversionCaptureHistory::count
+  \brief The number of captures in the history.
+ */
+int CoordinateConversionCaptureHistory::count() const
+{
+  return m_count;
+}
+
+/*!
+  \property CoordinateConversionCaptureHistory::capacity
+  \brief The most captures kept.
+
+  Reducing the capacity drops the oldest captures. The default is \c 500.
+ */
+int CoordinateConversionCaptureHistory::capacity() const
+{
+  return m_capacity;
+}
+
+void CoordinateConversionCaptureHistory::setCapacity(int capacity)
+{
+  capacity = qMax(0, capacity);
+  if (capacity == m_capacity)
+    return;
+
+  const int dropped = qMax(0, m_count - capacity);
+  if (dropped > 0)
+    beginRemoveRows(QModelIndex(), 0, dropped - 1);
+
+  // the kept captures are moved to the start of a buffer of the new size
+  QVector<Capture> captures(capacity);
+  const int kept = m_count - dropped;
+  for (int row = 0; row < kept; ++row)
+    std::swap(captures[row], m_captures[(m_first + dropped + row) % m_capacity]);
+
+  m_captures.swap(captures);
+  m_first = 0;
+  m_count = kept;
+  m_capacity = capacity;
+
+  if (dropped > 0)
+  {
+    endRemoveRows();
+    emit countChanged();
+  }
+
+  emit capacityChanged();
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionCaptureHistory::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : m_count;
+}
+
+/*!
+  \internal
+ */
+QVariant CoordinateConversionCaptureHistory::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= m_count)
+    return QVariant();
+
+  const Capture& capture = captureAt(index.row());
+  switch (role)
+  {
+  case CaptureTimeRole:
+    return QDateTime::fromMSecsSinceEpoch(capture.captureTime);
+  case XRole:
+    return capture.x;
+  case YRole:
+    return capture.y;
+  case WkidRole:
+    return capture.wkid;
+  case NotationsRole:
+  {
+    QVariantMap notations;
+    for (const Notation& notation : capture.notations)
+      notations.insert(m_formatNames.at(notation.formatIndex), notation.notation);
+
+    return notations;
+  }
+  default:
+    return QVariant();
+  }
+}
+
+/*!
+  \internal
+ */
+QHash<int, QByteArray> CoordinateConversionCaptureHistory::roleNames() const
+{
+  return {
+    {CaptureTimeRole, "captureTime"},
+    {XRole, "x"},
+    {YRole, "y"},
+    {WkidRole, "wkid"},
+    {NotationsRole, "notations"}
+  };
+}
+
+/*!
+  \internal
+ */
+const CoordinateConversionCaptureHistory::Capture& CoordinateConversionCaptureHistory::captureAt(int row) const
+{
+  return m_captures.at((m_first + row) % m_capacity);
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionCaptureHistory::internFormatName(const QString& formatName)
+{
+  const int formatIndex = m_formatNames.indexOf(formatName);
+  if (formatIndex >= 0)
+    return formatIndex;
+
+  m_formatNames.append(formatName);
+  return m_formatNames.size() - 1;
+}
+
+/*!
+  \fn void CoordinateConversionCaptureHistory::countChanged()
+  \brief Signal emitted when the \l count property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionCaptureHistory::capacityChanged()
+  \brief Signal emitted when the \l capacity property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -17,15 +17,21 @@
 #include "CoordinateConversionController.h"
 
 // toolkit headers
+#include "CoordinateConversionCache.h"
+#include "CoordinateConversionCaptureHistory.h"
 #include "CoordinateConversionConstants.h"
+#include "CoordinateConversionKernel.h"
 #include "CoordinateConversionOptions.h"
+#include "CoordinateConversionParameters.h"
 #include "CoordinateConversionResults.h"
+#include "CoordinateConversionRunnable.h"
 #include "CoordinateFormatFactory.h"
+#include "CoordinateFormatRegistry.h"
 #include "ToolManager.h"
 #include "ToolResourceProvider.h"
+#include "ToolkitProfiler.h"
 
 // C++ API headers
-#include "CoordinateFormatter.h"
 #include "GeoView.h"
 #include "GeometryEngine.h"
 #include "MapQuickView.h"
@@ -35,10 +41,13 @@
 // Qt headers
 #include <QClipboard>
 #include <QGuiApplication>
+#include <QThreadPool>
+#include <QTimer>
 
 // STL headers
+#include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <functional>
 #include <cstring>
 
 /*!
@@ -50,12 +59,29 @@
 
   This tool converts a notation text string to the selected output notations formats
   defined in your app. The output formats are selected by the user when running the tool,
-  from a set of possible formats defined in a \l CoordinateFormatFactory.
+  from a set of possible formats defined in a \l CoordinateFormatFactory. Formats
+  registered with the \l CoordinateFormatRegistry are also available.
 
   Each \l CoordinateConversionOptions object specifies a
   coordinate notation and options that apply to that notation (decimal places,
   use of spaces, and so on).
 
+  Large sets of points or notations can be converted in one call with
+  \l convertPoints and \l convertNotations. These batch conversions run on
+  worker threads and report their results through the \l batchCompleted signal.
+  Set \l nativeBatchConversion to format the simpler notations in batches
+  without going through the CoordinateFormatter.
+
+  When the point to convert changes at a high rate (for example, from a
+  location source), set \l asyncConversion to \c true. Conversions then run on
+  a worker thread, a new point supersedes a conversion that is still running,
+  and only the newest results are published. \l maximumPublishRate limits how
+  often the results are updated.
+
+  Setting \l cacheSize keeps recently produced notations so that converting
+  the same location again (for example, when panning back and forth) does not
+  repeat the work. Batch conversions do not use the cache.
+
   \sa {Coordinate Conversion Tool}
  */
 
@@ -67,43 +93,204 @@ namespace Toolkit
 {
 
 /*!
-  \brief A constructor that accepts an optional \a parent.
+  \internal
  */
-CoordinateConversionController::CoordinateConversionController(QObject* parent):
-  AbstractTool(parent),
-  m_coordinateFormats{CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT,
-                      CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT,
-                      CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT,
-                      CoordinateConversionConstants::MGRS_FORMAT,
-                      CoordinateConversionConstants::USNG_FORMAT,
-                      CoordinateConversionConstants::UTM_FORMAT,
-                      CoordinateConversionConstants::GARS_FORMAT}
+class CoordinateConversionBatchJob
 {
-  ToolManager::instance().addTool(this);
+public:
+  void convert(int first, int last);
+
+  int m_batchId = 0;
+  QList<Point> m_points;
+  QStringList m_notations;
+  CoordinateConversionParameters m_inputParameters;
+  QList<CoordinateConversionParameters> m_outputParameters;
+  QVector<std::shared_ptr<const CoordinateConversionKernel>> m_kernels; // one per output format, may be null
+  SpatialReference m_spatialReference;
+  CoordinateConversionBatchResults m_results;
+  Point* m_resultPoints = nullptr;
+  QString* m_resultNotations = nullptr;
+  int m_convertedCount = 0;
+  std::atomic<bool> m_canceled{false};
+};
 
-  auto geoView = ToolResourceProvider::instance()->geoView();
-  if (geoView)
-    setSpatialReference(geoView->spatialReference());
+/*!
+  \internal
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::spatialReferenceChanged, this, [this]()
+  Converts the inputs from \a first up to (but not including) \a last. This is
+  called from worker threads: each call writes to a separate range of rows
+  in the results.
+ */
+void CoordinateConversionBatchJob::convert(int first, int last)
+{
+  const bool fromNotations = !m_notations.isEmpty();
+  const int formatCount = m_outputParameters.size();
+
+  for (int i = first; i < last; ++i)
+  {
+    if (m_canceled)
+      return;
+
+    m_resultPoints[i] = fromNotations ? m_inputParameters.fromNotation(m_notations.at(i), m_spatialReference)
+                                      : m_points.at(i);
+  }
+
+  // formats with a native kernel are produced for all the suitable points at once
+  const bool hasKernels = std::any_of(m_kernels.cbegin(), m_kernels.cend(),
+                                      [](const std::shared_ptr<const CoordinateConversionKernel>& kernel)
   {
-    setSpatialReference(ToolResourceProvider::instance()->spatialReference());
+    return kernel != nullptr;
   });
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
+  if (hasKernels)
+  {
+    QVector<int> rows;
+    QVector<double> longitudes;
+    QVector<double> latitudes;
+    rows.reserve(last - first);
+    longitudes.reserve(last - first);
+    latitudes.reserve(last - first);
+    for (int i = first; i < last; ++i)
+    {
+      const Point& point = m_resultPoints[i];
+      if (!CoordinateConversionKernel::accepts(point))
+        continue;
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::locationChanged, this, &CoordinateConversionController::onLocationChanged);
+      rows.append(i);
+      longitudes.append(point.x());
+      latitudes.append(point.y());
+    }
 
-  connect(ToolResourceProvider::instance(), &ToolResourceProvider::geoViewChanged, this, [this]()
+    QVector<QString> notations(rows.size());
+    for (int format = 0; format < formatCount && !rows.isEmpty(); ++format)
+    {
+      const auto& kernel = m_kernels.at(format);
+      if (!kernel)
+        continue;
+
+      if (m_canceled)
+        return;
+
+      kernel->format(longitudes.constData(), latitudes.constData(), rows.size(), notations.data());
+      for (int k = 0; k < rows.size(); ++k)
+        m_resultNotations[rows.at(k) * formatCount + format] = std::move(notations[k]);
+
+      notations.fill(QString());
+    }
+  }
+
+  // everything else goes through the CoordinateFormatter
+  for (int i = first; i < last; ++i)
   {
-    setGeoViewInternal(Toolkit::ToolResourceProvider::instance()->geoView());
-  });
+    if (m_canceled)
+      return;
+
+    const Point& point = m_resultPoints[i];
+    if (point.isEmpty())
+      continue;
+
+    QString* row = m_resultNotations + (i * formatCount);
+    for (int format = 0; format < formatCount; ++format)
+    {
+      if (row[format].isNull())
+        row[format] = m_outputParameters.at(format).toNotation(point);
+    }
+  }
+}
+
+/*!
+  \internal
+ */
+class CoordinateConversionAsyncJob
+{
+public:
+  void convert();
+
+  Point m_point;
+  bool m_hasInputParameters = false;
+  CoordinateConversionParameters m_inputParameters;
+  QList<CoordinateConversionParameters> m_outputParameters;
+  std::shared_ptr<CoordinateConversionCache> m_cache;
+  QList<Result> m_results;
+  QString m_inputNotation;
+  bool m_capture = false; // converts a click in capture mode
+  bool m_canBeSuperseded = true; // only accessed from the GUI thread
+  std::atomic<bool> m_superseded{false};
+};
+
+/*!
+  \internal
+
+  Converts the point to all of the output formats. This is called from a
+  worker thread and stops early if a newer point arrives in the meantime.
+ */
+void CoordinateConversionAsyncJob::convert()
+{
+  if (m_hasInputParameters)
+    m_inputNotation = m_cache ? m_cache->toNotation(m_inputParameters, m_point) : m_inputParameters.toNotation(m_point);
+
+  m_results.reserve(m_outputParameters.size());
+  for (const auto& parameters : qAsConst(m_outputParameters))
+  {
+    if (m_superseded)
+      return;
+
+    const QString notation = m_cache ? m_cache->toNotation(parameters, m_point) : parameters.toNotation(m_point);
+    m_results.append(Result(parameters.m_name, notation, parameters.m_outputMode));
+  }
+}
+
+namespace
+{
+
+// the number of asynchronous conversions in a row which can be superseded before one is allowed to finish
+constexpr int maxConsecutiveSuperseded = 2;
+
+// asynchronous conversions are started ahead of any queued batch chunks
+constexpr int asyncConversionPriority = 1;
+
+}
+
+/*!
+  \brief A constructor that accepts an optional \a parent.
+ */
+CoordinateConversionController::CoordinateConversionController(QObject* parent):
+  AbstractTool(parent),
+  m_coordinateFormats(CoordinateFormatRegistry::instance().formatNames())
+{
+  ToolManager::instance().addTool(this);
 
   connect(this, &CoordinateConversionController::optionsChanged, this,
           [this]()
   {
+    m_publishedNotationValid = false;
     convertPoint();
   });
+
+  initializeUnlessDeferred();
+}
+
+/*!
+  \internal
+
+  Follows the resource provider, and the view passed to \l setGeoView before
+  the tool was initialized.
+ */
+void CoordinateConversionController::initializeTool()
+{
+  auto geoView = resourceProvider()->geoView();
+  if (geoView)
+    setSpatialReference(geoView->spatialReference());
+
+  connectResourceProvider();
+  connect(this, &AbstractTool::resourceProviderChanged, this, &CoordinateConversionController::connectResourceProvider);
+
+  if (m_pendingGeoView)
+  {
+    QObject* pendingGeoView = m_pendingGeoView;
+    m_pendingGeoView = nullptr;
+    setGeoView(pendingGeoView);
+  }
 }
 
 /*!
@@ -111,6 +298,20 @@ CoordinateConversionController::CoordinateConversionController(QObject* parent):
  */
 CoordinateConversionController::~CoordinateConversionController()
 {
+  for (const auto& job : qAsConst(m_batchJobs))
+    job->m_canceled = true;
+
+  m_batchJobs.clear();
+
+  if (m_asyncJob)
+    m_asyncJob->m_superseded = true;
+
+  // the worker threads post back to this object so they must finish first
+  if (m_threadPool)
+  {
+    m_threadPool->clear();
+    m_threadPool->waitForDone();
+  }
 }
 
 /*!
@@ -131,72 +332,224 @@ void CoordinateConversionController::convertNotation(const QString& notation)
 }
 
 /*!
-  \internal
+  \brief Converts each of the \a notations and reports the results through the
+  \l batchCompleted signal.
+
+  The notations are parsed using the current \l inputFormat and
+  spatial reference, then converted to all of the other formats. The work is
+  spread across worker threads so the UI remains responsive while large numbers
+  of notations are converted.
+
+  Returns an id for the batch which is passed to the \l batchProgressChanged and
+  \l batchCompleted signals, or \c -1 if there is no input format.
+
+  \sa convertPoints, cancelBatch
  */
-Point CoordinateConversionController::pointFromNotation(const QString& incomingNotation)
+int CoordinateConversionController::convertNotations(const QStringList& notations)
 {
   if (m_spatialReference.isEmpty())
     qWarning("The spatial reference property is empty: conversions will fail.");
 
-  CoordinateConversionOptions* inputOption = nullptr;
+  auto job = std::make_shared<CoordinateConversionBatchJob>();
+  bool hasInputFormat = false;
   for (CoordinateConversionOptions* option : m_options)
   {
     if (isInputFormat(option))
     {
-      inputOption = option;
-      break;
+      job->m_inputParameters = optionParameters(option);
+      hasInputFormat = true;
+      continue;
     }
-  }
 
-  if (inputOption == nullptr)
-    return Point();
-
-  switch (inputOption->outputMode())
-  {
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
-  {
-    return CoordinateFormatter::fromGars(incomingNotation,
-                                         m_spatialReference,
-                                         inputOption->garsConvesrionMode());
+    job->m_outputParameters.append(optionParameters(option));
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+
+  if (!hasInputFormat)
   {
-    return CoordinateFormatter::fromGeoRef(incomingNotation,
-                                           m_spatialReference);
+    qWarning("The input format is not set: notations cannot be converted.");
+    return -1;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+
+  job->m_notations = notations;
+  job->m_spatialReference = m_spatialReference;
+
+  return startBatch(std::move(job), notations.size());
+}
+
+/*!
+  \brief Converts each of the \a points and reports the results through the
+  \l batchCompleted signal.
+
+  Each point is converted to all the formats other than the \l inputFormat,
+  as with \l convertPoint. The work is spread across worker threads so the UI
+  remains responsive while large numbers of points are converted.
+
+  Returns an id for the batch which is passed to the \l batchProgressChanged and
+  \l batchCompleted signals.
+
+  \sa convertNotations, cancelBatch
+ */
+int CoordinateConversionController::convertPoints(const QList<Point>& points)
+{
+  auto job = std::make_shared<CoordinateConversionBatchJob>();
+  for (CoordinateConversionOptions* option : m_options)
   {
-    return CoordinateFormatter::fromLatitudeLongitude(incomingNotation,
-                                                      m_spatialReference);
+    if (isInputFormat(option))
+      continue;
+
+    job->m_outputParameters.append(optionParameters(option));
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+
+  job->m_points = points;
+
+  return startBatch(std::move(job), points.size());
+}
+
+/*!
+  \brief Stops the batch conversion \a batchId.
+
+  No further signals are emitted for the batch.
+ */
+void CoordinateConversionController::cancelBatch(int batchId)
+{
+  auto it = m_batchJobs.find(batchId);
+  if (it == m_batchJobs.end())
+    return;
+
+  it.value()->m_canceled = true;
+  m_batchJobs.erase(it);
+}
+
+/*!
+  \internal
+ */
+QThreadPool* CoordinateConversionController::threadPool()
+{
+  if (!m_threadPool)
+    m_threadPool = new QThreadPool(this);
+
+  return m_threadPool;
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionController::startBatch(std::shared_ptr<CoordinateConversionBatchJob> job, int pointCount)
+{
+  QStringList formatNames;
+  formatNames.reserve(job->m_outputParameters.size());
+  for (const auto& parameters : qAsConst(job->m_outputParameters))
+    formatNames.append(parameters.m_name);
+
+  // the table is allocated up front so the worker threads only write into it
+  job->m_batchId = m_nextBatchId++;
+  job->m_results = CoordinateConversionBatchResults(formatNames, pointCount);
+
+  if (m_nativeBatchConversion)
   {
-    return CoordinateFormatter::fromMgrs(incomingNotation,
-                                         m_spatialReference,
-                                         inputOption->mgrsConversionMode());
+    job->m_kernels.reserve(job->m_outputParameters.size());
+    for (const auto& parameters : qAsConst(job->m_outputParameters))
+      job->m_kernels.append(CoordinateConversionKernel::create(parameters));
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+
+  job->m_resultPoints = job->m_results.m_points.data();
+  job->m_resultNotations = job->m_results.m_notations.data();
+
+  m_batchJobs.insert(job->m_batchId, job);
+
+  if (pointCount == 0)
   {
-    return CoordinateFormatter::fromUsng(incomingNotation,
-                                         m_spatialReference);
+    QMetaObject::invokeMethod(this, "onBatchChunkCompleted", Qt::QueuedConnection,
+                              Q_ARG(int, job->m_batchId), Q_ARG(int, 0));
+    return job->m_batchId;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+
+  // use several chunks per thread so the progress updates are reasonably smooth
+  constexpr int chunksPerThread = 4;
+  constexpr int maxChunkSize = 1024;
+  const int chunkCount = qMax(1, threadPool()->maxThreadCount()) * chunksPerThread;
+  const int chunkSize = qBound(1, (pointCount + chunkCount - 1) / chunkCount, maxChunkSize);
+
+  for (int first = 0; first < pointCount; first += chunkSize)
   {
-    return CoordinateFormatter::fromUtm(incomingNotation,
-                                        m_spatialReference,
-                                        inputOption->utmConversionMode());
-  }
-  default: {}
+    const int last = qMin(first + chunkSize, pointCount);
+    threadPool()->start(new CoordinateConversionRunnable([this, job, first, last]()
+    {
+      job->convert(first, last);
+
+      if (job->m_canceled)
+        return;
+
+      QMetaObject::invokeMethod(this, "onBatchChunkCompleted", Qt::QueuedConnection,
+                                Q_ARG(int, job->m_batchId), Q_ARG(int, last - first));
+    }));
   }
 
-  return Point();
+  return job->m_batchId;
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::onBatchChunkCompleted(int batchId, int convertedCount)
+{
+  auto it = m_batchJobs.find(batchId);
+  if (it == m_batchJobs.end())
+    return;
+
+  const auto job = it.value();
+  job->m_convertedCount += convertedCount;
+
+  const int totalCount = job->m_results.pointCount();
+  emit batchProgressChanged(batchId, job->m_convertedCount, totalCount);
+
+  if (job->m_convertedCount < totalCount)
+    return;
+
+  m_batchJobs.erase(it);
+  emit batchCompleted(batchId, job->m_results);
+}
+
+/*!
+  \internal
+ */
+Point CoordinateConversionController::pointFromNotation(const QString& incomingNotation)
+{
+  if (m_spatialReference.isEmpty())
+    qWarning("The spatial reference property is empty: conversions will fail.");
+
+  if (m_inputOption == nullptr)
+    return Point();
+
+  return optionParameters(m_inputOption).fromNotation(incomingNotation, m_spatialReference);
 }
 
 /*!
   \brief Converts the last point assigned with \l setPointToConvert to all the
   notations specified in the options.
+
+  When \l asyncConversion is \c true, the conversion is run on a worker thread
+  and the \l results are updated when it completes.
  */
 void CoordinateConversionController::convertPoint()
+{
+  if (m_asyncConversion)
+  {
+    requestAsyncConversion();
+    return;
+  }
+
+  TOOLKIT_PROFILE_SCOPE("CoordinateConversionController::convertPoint");
+
+  publishResults(convertPointResults(m_pointToConvert));
+}
+
+/*!
+  \internal
+
+  Converts \a point to every output format on the calling thread.
+ */
+QList<Result> CoordinateConversionController::convertPointResults(const Point& point) const
 {
   QList<Result> results;
   for (CoordinateConversionOptions* option : m_options)
@@ -204,56 +557,230 @@ void CoordinateConversionController::convertPoint()
     if (isInputFormat(option))
       continue;
 
-    results.append(Result(option->name(), convertPointInternal(option, m_pointToConvert), option->outputMode()));
+    TOOLKIT_PROFILE_SCOPE_DYNAMIC(QStringLiteral("CoordinateConversionController::convertPoint/") + option->name());
+    results.append(Result(option->name(), convertPointInternal(option, point), option->outputMode()));
   }
 
+  return results;
+}
+
+/*!
+  \internal
+
+  The results model only signals \l resultsChanged when the results differ
+  from those already published.
+ */
+void CoordinateConversionController::publishResults(QList<Result>&& results)
+{
   if (results.isEmpty())
     resultsInternal()->clearResults();
   else
     resultsInternal()->setResults(std::move(results));
 
-  emit resultsChanged();
+  if (m_cache)
+    emit cacheStatisticsChanged();
 }
 
 /*!
   \internal
+
+  Starts an asynchronous conversion of the current point. If a conversion is
+  already running it is superseded and the new conversion starts as soon as it
+  stops.
  */
-QString CoordinateConversionController::convertPointInternal(CoordinateConversionOptions* option,
-                                                             const Point& point) const
+void CoordinateConversionController::requestAsyncConversion()
+{
+  if (m_asyncJob)
+  {
+    m_asyncConversionPending = true;
+    if (m_asyncJob->m_canBeSuperseded)
+      m_asyncJob->m_superseded = true;
+
+    return;
+  }
+
+  startAsyncConversion();
+}
+
+/*!
+  \internal
+
+  Clicks in capture mode are converted first, one job each and in the order
+  they were made, so that none of them is superseded.
+ */
+void CoordinateConversionController::startAsyncConversion()
 {
-  switch (option->outputMode())
+  auto job = std::make_shared<CoordinateConversionAsyncJob>();
+  if (m_pendingCaptures.isEmpty())
   {
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
+    job->m_point = m_pointToConvert;
+  }
+  else
   {
-    return CoordinateFormatter::toGars(point);
+    job->m_point = m_pendingCaptures.takeFirst();
+    job->m_capture = true;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+
+  if (job->m_point == m_pointToConvert)
+    m_asyncConversionPending = false;
+
+  // the options are copied here as they can only be read from the GUI thread
+  job->m_cache = m_cache;
+  for (CoordinateConversionOptions* option : m_options)
+  {
+    if (isInputFormat(option))
+    {
+      job->m_inputParameters = optionParameters(option);
+      job->m_hasInputParameters = true;
+      continue;
+    }
+
+    job->m_outputParameters.append(optionParameters(option));
+  }
+
+  // a continuous stream of points must not prevent the results from ever being updated
+  job->m_canBeSuperseded = !job->m_capture && m_supersededCount < maxConsecutiveSuperseded;
+  m_asyncJob = job;
+
+  threadPool()->start(new CoordinateConversionRunnable([this, job]()
+  {
+    job->convert();
+    QMetaObject::invokeMethod(this, "onAsyncConversionCompleted", Qt::QueuedConnection);
+  }), asyncConversionPriority);
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::onAsyncConversionCompleted()
+{
+  if (!m_asyncJob)
+    return;
+
+  const auto job = std::move(m_asyncJob);
+
+  if (!m_asyncConversion)
+    return;
+
+  if (job->m_superseded)
   {
-    return CoordinateFormatter::toGeoRef(point, option->precision());
+    ++m_supersededCount;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+  else
   {
-    const auto format = static_cast<Esri::ArcGISRuntime::LatitudeLongitudeFormat>(option->latLonFormat());
-    return CoordinateFormatter::toLatitudeLongitude(point, format, option->decimalPlaces());
+    m_supersededCount = 0;
+
+    // the capture is recorded now, as held results can be replaced before they are published
+    if (job->m_capture)
+      captureHistoryInternal()->append(job->m_point, job->m_results);
+
+    // a click which has since been followed by another one only goes to the capture history
+    if (!job->m_capture || job->m_point == m_pointToConvert)
+      queueAsyncPublish(job);
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+
+  if (m_asyncConversionPending || !m_pendingCaptures.isEmpty())
+    startAsyncConversion();
+}
+
+/*!
+  \internal
+
+  Publishes the results of \a job now, or holds them back until the
+  \l maximumPublishRate allows. Held results are replaced by newer ones.
+ */
+void CoordinateConversionController::queueAsyncPublish(std::shared_ptr<CoordinateConversionAsyncJob> job)
+{
+  if (m_maximumPublishRate <= 0.0 || !m_lastPublish.isValid())
   {
-    const auto conversionMode = static_cast<Esri::ArcGISRuntime::MgrsConversionMode>(option->mgrsConversionMode());
-    return CoordinateFormatter::toMgrs(point, conversionMode, option->decimalPlaces(), option->addSpaces());
+    publishAsyncConversion(std::move(job));
+    return;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+
+  const qint64 minimumInterval = static_cast<qint64>(std::ceil(1000.0 / m_maximumPublishRate));
+  const qint64 elapsed = m_lastPublish.elapsed();
+  if (elapsed >= minimumInterval)
   {
-    return CoordinateFormatter::toUsng(point, option->precision(), option->decimalPlaces());
+    publishAsyncConversion(std::move(job));
+    return;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+
+  m_readyAsyncJob = std::move(job);
+
+  if (!m_publishTimer)
   {
-    const auto conversionMode = static_cast<Esri::ArcGISRuntime::UtmConversionMode>(option->utmConversionMode());
-    return CoordinateFormatter::toUtm(point, conversionMode, option->addSpaces());
+    m_publishTimer = new QTimer(this);
+    m_publishTimer->setSingleShot(true);
+    connect(m_publishTimer, &QTimer::timeout, this, &CoordinateConversionController::onPublishTimeout);
   }
-  default: {}
+
+  if (!m_publishTimer->isActive())
+    m_publishTimer->start(static_cast<int>(minimumInterval - elapsed));
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::onPublishTimeout()
+{
+  if (!m_readyAsyncJob)
+    return;
+
+  auto job = std::move(m_readyAsyncJob);
+  publishAsyncConversion(std::move(job));
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::publishAsyncConversion(std::shared_ptr<CoordinateConversionAsyncJob> job)
+{
+  m_lastPublish.start();
+
+  m_publishedNotation = job->m_inputNotation;
+  m_publishedNotationValid = true;
+
+  publishResults(std::move(job->m_results));
+  emit pointToConvertChanged();
+}
+
+/*!
+  \internal
+ */
+QString CoordinateConversionController::convertPointInternal(CoordinateConversionOptions* option,
+                                                             const Point& point) const
+{
+  if (option == nullptr)
+    return QString();
+
+  const CoordinateConversionParameters& parameters = optionParameters(option);
+  return m_cache ? m_cache->toNotation(parameters, point) : parameters.toNotation(point);
+}
+
+/*!
+  \internal
+
+  Returns the parameters of \a option, copying them from the option the
+  first time they are needed after it, or the format registry, changes.
+ */
+const CoordinateConversionParameters& CoordinateConversionController::optionParameters(CoordinateConversionOptions* option) const
+{
+  // registering a format can replace the functions the parameters and notations were made with
+  const int revision = CoordinateFormatRegistry::instance().revision();
+  if (revision != m_optionParametersRevision)
+  {
+    m_optionParameters.clear();
+    if (m_cache)
+      m_cache->clear();
+
+    m_optionParametersRevision = revision;
   }
 
-  return QString();
+  auto it = m_optionParameters.find(option);
+  if (it == m_optionParameters.end())
+    it = m_optionParameters.insert(option, CoordinateConversionParameters(option));
+
+  return it.value();
 }
 
 /*!
@@ -261,18 +788,57 @@ QString CoordinateConversionController::convertPointInternal(CoordinateConversio
  */
 bool CoordinateConversionController::isInputFormat(CoordinateConversionOptions* option) const
 {
-  return isFormat(option, m_inputFormat);
+  // an unknown name can only gain an id when a format is registered
+  if (m_inputFormatId == CoordinateFormatRegistry::InvalidFormatId && !m_inputFormat.isEmpty())
+  {
+    const CoordinateFormatRegistry& registry = CoordinateFormatRegistry::instance();
+    const int revision = registry.revision();
+    if (revision != m_inputFormatRevision)
+    {
+      m_inputFormatRevision = revision;
+      m_inputFormatId = registry.formatId(m_inputFormat);
+    }
+  }
+
+  return isFormat(option, m_inputFormatId, m_inputFormat);
 }
 
 /*!
   \internal
+
+  Returns whether \a option is the format \a formatId named \a formatName.
+  Names which are not known to the registry have no id and are compared
+  directly.
  */
-bool CoordinateConversionController::isFormat(CoordinateConversionOptions* option, const QString& formatName) const
+bool CoordinateConversionController::isFormat(CoordinateConversionOptions* option, int formatId, const QString& formatName) const
 {
   if (option == nullptr)
     return false;
 
-  return option->name().compare(formatName, Qt::CaseInsensitive) == 0;
+  const int optionFormatId = option->formatId();
+  if (formatId != CoordinateFormatRegistry::InvalidFormatId || optionFormatId != CoordinateFormatRegistry::InvalidFormatId)
+    return optionFormatId == formatId;
+
+  return !formatName.isEmpty() && option->name().compare(formatName, Qt::CaseInsensitive) == 0;
+}
+
+/*!
+  \internal
+
+  Finds the option for the input format. It is looked up again whenever the
+  options or the input format change, rather than on each conversion.
+ */
+void CoordinateConversionController::updateInputOption()
+{
+  m_inputOption = nullptr;
+  for (CoordinateConversionOptions* option : m_options)
+  {
+    if (isInputFormat(option))
+    {
+      m_inputOption = option;
+      return;
+    }
+  }
 }
 
 void CoordinateConversionController::setGeoView(QObject* geoView)
@@ -280,67 +846,177 @@ void CoordinateConversionController::setGeoView(QObject* geoView)
   if (!geoView)
     return;
 
+  // the view is followed once the tool is first shown or activated
+  if (!isInitialized())
+  {
+    m_pendingGeoView = geoView;
+    return;
+  }
+
+  // the view's own context forwards its mouse events, and only its events
   if (std::strcmp(geoView->metaObject()->className(), MapQuickView::staticMetaObject.className()) == 0)
   {
-    m_mapView = reinterpret_cast<MapQuickView*>(geoView);
-    m_sceneView = nullptr;
-    if (m_mapView)
+    auto mapView = reinterpret_cast<MapQuickView*>(geoView);
+    if (mapView)
     {
-      setSpatialReference(m_mapView->spatialReference());
-      connect(m_mapView, &MapQuickView::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
+      setResourceProvider(ToolResourceProvider::forGeoView(mapView));
+      setGeoViewInternal(mapView);
     }
   }
   else if (std::strcmp(geoView->metaObject()->className(), SceneQuickView::staticMetaObject.className()) == 0)
   {
-    m_sceneView = reinterpret_cast<SceneQuickView*>(geoView);
-    m_mapView = nullptr;
-    if (m_sceneView)
+    auto sceneView = reinterpret_cast<SceneQuickView*>(geoView);
+    if (sceneView)
     {
-      setSpatialReference(m_sceneView->spatialReference());
-      connect(m_sceneView, &SceneQuickView::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
+      setResourceProvider(ToolResourceProvider::forGeoView(sceneView));
+      setGeoViewInternal(sceneView);
     }
   }
+}
+
+/*!
+  \property CoordinateConversionController::results
+  \brief The conversion results as a list model.
+
+  The results are automatically updated as conversions are run.
+
+  \sa CoordinateConversionResults
+ */
+QAbstractListModel* CoordinateConversionController::results()
+{
+  return resultsInternal();
+}
+
+/*!
+  \internal
+ */
+CoordinateConversionResults* CoordinateConversionController::resultsInternal()
+{
+  if (!m_results)
+  {
+    m_results = new CoordinateConversionResults(this);
+    connect(m_results, &CoordinateConversionResults::resultsChanged, this, &CoordinateConversionController::resultsChanged);
+  }
+
+  return m_results;
+}
+
+/*!
+  \property CoordinateConversionController::captureHistory
+  \brief The points captured by clicks in \l captureMode, with their
+  notations, as a list model.
+
+  The history keeps the most recent captures up to its capacity and can be
+  exported as CSV.
+
+  \sa CoordinateConversionCaptureHistory
+ */
+QAbstractListModel* CoordinateConversionController::captureHistory()
+{
+  return captureHistoryInternal();
+}
+
+/*!
+  \internal
+ */
+CoordinateConversionCaptureHistory* CoordinateConversionController::captureHistoryInternal()
+{
+  if (!m_captureHistory)
+    m_captureHistory = new CoordinateConversionCaptureHistory(this);
+
+  return m_captureHistory;
+}
+
+bool CoordinateConversionController::setGeoViewInternal(GeoView* geoView)
+{
+  if (geoView == nullptr)
+    return false;
+
+  setSpatialReference(geoView->spatialReference());
+
+  m_sceneView = dynamic_cast<SceneQuickView*>(geoView);
+  m_mapView = dynamic_cast<MapQuickView*>(geoView);
+  connectViewChanges();
+
+  return m_sceneView != nullptr || m_mapView != nullptr;
+}
+
+/*!
+  \internal
+
+  Follows the view and spatial reference of the current \l {AbstractTool::resourceProvider}{resourceProvider}.
+ */
+void CoordinateConversionController::connectResourceProvider()
+{
+  for (const auto& connection : qAsConst(m_resourceConnections))
+    disconnect(connection);
+  m_resourceConnections.clear();
+
+  ToolResourceProvider* provider = resourceProvider();
 
+  m_resourceConnections.append(connect(provider, &ToolResourceProvider::spatialReferenceChanged, this, [this, provider]()
+  {
+    setSpatialReference(provider->spatialReference());
+  }));
+
+  m_resourceConnections.append(connect(provider, &ToolResourceProvider::geoViewChanged, this, [this, provider]()
+  {
+    setGeoViewInternal(provider->geoView());
+  }));
 }
 
 /*!
-  \property CoordinateConversionController::results
-  \brief The conversion results as a list model.
-
-  The results are automatically updated as conversions are run.
+  \internal
 
-  \sa CoordinateConversionResults
+  Connects the pointer and location events of \a resourceProvider while the tool is active.
  */
-QAbstractListModel* CoordinateConversionController::results()
+QList<QMetaObject::Connection> CoordinateConversionController::connectEventStreams(ToolResourceProvider* resourceProvider)
 {
-  return resultsInternal();
+  QList<QMetaObject::Connection> connections;
+  connections.append(connect(resourceProvider, &ToolResourceProvider::mouseClicked, this, &CoordinateConversionController::onMouseClicked));
+  connections.append(connect(resourceProvider, &ToolResourceProvider::mouseMoved, this, &CoordinateConversionController::onMouseMoved));
+  connections.append(connect(resourceProvider, &ToolResourceProvider::locationChanged, this, &CoordinateConversionController::onLocationChanged));
+
+  return connections;
 }
 
 /*!
   \internal
+
+  Tracks changes to the current view which invalidate the cached view boundary.
  */
-CoordinateConversionResults* CoordinateConversionController::resultsInternal()
+void CoordinateConversionController::connectViewChanges()
 {
-  if (!m_results)
+  for (const auto& connection : qAsConst(m_viewConnections))
+    disconnect(connection);
+
+  m_viewConnections.clear();
+  invalidateViewBoundary();
+
+  if (m_sceneView)
   {
-    m_results = new CoordinateConversionResults(this);
-    connect(m_results, &CoordinateConversionResults::resultsChanged, this, &CoordinateConversionController::resultsChanged);
+    m_viewConnections.append(connect(m_sceneView, &SceneQuickView::viewpointChanged, this, &CoordinateConversionController::invalidateViewBoundary));
+    m_viewConnections.append(connect(m_sceneView, &SceneQuickView::widthChanged, this, &CoordinateConversionController::invalidateViewBoundary));
+    m_viewConnections.append(connect(m_sceneView, &SceneQuickView::heightChanged, this, &CoordinateConversionController::invalidateViewBoundary));
+  }
+  else if (m_mapView)
+  {
+    m_viewConnections.append(connect(m_mapView, &MapQuickView::viewpointChanged, this, &CoordinateConversionController::invalidateViewBoundary));
+    m_viewConnections.append(connect(m_mapView, &MapQuickView::widthChanged, this, &CoordinateConversionController::invalidateViewBoundary));
+    m_viewConnections.append(connect(m_mapView, &MapQuickView::heightChanged, this, &CoordinateConversionController::invalidateViewBoundary));
   }
-
-  return m_results;
 }
 
-bool CoordinateConversionController::setGeoViewInternal(GeoView* geoView)
+/*!
+  \internal
+ */
+void CoordinateConversionController::invalidateViewBoundary()
 {
-  if (geoView == nullptr)
-    return false;
-
-  setSpatialReference(geoView->spatialReference());
-
-  m_sceneView = dynamic_cast<SceneQuickView*>(geoView);
-  m_mapView = dynamic_cast<MapQuickView*>(geoView);
-
-  return m_sceneView != nullptr || m_mapView != nullptr;
+  m_viewBoundaryValid = false;
+  m_viewBoundary = Polyline();
+  m_viewBoundarySpatialReference = SpatialReference();
+  m_projectedSource = Point();
+  m_projectedPoint = Point();
 }
 
 /*!
@@ -366,7 +1042,9 @@ void CoordinateConversionController::setPointToConvert(const Point& point)
   if (m_runConversion)
     convertPoint();
 
-  emit pointToConvertChanged();
+  // asynchronous conversions report the new point when their results are published
+  if (!m_runConversion || !m_asyncConversion)
+    emit pointToConvertChanged();
 }
 
 /*!
@@ -405,17 +1083,38 @@ void CoordinateConversionController::setCaptureMode(bool captureMode)
   \brief Handles the mouse click at \a mouseEvent .
 
   If the tool is active and is in \l captureMode, the clicked location will be used
-  as the input for conversions.
+  as the input for conversions, and is added to the \l captureHistory.
  */
 void CoordinateConversionController::onMouseClicked(QMouseEvent& mouseEvent )
 {
   if (!isActive() || !isCaptureMode())
     return;
 
+  Point point;
   if (m_sceneView)
-    setPointToConvert(m_sceneView->screenToBaseSurface(mouseEvent .pos().x(), mouseEvent .pos().y()));
+    point = m_sceneView->screenToBaseSurface(mouseEvent .pos().x(), mouseEvent .pos().y());
   else if (m_mapView)
-    setPointToConvert(m_mapView->screenToLocation(mouseEvent .pos().x(), mouseEvent .pos().y()));
+    point = m_mapView->screenToLocation(mouseEvent .pos().x(), mouseEvent .pos().y());
+  else
+    return;
+
+  // an asynchronous conversion records the capture when it completes; a click
+  // on the same point also waits if the current results are not its own yet
+  const bool pointChanged = !(point == m_pointToConvert);
+  const bool conversionOutstanding = m_asyncJob || m_readyAsyncJob || m_asyncConversionPending || !m_pendingCaptures.isEmpty();
+  if (m_runConversion && m_asyncConversion && (pointChanged || conversionOutstanding))
+  {
+    m_pendingCaptures.append(point);
+    if (pointChanged)
+      setPointToConvert(point);
+    else
+      requestAsyncConversion();
+
+    return;
+  }
+
+  setPointToConvert(point);
+  captureHistoryInternal()->append(point, m_runConversion ? resultsInternal()->m_results : QList<Result>());
 }
 
 /*!
@@ -427,10 +1126,106 @@ void CoordinateConversionController::onMouseClicked(QMouseEvent& mouseEvent )
  */
 void CoordinateConversionController::onLocationChanged(const Point& location)
 {
-  if (isActive() && !isCaptureMode())
+  if (isActive() && !isCaptureMode() && !isHoverMode())
     setPointToConvert(location);
 }
 
+/*!
+  \fn void CoordinateConversionController::onMouseMoved(QMouseEvent& mouseEvent);
+  \brief Handles the mouse move at \a mouseEvent.
+  \since Esri::ArcGISRuntime 100.5
+
+  If the tool is active and is in \l hoverMode, the cursor location will be
+  used as the input for conversions. Moves are coalesced so that at most one
+  conversion is run per \l hoverInterval, using the latest cursor position.
+ */
+void CoordinateConversionController::onMouseMoved(QMouseEvent& mouseEvent)
+{
+  if (!isActive() || !isHoverMode())
+    return;
+
+  // only the latest position is kept, earlier moves are dropped
+  m_hoverPosition = mouseEvent.localPos();
+
+  if (!m_hoverTimer)
+  {
+    m_hoverTimer = new QTimer(this);
+    m_hoverTimer->setSingleShot(true);
+    connect(m_hoverTimer, &QTimer::timeout, this, &CoordinateConversionController::onHoverTimeout);
+  }
+
+  if (!m_hoverTimer->isActive())
+    m_hoverTimer->start(m_hoverInterval);
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::onHoverTimeout()
+{
+  if (!isActive() || !isHoverMode())
+    return;
+
+  if (m_sceneView)
+    setPointToConvert(m_sceneView->screenToBaseSurface(m_hoverPosition.x(), m_hoverPosition.y()));
+  else if (m_mapView)
+    setPointToConvert(m_mapView->screenToLocation(m_hoverPosition.x(), m_hoverPosition.y()));
+}
+
+/*!
+  \property CoordinateConversionController::hoverMode
+  \brief Whether the tool converts the location under the mouse cursor as it moves.
+  \since Esri::ArcGISRuntime 100.5
+
+  While \c true, the app's current location is not used as the target point.
+  Clicks still set the target point when \l captureMode is also \c true.
+
+  The default is \c false.
+
+  \sa hoverInterval
+ */
+bool CoordinateConversionController::isHoverMode() const
+{
+  return m_hoverMode;
+}
+
+void CoordinateConversionController::setHoverMode(bool hoverMode)
+{
+  if (hoverMode == m_hoverMode)
+    return;
+
+  m_hoverMode = hoverMode;
+
+  if (!m_hoverMode && m_hoverTimer)
+    m_hoverTimer->stop();
+
+  emit hoverModeChanged();
+}
+
+/*!
+  \property CoordinateConversionController::hoverInterval
+  \brief The minimum time, in milliseconds, between conversions in \l hoverMode.
+  \since Esri::ArcGISRuntime 100.5
+
+  The default of \c 16 allows about one conversion per frame at 60 frames per
+  second. A value of \c 0 coalesces the moves delivered in a single pass of
+  the event loop.
+ */
+int CoordinateConversionController::hoverInterval() const
+{
+  return m_hoverInterval;
+}
+
+void CoordinateConversionController::setHoverInterval(int hoverInterval)
+{
+  hoverInterval = qMax(0, hoverInterval);
+  if (hoverInterval == m_hoverInterval)
+    return;
+
+  m_hoverInterval = hoverInterval;
+  emit hoverIntervalChanged();
+}
+
 /*!
   \brief Returns the input coordinate format of the tool.
  */
@@ -448,6 +1243,10 @@ void CoordinateConversionController::setInputFormat(const QString& inputFormat)
     return;
 
   m_inputFormat = inputFormat;
+  m_inputFormatRevision = CoordinateFormatRegistry::instance().revision();
+  m_inputFormatId = CoordinateFormatRegistry::instance().formatId(m_inputFormat);
+  updateInputOption();
+  m_publishedNotationValid = false;
 
   addCoordinateFormat(m_inputFormat);
 
@@ -472,6 +1271,29 @@ QStringList CoordinateConversionController::coordinateFormats() const
 void CoordinateConversionController::addOption(CoordinateConversionOptions* option)
 {
   m_options.append(option);
+
+  // cached parameters and notations for the option no longer apply once it is edited
+  const auto invalidateCache = [this, option]()
+  {
+    m_optionParameters.remove(option);
+    if (m_cache)
+      m_cache->invalidate(reinterpret_cast<quintptr>(option));
+  };
+
+  connect(option, &CoordinateConversionOptions::nameChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::nameChanged, this, &CoordinateConversionController::updateInputOption);
+  connect(option, &CoordinateConversionOptions::outputModeChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::addSpacesChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::precisionChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::decimalPlacesChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::mgrsConversionModeChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::latLonFormatChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::utmConversionModeChanged, this, invalidateCache);
+  connect(option, &CoordinateConversionOptions::garsConversionModeChanged, this, invalidateCache);
+
+  if (!m_inputOption && isInputFormat(option))
+    m_inputOption = option;
+
   if (m_options.size() == 1)
     setInputFormat(option->name());
 
@@ -489,7 +1311,16 @@ void CoordinateConversionController::addOption(CoordinateConversionOptions* opti
  */
 void CoordinateConversionController::clearOptions()
 {
+  for (CoordinateConversionOptions* option : m_options)
+  {
+    disconnect(option, nullptr, this, nullptr);
+    if (m_cache)
+      m_cache->invalidate(reinterpret_cast<quintptr>(option));
+  }
+
   m_options.clear();
+  m_optionParameters.clear();
+  m_inputOption = nullptr;
   emit optionsChanged();
 }
 
@@ -522,13 +1353,10 @@ void CoordinateConversionController::setProperties(const QVariantMap& properties
  */
 QString CoordinateConversionController::pointToConvert() const
 {
-  for (CoordinateConversionOptions* option : m_options)
-  {
-    if (isInputFormat(option))
-      return convertPointInternal(option, m_pointToConvert);
-  }
+  if (m_asyncConversion && m_publishedNotationValid)
+    return m_publishedNotation;
 
-  return QString();
+  return convertPointInternal(m_inputOption, m_pointToConvert);
 }
 
 /*!
@@ -558,11 +1386,12 @@ void CoordinateConversionController::addCoordinateFormat(const QString& newForma
   if (!m_coordinateFormats.contains(newFormat))
     return;
 
+  const int formatId = CoordinateFormatRegistry::instance().formatId(newFormat);
   auto it = m_options.cbegin();
   const auto itEnd = m_options.cend();
   for (; it != itEnd; ++it)
   {
-    if (isFormat(*it, newFormat))
+    if (isFormat(*it, formatId, newFormat))
       return;
   }
 
@@ -584,14 +1413,21 @@ void CoordinateConversionController::removeCoordinateFormat(const QString& forma
   if (formatToRemove.compare(m_inputFormat, Qt::CaseInsensitive) == 0)
     return;
 
+  const int formatId = CoordinateFormatRegistry::instance().formatId(formatToRemove);
+
   bool removed = false;
   auto it = m_options.begin();
   auto itEnd = m_options.end();
   for (; it != itEnd; ++it)
   {
     const auto& option = *it;
-    if (isFormat(option, formatToRemove))
+    if (isFormat(option, formatId, formatToRemove))
     {
+      disconnect(option, nullptr, this, nullptr);
+      if (m_cache)
+        m_cache->invalidate(reinterpret_cast<quintptr>(option));
+
+      m_optionParameters.remove(option);
       m_options.erase(it);
       removed = true;
       break;
@@ -616,10 +1452,13 @@ void CoordinateConversionController::removeCoordinateFormat(const QString& forma
   within the bounds of \a screenWidth and \a screenHeight.
 
   If the point is off the screen, attempts to find the closest point on the
-  screen (e.g. on the edge) to the point.
+  screen (e.g. on the edge) to the point. The edges of the screen are cached
+  until the viewpoint or size of the view changes, so repeated calls are cheap.
  */
 QPointF CoordinateConversionController::screenCoordinate() const
 {
+  TOOLKIT_PROFILE_SCOPE("CoordinateConversionController::screenCoordinate");
+
   // attempt to get the target point as a screen coordinate
   QPointF res(-1.0, -1.0);
   if (m_sceneView)
@@ -635,57 +1474,16 @@ QPointF CoordinateConversionController::screenCoordinate() const
   const double screenHeight = m_sceneView ? m_sceneView->heightInPixels() - padding : m_mapView->heightInPixels() - padding;
 
   // if we did not recieve a valid screen coordinate
-  if (res.x() == 0.0 && res.y() == 0.0)
+  if (res.x() == 0.0 && res.y() == 0.0 && updateViewBoundary(screenWidth, screenHeight, padding))
   {
-    // lambda to search for a valid geographic position for the top of the screen (e.g. to account for the horizon)
-    auto findValidTopPoint = [this, screenHeight](double x)
+    // obtain the point on the view boundary polyline which is closest to the target point
+    if (!(m_projectedSource == m_pointToConvert))
     {
-      Point validTopPoint;
-      double lastValidY = screenHeight;
-      double testMinY = 1.0;
-      for (int attempt = 0; attempt < 16; ++attempt)
-      {
-        double testY = testMinY + ((lastValidY - testMinY) * 0.5);
-        auto newRes =  m_sceneView ? m_sceneView->screenToBaseSurface(x, testY) : m_mapView->screenToLocation(x, testY);
-        if (newRes.isValid() && !newRes.isEmpty())
-        {
-          validTopPoint = newRes;
-          if (std::abs(lastValidY - testY) < 1.0)
-            break;
-
-          lastValidY = testY;
-        }
-        else
-        {
-          testMinY = testY;
-        }
-      }
-
-      return validTopPoint;
-    };
-
-    // otherwise build a polyline describing the extent of the screen
-    Point topLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, padding) : m_mapView->screenToLocation(padding, padding);
-    if (topLeft.isEmpty() || !topLeft.isValid())
-      topLeft = findValidTopPoint(padding);
-
-    Point topRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, padding) : m_mapView->screenToLocation(screenWidth, padding);
-    if (topRight.isEmpty() || !topRight.isValid())
-      findValidTopPoint(screenWidth);
-
-    Point lowerLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, screenHeight) : m_mapView->screenToLocation(padding, screenHeight);
-    Point lowerRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, screenHeight) : m_mapView->screenToLocation(screenWidth, screenHeight);
+      m_projectedSource = m_pointToConvert;
+      m_projectedPoint = GeometryEngine::instance()->project(m_pointToConvert, m_viewBoundarySpatialReference);
+    }
 
-    PolylineBuilder bldr(topLeft.spatialReference());
-    bldr.addPoint(topLeft);
-    bldr.addPoint(topRight);
-    bldr.addPoint(lowerRight);
-    bldr.addPoint(lowerLeft);
-    bldr.addPoint(topLeft);
-    const Polyline viewBoundary = bldr.toPolyline();
-    // obtain the point on the view boundary polyline which is closest to the target point
-    Point projected = GeometryEngine::instance()->project(m_pointToConvert, topLeft.spatialReference());
-    const ProximityResult nearestCoordinateResult = GeometryEngine::instance()->nearestCoordinate(viewBoundary, projected);
+    const ProximityResult nearestCoordinateResult = GeometryEngine::instance()->nearestCoordinate(m_viewBoundary, m_projectedPoint);
 
     res = m_sceneView ? m_sceneView->locationToScreen(nearestCoordinateResult.coordinate()).screenPoint() :
                         m_mapView->locationToScreen(nearestCoordinateResult.coordinate());
@@ -705,6 +1503,79 @@ QPointF CoordinateConversionController::screenCoordinate() const
   return res;
 }
 
+/*!
+  \internal
+
+  Builds the polyline describing the edges of the view, unless it is already
+  cached for the current viewpoint and size. Returns \c false if no part of
+  the view shows a valid location.
+ */
+bool CoordinateConversionController::updateViewBoundary(double screenWidth, double screenHeight, double padding) const
+{
+  if (m_viewBoundaryValid)
+    return !m_viewBoundary.isEmpty();
+
+  m_viewBoundaryValid = true;
+
+  // lambda to search for a valid geographic position for the top of the screen (e.g. to account for the horizon)
+  auto findValidTopPoint = [this, screenHeight](double x)
+  {
+    Point validTopPoint;
+    double lastValidY = screenHeight;
+    double testMinY = 1.0;
+    for (int attempt = 0; attempt < 16; ++attempt)
+    {
+      double testY = testMinY + ((lastValidY - testMinY) * 0.5);
+      auto newRes =  m_sceneView ? m_sceneView->screenToBaseSurface(x, testY) : m_mapView->screenToLocation(x, testY);
+      if (newRes.isValid() && !newRes.isEmpty())
+      {
+        validTopPoint = newRes;
+        if (std::abs(lastValidY - testY) < 1.0)
+          break;
+
+        lastValidY = testY;
+      }
+      else
+      {
+        testMinY = testY;
+      }
+    }
+
+    return validTopPoint;
+  };
+
+  // otherwise build a polyline describing the extent of the screen
+  Point topLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, padding) : m_mapView->screenToLocation(padding, padding);
+  if (topLeft.isEmpty() || !topLeft.isValid())
+    topLeft = findValidTopPoint(padding);
+
+  Point topRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, padding) : m_mapView->screenToLocation(screenWidth, padding);
+  if (topRight.isEmpty() || !topRight.isValid())
+    topRight = findValidTopPoint(screenWidth);
+
+  if (topLeft.isEmpty() || topRight.isEmpty())
+    return false;
+
+  Point lowerLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, screenHeight) : m_mapView->screenToLocation(padding, screenHeight);
+  Point lowerRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, screenHeight) : m_mapView->screenToLocation(screenWidth, screenHeight);
+
+  PolylineBuilder bldr(topLeft.spatialReference());
+  bldr.addPoint(topLeft);
+  bldr.addPoint(topRight);
+  bldr.addPoint(lowerRight);
+  bldr.addPoint(lowerLeft);
+  bldr.addPoint(topLeft);
+
+  m_viewBoundary = bldr.toPolyline();
+  m_viewBoundarySpatialReference = topLeft.spatialReference();
+
+  // the target must be projected again into the boundary's spatial reference
+  m_projectedSource = Point();
+  m_projectedPoint = Point();
+
+  return true;
+}
+
 /*!
   \brief Zooms the current \l Esri::ArcGISRuntime::GeoView to the current input position.
  */
@@ -743,6 +1614,198 @@ void CoordinateConversionController::setRunConversion(bool runConversion)
   emit runConversionChanged();
 }
 
+/*!
+  \property CoordinateConversionController::asyncConversion
+  \brief Whether conversions of the point to convert run on a worker thread.
+  \since Esri::ArcGISRuntime 100.5
+
+  When \c true, \l convertPoint returns immediately and the \l results are
+  updated once the conversion completes. A point which arrives while a
+  conversion is running supersedes it, so only the newest results are
+  published. The \l pointToConvert property is updated along with the results.
+  Clicks in \l captureMode are not superseded, and each is added to the
+  \l captureHistory with its own notations.
+
+  The default is \c false.
+ */
+bool CoordinateConversionController::isAsyncConversion() const
+{
+  return m_asyncConversion;
+}
+
+void CoordinateConversionController::setAsyncConversion(bool asyncConversion)
+{
+  if (asyncConversion == m_asyncConversion)
+    return;
+
+  m_asyncConversion = asyncConversion;
+
+  if (!m_asyncConversion)
+  {
+    // clicks still waiting for their conversion are converted here, in the order they were made
+    if (m_asyncJob && m_asyncJob->m_capture)
+      m_pendingCaptures.prepend(m_asyncJob->m_point);
+
+    for (const Point& capture : qAsConst(m_pendingCaptures))
+      captureHistoryInternal()->append(capture, convertPointResults(capture));
+    m_pendingCaptures.clear();
+
+    // drop any work which has not been published yet
+    if (m_asyncJob)
+      m_asyncJob->m_superseded = true;
+
+    m_asyncConversionPending = false;
+    m_readyAsyncJob.reset();
+    if (m_publishTimer)
+      m_publishTimer->stop();
+  }
+
+  m_supersededCount = 0;
+  m_publishedNotationValid = false;
+
+  emit asyncConversionChanged();
+}
+
+/*!
+  \property CoordinateConversionController::maximumPublishRate
+  \brief The maximum number of times per second the \l results are updated
+  when \l asyncConversion is \c true.
+  \since Esri::ArcGISRuntime 100.5
+
+  Results which arrive more often are held back, and only the newest are
+  published. A value of \c 0 (the default) means there is no limit.
+ */
+double CoordinateConversionController::maximumPublishRate() const
+{
+  return m_maximumPublishRate;
+}
+
+void CoordinateConversionController::setMaximumPublishRate(double maximumPublishRate)
+{
+  if (maximumPublishRate < 0.0)
+    maximumPublishRate = 0.0;
+
+  if (qFuzzyCompare(maximumPublishRate + 1.0, m_maximumPublishRate + 1.0))
+    return;
+
+  m_maximumPublishRate = maximumPublishRate;
+  emit maximumPublishRateChanged();
+}
+
+/*!
+  \property CoordinateConversionController::cacheSize
+  \brief The maximum number of notations kept for reuse by later conversions.
+  \since Esri::ArcGISRuntime 100.5
+
+  Notations are cached against the exact point to convert, so repeated
+  conversions of the same point reuse the earlier results. When the cache is full the least
+  recently used notation is dropped. Editing an option removes its notations
+  from the cache.
+
+  A value of \c 0 (the default) disables the cache.
+
+  \sa cacheHits, cacheMisses, clearCache
+ */
+int CoordinateConversionController::cacheSize() const
+{
+  return m_cache ? m_cache->capacity() : 0;
+}
+
+void CoordinateConversionController::setCacheSize(int cacheSize)
+{
+  cacheSize = qMax(0, cacheSize);
+  if (cacheSize == this->cacheSize())
+    return;
+
+  if (cacheSize == 0)
+  {
+    // conversions which are still running keep their own reference to the old cache
+    m_cache.reset();
+  }
+  else if (m_cache)
+  {
+    m_cache->setCapacity(cacheSize);
+  }
+  else
+  {
+    m_cache = std::make_shared<CoordinateConversionCache>(cacheSize);
+  }
+
+  emit cacheSizeChanged();
+  emit cacheStatisticsChanged();
+}
+
+/*!
+  \property CoordinateConversionController::cacheHits
+  \brief The number of notations which were found in the cache.
+  \since Esri::ArcGISRuntime 100.5
+
+  \sa cacheSize, cacheMisses
+ */
+int CoordinateConversionController::cacheHits() const
+{
+  return m_cache ? m_cache->hits() : 0;
+}
+
+/*!
+  \property CoordinateConversionController::cacheMisses
+  \brief The number of notations which had to be produced because they were
+  not in the cache.
+  \since Esri::ArcGISRuntime 100.5
+
+  \sa cacheSize, cacheHits
+ */
+int CoordinateConversionController::cacheMisses() const
+{
+  return m_cache ? m_cache->misses() : 0;
+}
+
+/*!
+  \brief Empties the notation cache and resets \l cacheHits and \l cacheMisses.
+  \since Esri::ArcGISRuntime 100.5
+ */
+void CoordinateConversionController::clearCache()
+{
+  if (!m_cache)
+    return;
+
+  m_cache->clear();
+  emit cacheStatisticsChanged();
+}
+
+/*!
+  \property CoordinateConversionController::nativeBatchConversion
+  \brief Whether batch conversions use the toolkit's own formatting for the
+  simpler notations.
+  \since Esri::ArcGISRuntime 100.5
+
+  When \c true, batch conversions of WGS 84 points to decimal degrees,
+  degrees decimal minutes, degrees minutes seconds and UTM are formatted by
+  the toolkit rather than by the CoordinateFormatter, which is much faster
+  for large batches. Each format is first checked against the
+  CoordinateFormatter for a set of sample points, and falls back to the
+  CoordinateFormatter if the results differ by more than the last decimal
+  place. Points in other spatial references, UTM outside latitudes 80S to 84N,
+  and all other formats always use the CoordinateFormatter.
+
+  The default is \c false.
+
+  \sa convertPoints, convertNotations
+ */
+bool CoordinateConversionController::isNativeBatchConversion() const
+{
+  return m_nativeBatchConversion;
+}
+
+void CoordinateConversionController::setNativeBatchConversion(bool nativeBatchConversion)
+{
+  if (nativeBatchConversion == m_nativeBatchConversion)
+    return;
+
+  m_nativeBatchConversion = nativeBatchConversion;
+  emit nativeBatchConversionChanged();
+}
+
 // properties
 
 /*!
@@ -792,6 +1855,62 @@ void CoordinateConversionController::setRunConversion(bool runConversion)
   \brief Signal emitted when the \l captureMode property changes.
  */
 
+/*!
+  \fn void CoordinateConversionController::hoverModeChanged();
+  \brief Signal emitted when the \l hoverMode property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::hoverIntervalChanged();
+  \brief Signal emitted when the \l hoverInterval property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::asyncConversionChanged();
+  \brief Signal emitted when the \l asyncConversion property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::maximumPublishRateChanged();
+  \brief Signal emitted when the \l maximumPublishRate property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::cacheSizeChanged();
+  \brief Signal emitted when the \l cacheSize property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::cacheStatisticsChanged();
+  \brief Signal emitted when the \l cacheHits or \l cacheMisses properties change.
+ */
+
+/*!
+  \fn void CoordinateConversionController::nativeBatchConversionChanged();
+  \brief Signal emitted when the \l nativeBatchConversion property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::batchProgressChanged(int batchId, int convertedCount, int totalCount);
+  \brief Signal emitted as the batch conversion \a batchId progresses.
+
+  \list
+    \li \a batchId - The id returned when the batch was started.
+    \li \a convertedCount - The number of points converted so far.
+    \li \a totalCount - The number of points in the batch.
+  \endlist
+ */
+
+/*!
+  \fn void CoordinateConversionController::batchCompleted(int batchId, const Esri::ArcGISRuntime::Toolkit::CoordinateConversionBatchResults& results);
+  \brief Signal emitted when the batch conversion \a batchId has finished.
+
+  \list
+    \li \a batchId - The id returned when the batch was started.
+    \li \a results - The table of converted notations.
+  \endlist
+ */
+
 } // Toolkit
 } // ArcGISRuntime
 } // Esri
@@ -0,0 +1,517 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionKernel.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+// STL headers
+#include <cmath>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionKernel
+  \internal
+
+  Formats WGS 84 points as decimal degrees, degrees decimal minutes, degrees
+  minutes seconds or UTM without going through the CoordinateFormatter.
+
+  The kernels work on arrays of longitudes and latitudes. The numeric work is
+  done first over the whole array in simple, branch-free loops over contiguous
+  doubles which the compiler can vectorize. The text for each point is then
+  written into a fixed size buffer, so the only allocation per notation is the
+  resulting QString.
+
+  A kernel is only created if it reproduces the CoordinateFormatter's output for
+  a set of sample points, to within the last decimal place. Any other format,
+  option or point is left to the CoordinateFormatter. The comparison is made
+  once for each combination of settings, and its result is reused by later
+  batches.
+ */
+
+namespace
+{
+
+constexpr int maxDecimalPlaces = 9;
+constexpr int wgs84Wkid = 4326;
+
+// WGS 84 ellipsoid and UTM projection constants
+constexpr double semiMajorAxis = 6378137.0;
+constexpr double flattening = 1.0 / 298.257223563;
+constexpr double scaleFactor = 0.9996;
+constexpr double falseEasting = 500000.0;
+constexpr double falseNorthingSouth = 10000000.0;
+constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+
+constexpr int64_t powersOfTen[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+const char latitudeBands[] = "CDEFGHJKLMNPQRSTUVWXX";
+
+struct SamplePoint
+{
+  double m_longitude;
+  double m_latitude;
+};
+
+// covers each hemisphere, small values which need padding, and the irregular UTM zones
+const SamplePoint samplePoints[] =
+{
+  {0.5, 0.5},
+  {-0.5, -0.5},
+  {13.01, 55.585},
+  {-117.1957, 34.0565},
+  {151.2099, -33.8651},
+  {-74.006, 40.7128},
+  {100.123456789, 1.23456789},
+  {-3.5, -45.25},
+  {5.5, 60.0},
+  {15.0, 78.0},
+  {38.0, 80.5},
+  {-179.5, -79.5},
+  {179.5, 83.5},
+  {7.999999, 9.999999}
+};
+
+// writes value to buffer as a zero padded integer of at least width digits
+char* writeInteger(char* buffer, int64_t value, int width)
+{
+  char digits[20];
+  int count = 0;
+  do
+  {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  for (int i = count; i < width; ++i)
+    *buffer++ = '0';
+
+  while (count > 0)
+    *buffer++ = digits[--count];
+
+  return buffer;
+}
+
+// writes a whole part and decimalPlaces digits of fraction
+char* writeFixed(char* buffer, int64_t whole, int64_t fraction, int width, int decimalPlaces)
+{
+  buffer = writeInteger(buffer, whole, width);
+  if (decimalPlaces > 0)
+  {
+    *buffer++ = '.';
+    buffer = writeInteger(buffer, fraction, decimalPlaces);
+  }
+
+  return buffer;
+}
+
+// returns whether each number in actual is within one unit in the last place of
+// the number in expected, and everything else is identical
+bool matches(const QString& expected, const QString& actual)
+{
+  int i = 0;
+  int j = 0;
+  while (i < expected.size() && j < actual.size())
+  {
+    if (!expected.at(i).isDigit() || !actual.at(j).isDigit())
+    {
+      if (expected.at(i) != actual.at(j))
+        return false;
+
+      ++i;
+      ++j;
+      continue;
+    }
+
+    const int expectedStart = i;
+    while (i < expected.size() && (expected.at(i).isDigit() || expected.at(i) == QLatin1Char('.')))
+      ++i;
+
+    const int actualStart = j;
+    while (j < actual.size() && (actual.at(j).isDigit() || actual.at(j) == QLatin1Char('.')))
+      ++j;
+
+    const QString expectedNumber = expected.mid(expectedStart, i - expectedStart);
+    const QString actualNumber = actual.mid(actualStart, j - actualStart);
+    if (expectedNumber.size() != actualNumber.size())
+      return false;
+
+    const int point = expectedNumber.indexOf(QLatin1Char('.'));
+    const int decimals = point < 0 ? 0 : expectedNumber.size() - point - 1;
+    const double tolerance = std::pow(10.0, -decimals) * 1.000001;
+    if (std::abs(expectedNumber.toDouble() - actualNumber.toDouble()) > tolerance)
+      return false;
+  }
+
+  return i == expected.size() && j == actual.size();
+}
+
+// packs every setting which changes a kernel's output, given its kind
+quint64 validationKey(int kind, const CoordinateConversionParameters& parameters)
+{
+  return (static_cast<quint64>(kind) << 48) |
+         (static_cast<quint64>(parameters.m_decimalPlaces & 0xffff) << 32) |
+         (static_cast<quint64>(static_cast<int>(parameters.m_utmConversionMode) & 0xffff) << 16) |
+         (parameters.m_addSpaces ? 1u : 0u);
+}
+
+}
+
+/*!
+  \internal
+
+  Returns a kernel for the format described by \a parameters, or \c nullptr
+  if the format is not supported or the kernel does not agree with the
+  CoordinateFormatter.
+ */
+std::shared_ptr<const CoordinateConversionKernel> CoordinateConversionKernel::create(const CoordinateConversionParameters& parameters)
+{
+  if (parameters.m_customFormat)
+    return nullptr;
+
+  Kind kind = Kind::DecimalDegrees;
+  switch (parameters.m_outputMode)
+  {
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+  {
+    if (parameters.m_decimalPlaces < 0 || parameters.m_decimalPlaces > maxDecimalPlaces)
+      return nullptr;
+
+    if (parameters.m_latLonFormat == LatitudeLongitudeFormat::DecimalDegrees)
+      kind = Kind::DecimalDegrees;
+    else if (parameters.m_latLonFormat == LatitudeLongitudeFormat::DegreesDecimalMinutes)
+      kind = Kind::DegreesDecimalMinutes;
+    else if (parameters.m_latLonFormat == LatitudeLongitudeFormat::DegreesMinutesSeconds)
+      kind = Kind::DegreesMinutesSeconds;
+    else
+      return nullptr;
+
+    break;
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+  {
+    if (parameters.m_utmConversionMode != UtmConversionMode::LatitudeBandIndicators &&
+        parameters.m_utmConversionMode != UtmConversionMode::NorthSouthIndicators)
+    {
+      return nullptr;
+    }
+
+    kind = Kind::Utm;
+    break;
+  }
+  default:
+    return nullptr;
+  }
+
+  std::shared_ptr<const CoordinateConversionKernel> kernel(new CoordinateConversionKernel(kind, parameters));
+
+  // the sample points are formatted by the CoordinateFormatter, so validate each set of settings only once
+  static QMutex validationMutex;
+  static QHash<quint64, bool> validated;
+
+  const quint64 key = validationKey(static_cast<int>(kind), parameters);
+  QMutexLocker locker(&validationMutex);
+  auto it = validated.constFind(key);
+  if (it == validated.cend())
+  {
+    const bool valid = kernel->validate();
+    it = validated.insert(key, valid);
+    if (!valid)
+    {
+      qWarning("Native formatting for %s does not match the CoordinateFormatter and has been disabled.",
+               qPrintable(parameters.m_name));
+    }
+  }
+
+  return it.value() ? kernel : nullptr;
+}
+
+/*!
+  \internal
+
+  Returns whether \a point can be passed to the kernels.
+ */
+bool CoordinateConversionKernel::accepts(const Point& point)
+{
+  return !point.isEmpty() && point.spatialReference().wkid() == wgs84Wkid;
+}
+
+/*!
+  \internal
+ */
+CoordinateConversionKernel::CoordinateConversionKernel(Kind kind, const CoordinateConversionParameters& parameters) :
+  m_kind(kind),
+  m_parameters(parameters),
+  m_decimalPlaces(parameters.m_decimalPlaces)
+{
+}
+
+/*!
+  \internal
+
+  Compares the kernel's output for the sample points with the CoordinateFormatter's.
+ */
+bool CoordinateConversionKernel::validate() const
+{
+  constexpr int sampleCount = sizeof(samplePoints) / sizeof(samplePoints[0]);
+
+  QVector<double> longitudes(sampleCount);
+  QVector<double> latitudes(sampleCount);
+  for (int i = 0; i < sampleCount; ++i)
+  {
+    longitudes[i] = samplePoints[i].m_longitude;
+    latitudes[i] = samplePoints[i].m_latitude;
+  }
+
+  QVector<QString> notations(sampleCount);
+  format(longitudes.constData(), latitudes.constData(), sampleCount, notations.data());
+
+  const SpatialReference wgs84 = SpatialReference::wgs84();
+  for (int i = 0; i < sampleCount; ++i)
+  {
+    const QString expected = m_parameters.toNotation(Point(longitudes.at(i), latitudes.at(i), wgs84));
+    if (!matches(expected, notations.at(i)))
+      return false;
+  }
+
+  return true;
+}
+
+/*!
+  \internal
+
+  Formats \a count points. Notations which cannot be produced by the kernel,
+  such as UTM outside the UTM latitudes, are left null.
+ */
+void CoordinateConversionKernel::format(const double* longitudes, const double* latitudes, int count, QString* notations) const
+{
+  if (m_kind == Kind::Utm)
+    formatUtm(longitudes, latitudes, count, notations);
+  else
+    formatLatitudeLongitude(longitudes, latitudes, count, notations);
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionKernel::formatLatitudeLongitude(const double* longitudes, const double* latitudes, int count,
+                                                         QString* notations) const
+{
+  // the smallest unit written, as a fraction of a degree
+  double unitsPerDegree = 1.0;
+  if (m_kind == Kind::DegreesDecimalMinutes)
+    unitsPerDegree = 60.0;
+  else if (m_kind == Kind::DegreesMinutesSeconds)
+    unitsPerDegree = 3600.0;
+
+  const int64_t fractionScale = powersOfTen[m_decimalPlaces];
+  const double scale = unitsPerDegree * static_cast<double>(fractionScale);
+
+  // decompose each coordinate into whole degrees, minutes, seconds and a fraction of the last unit
+  QVector<int64_t> latitudeUnits(count);
+  QVector<int64_t> longitudeUnits(count);
+  int64_t* latitudeOut = latitudeUnits.data();
+  int64_t* longitudeOut = longitudeUnits.data();
+  for (int i = 0; i < count; ++i)
+  {
+    latitudeOut[i] = static_cast<int64_t>(std::floor(std::abs(latitudes[i]) * scale + 0.5));
+    longitudeOut[i] = static_cast<int64_t>(std::floor(std::abs(longitudes[i]) * scale + 0.5));
+  }
+
+  const int64_t unitsPerWholeDegree = static_cast<int64_t>(unitsPerDegree) * fractionScale;
+  const int64_t unitsPerMinute = (m_kind == Kind::DegreesMinutesSeconds ? 60 : 1) * fractionScale;
+
+  // e.g. "034 03 23.40000W", plus the separator
+  char buffer[64];
+  for (int i = 0; i < count; ++i)
+  {
+    char* out = buffer;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      const bool isLatitude = axis == 0;
+      const int64_t units = isLatitude ? latitudeOut[i] : longitudeOut[i];
+      const double value = isLatitude ? latitudes[i] : longitudes[i];
+      const int degreeWidth = isLatitude ? 2 : 3;
+
+      const int64_t degrees = units / unitsPerWholeDegree;
+      const int64_t remainder = units % unitsPerWholeDegree;
+      switch (m_kind)
+      {
+      case Kind::DecimalDegrees:
+      {
+        out = writeFixed(out, degrees, remainder, degreeWidth, m_decimalPlaces);
+        break;
+      }
+      case Kind::DegreesDecimalMinutes:
+      {
+        out = writeInteger(out, degrees, degreeWidth);
+        *out++ = ' ';
+        out = writeFixed(out, remainder / fractionScale, remainder % fractionScale, 2, m_decimalPlaces);
+        break;
+      }
+      case Kind::DegreesMinutesSeconds:
+      {
+        out = writeInteger(out, degrees, degreeWidth);
+        *out++ = ' ';
+        out = writeInteger(out, remainder / unitsPerMinute, 2);
+        *out++ = ' ';
+        const int64_t seconds = remainder % unitsPerMinute;
+        out = writeFixed(out, seconds / fractionScale, seconds % fractionScale, 2, m_decimalPlaces);
+        break;
+      }
+      default:
+        break;
+      }
+
+      if (isLatitude)
+      {
+        *out++ = value < 0.0 ? 'S' : 'N';
+        *out++ = ' ';
+      }
+      else
+      {
+        *out++ = value < 0.0 ? 'W' : 'E';
+      }
+    }
+
+    notations[i] = QString::fromLatin1(buffer, static_cast<int>(out - buffer));
+  }
+}
+
+/*!
+  \internal
+
+  Uses the Kruger series for the transverse Mercator projection, which is
+  accurate to well under a millimeter within a UTM zone.
+ */
+void CoordinateConversionKernel::formatUtm(const double* longitudes, const double* latitudes, int count,
+                                           QString* notations) const
+{
+  const double n = flattening / (2.0 - flattening);
+  const double n2 = n * n;
+  const double n3 = n2 * n;
+  const double eccentricity = std::sqrt(flattening * (2.0 - flattening));
+  const double rectifyingRadius = semiMajorAxis / (1.0 + n) * (1.0 + n2 / 4.0 + n2 * n2 / 64.0);
+  const double alpha1 = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0;
+  const double alpha2 = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0;
+  const double alpha3 = 61.0 * n3 / 240.0;
+
+  QVector<int> zones(count);
+  QVector<double> eastings(count);
+  QVector<double> northings(count);
+  int* zoneOut = zones.data();
+  double* eastingOut = eastings.data();
+  double* northingOut = northings.data();
+
+  // choose the zone, including the exceptions for southern Norway and Svalbard
+  for (int i = 0; i < count; ++i)
+  {
+    const double longitude = longitudes[i];
+    const double latitude = latitudes[i];
+
+    int zone = static_cast<int>(std::floor((longitude + 180.0) / 6.0)) + 1;
+    zone = zone < 1 ? 1 : (zone > 60 ? 60 : zone);
+
+    const bool norway = latitude >= 56.0 && latitude < 64.0 && longitude >= 3.0 && longitude < 12.0;
+    zone = norway ? 32 : zone;
+
+    const bool svalbard = latitude >= 72.0 && longitude >= 0.0 && longitude < 42.0;
+    const int svalbardZone = longitude < 9.0 ? 31 : (longitude < 21.0 ? 33 : (longitude < 33.0 ? 35 : 37));
+    zone = svalbard ? svalbardZone : zone;
+
+    zoneOut[i] = zone;
+  }
+
+  // project each point into its zone
+  for (int i = 0; i < count; ++i)
+  {
+    const double centralMeridian = (zoneOut[i] * 6.0 - 183.0) * degreesToRadians;
+    const double phi = latitudes[i] * degreesToRadians;
+    const double lambda = longitudes[i] * degreesToRadians - centralMeridian;
+
+    const double sinPhi = std::sin(phi);
+    const double t = std::sinh(std::atanh(sinPhi) - eccentricity * std::atanh(eccentricity * sinPhi));
+    const double xiPrime = std::atan2(t, std::cos(lambda));
+    const double etaPrime = std::atanh(std::sin(lambda) / std::sqrt(1.0 + t * t));
+
+    const double xi = xiPrime +
+                      alpha1 * std::sin(2.0 * xiPrime) * std::cosh(2.0 * etaPrime) +
+                      alpha2 * std::sin(4.0 * xiPrime) * std::cosh(4.0 * etaPrime) +
+                      alpha3 * std::sin(6.0 * xiPrime) * std::cosh(6.0 * etaPrime);
+    const double eta = etaPrime +
+                       alpha1 * std::cos(2.0 * xiPrime) * std::sinh(2.0 * etaPrime) +
+                       alpha2 * std::cos(4.0 * xiPrime) * std::sinh(4.0 * etaPrime) +
+                       alpha3 * std::cos(6.0 * xiPrime) * std::sinh(6.0 * etaPrime);
+
+    eastingOut[i] = falseEasting + scaleFactor * rectifyingRadius * eta;
+    northingOut[i] = (latitudes[i] < 0.0 ? falseNorthingSouth : 0.0) + scaleFactor * rectifyingRadius * xi;
+  }
+
+  const bool bandIndicators = m_parameters.m_utmConversionMode == UtmConversionMode::LatitudeBandIndicators;
+  const bool addSpaces = m_parameters.m_addSpaces;
+
+  // e.g. "33U 365003 6161659"
+  char buffer[32];
+  for (int i = 0; i < count; ++i)
+  {
+    const double latitude = latitudes[i];
+    if (!(latitude >= -80.0 && latitude <= 84.0))
+      continue; // the polar regions use UPS, which is left to the CoordinateFormatter
+
+    char* out = buffer;
+    out = writeInteger(out, zoneOut[i], 1);
+
+    if (bandIndicators)
+    {
+      const int band = static_cast<int>(std::floor((latitude + 80.0) / 8.0));
+      *out++ = latitudeBands[band < 0 ? 0 : (band > 20 ? 20 : band)];
+    }
+    else
+    {
+      *out++ = latitude < 0.0 ? 'S' : 'N';
+    }
+
+    if (addSpaces)
+      *out++ = ' ';
+
+    out = writeInteger(out, static_cast<int64_t>(std::floor(eastingOut[i] + 0.5)), 6);
+
+    if (addSpaces)
+      *out++ = ' ';
+
+    out = writeInteger(out, static_cast<int64_t>(std::floor(northingOut[i] + 0.5)), 7);
+
+    notations[i] = QString::fromLatin1(buffer, static_cast<int>(out - buffer));
+  }
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
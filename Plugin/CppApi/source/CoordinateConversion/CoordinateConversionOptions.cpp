@@ -17,6 +17,7 @@
 #include "CoordinateConversionConstants.h"
 #include "CoordinateConversionOptions.h"
 #include "CoordinateConversionController.h"
+#include "CoordinateFormatRegistry.h"
 
 namespace Esri
 {
@@ -130,9 +131,26 @@ QString CoordinateConversionOptions::name() const
 void CoordinateConversionOptions::setName(const QString& name)
 {
   m_name = name;
+  m_formatId = CoordinateFormatRegistry::instance().formatId(name);
   emit nameChanged();
 }
 
+/*!
+  \brief Returns the id of the format named by \l name, or
+  CoordinateFormatRegistry::InvalidFormatId if no such format is known.
+  \since Esri::ArcGISRuntime 100.5
+
+  \sa CoordinateFormatRegistry
+ */
+int CoordinateConversionOptions::formatId() const
+{
+  // a format registered after the name was set is picked up here
+  if (m_formatId == CoordinateFormatRegistry::InvalidFormatId && !m_name.isEmpty())
+    m_formatId = CoordinateFormatRegistry::instance().formatId(m_name);
+
+  return m_formatId;
+}
+
 /*!
   \property CoordinateConversionOptions::addSpaces
   \brief Whether the output notation format should use spaces.
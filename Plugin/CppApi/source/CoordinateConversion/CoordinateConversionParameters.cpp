@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionParameters.h"
+
+// C++ API headers
+#include "CoordinateFormatter.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionParameters
+  \internal
+
+  A copy of the settings held by a \l CoordinateConversionOptions object.
+
+  Options are QObjects which live on the GUI thread and can be edited at any
+  time. Conversions which run on worker threads take a copy of the settings
+  up front instead of reading the options while they are running.
+ */
+
+/*!
+  \internal
+ */
+CoordinateConversionParameters::CoordinateConversionParameters(const CoordinateConversionOptions* option)
+{
+  if (!option)
+    return;
+
+  m_optionId = reinterpret_cast<quintptr>(option);
+  m_name = option->name();
+  m_outputMode = option->outputMode();
+  m_addSpaces = option->addSpaces();
+  m_precision = option->precision();
+  m_decimalPlaces = option->decimalPlaces();
+  m_mgrsConversionMode = option->mgrsConversionMode();
+  m_latLonFormat = option->latLonFormat();
+  m_utmConversionMode = option->utmConversionMode();
+  m_garsConversionMode = option->garsConvesrionMode();
+
+  const auto& registry = CoordinateFormatRegistry::instance();
+  m_formatId = option->formatId();
+  m_formatter = registry.formatter(m_formatId);
+  m_parser = registry.parser(m_formatId);
+  m_customFormat = m_formatter || m_parser;
+}
+
+/*!
+  \internal
+
+  Returns \a point as a notation string in the format described by these parameters.
+ */
+QString CoordinateConversionParameters::toNotation(const Point& point) const
+{
+  if (m_customFormat)
+    return m_formatter ? m_formatter(point) : QString();
+
+  switch (m_outputMode)
+  {
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
+  {
+    return CoordinateFormatter::toGars(point);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+  {
+    return CoordinateFormatter::toGeoRef(point, m_precision);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+  {
+    return CoordinateFormatter::toLatitudeLongitude(point, m_latLonFormat, m_decimalPlaces);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+  {
+    return CoordinateFormatter::toMgrs(point, m_mgrsConversionMode, m_decimalPlaces, m_addSpaces);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+  {
+    return CoordinateFormatter::toUsng(point, m_precision, m_decimalPlaces);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+  {
+    return CoordinateFormatter::toUtm(point, m_utmConversionMode, m_addSpaces);
+  }
+  default: {}
+  }
+
+  return QString();
+}
+
+/*!
+  \internal
+
+  Returns the point described by \a notation, in \a spatialReference, when the
+  notation is in the format described by these parameters.
+ */
+Point CoordinateConversionParameters::fromNotation(const QString& notation,
+                                                   const SpatialReference& spatialReference) const
+{
+  if (m_customFormat)
+    return m_parser ? m_parser(notation, spatialReference) : Point();
+
+  switch (m_outputMode)
+  {
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
+  {
+    return CoordinateFormatter::fromGars(notation, spatialReference, m_garsConversionMode);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+  {
+    return CoordinateFormatter::fromGeoRef(notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+  {
+    return CoordinateFormatter::fromLatitudeLongitude(notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+  {
+    return CoordinateFormatter::fromMgrs(notation, spatialReference, m_mgrsConversionMode);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+  {
+    return CoordinateFormatter::fromUsng(notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+  {
+    return CoordinateFormatter::fromUtm(notation, spatialReference, m_utmConversionMode);
+  }
+  default: {}
+  }
+
+  return Point();
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
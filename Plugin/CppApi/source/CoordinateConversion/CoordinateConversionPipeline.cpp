@@ -0,0 +1,518 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionPipeline.h"
+
+// toolkit headers
+#include "CoordinateConversionOptions.h"
+#include "CoordinateConversionRunnable.h"
+#include "CoordinateFormatFactory.h"
+
+// Qt headers
+#include <QFileDevice>
+#include <QIODevice>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+// STL headers
+#include <cstring>
+#include <deque>
+#include <memory>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionPipeline
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief Converts a stream of delimited text records from one coordinate
+  notation to others, without a user interface.
+
+  Each line of the input is a record. The notation in \l column is read in the
+  input format and converted to each of the output formats, which are appended
+  to the record as extra fields. Formats are named as for the
+  \l CoordinateFormatFactory, and use the same options as the
+  \l CoordinateConversionController.
+
+  Input is read a chunk of lines at a time (directly from a memory map when the
+  input is a file) and chunks are converted in parallel on the global thread
+  pool. Output is written in the same order as the input as soon as each chunk
+  is ready, and at most \l maximumChunksInFlight chunks are held in memory, so
+  arbitrarily large inputs can be converted.
+
+  Fields are split on the delimiter without any handling of quotes. Output
+  fields which contain the delimiter are quoted.
+
+  \sa {Coordinate Conversion Tool}
+ */
+
+/*!
+  \internal
+ */
+class CoordinateConversionPipeline::Chunk
+{
+public:
+  QList<QByteArray> m_lines;
+  QByteArray m_output;
+  qint64 m_convertedCount = 0;
+  qint64 m_failedCount = 0;
+  bool m_done = false; // guarded by the pipeline mutex
+};
+
+/*!
+  \internal
+
+  Reads lines from a device, using a memory map of the whole file where one
+  is available.
+ */
+class CoordinateConversionPipeline::LineReader
+{
+public:
+  explicit LineReader(QIODevice* device) :
+    m_device(device)
+  {
+    auto file = qobject_cast<QFileDevice*>(device);
+    if (file && !file->isSequential() && file->size() > 0 && file->pos() == 0)
+    {
+      m_mapped = file->map(0, file->size());
+      if (m_mapped)
+      {
+        m_file = file;
+        m_end = m_mapped + file->size();
+        m_current = m_mapped;
+      }
+    }
+  }
+
+  ~LineReader()
+  {
+    if (m_file && m_mapped)
+      m_file->unmap(m_mapped);
+  }
+
+  bool readLine(QByteArray& line)
+  {
+    if (m_mapped)
+    {
+      if (m_current >= m_end)
+        return false;
+
+      const uchar* lineEnd = static_cast<const uchar*>(std::memchr(m_current, '\n', m_end - m_current));
+      const uchar* next = lineEnd ? lineEnd + 1 : m_end;
+      if (!lineEnd)
+        lineEnd = m_end;
+
+      line = QByteArray(reinterpret_cast<const char*>(m_current), static_cast<int>(lineEnd - m_current));
+      m_current = next;
+    }
+    else
+    {
+      if (m_device->atEnd())
+        return false;
+
+      line = m_device->readLine();
+      if (line.endsWith('\n'))
+        line.chop(1);
+    }
+
+    if (line.endsWith('\r'))
+      line.chop(1);
+
+    return true;
+  }
+
+private:
+  QIODevice* m_device = nullptr;
+  QFileDevice* m_file = nullptr;
+  uchar* m_mapped = nullptr;
+  const uchar* m_current = nullptr;
+  const uchar* m_end = nullptr;
+};
+
+namespace
+{
+
+void appendField(QByteArray& line, const QString& field, char delimiter)
+{
+  const QByteArray bytes = field.toUtf8();
+  line.append(delimiter);
+  if (bytes.contains(delimiter) || bytes.contains('"'))
+  {
+    QByteArray quoted = bytes;
+    quoted.replace("\"", "\"\"");
+    line.append('"').append(quoted).append('"');
+  }
+  else
+  {
+    line.append(bytes);
+  }
+}
+
+}
+
+/*!
+  \brief Constructs a pipeline with no formats, reading the first column of
+  comma separated records in WGS 84.
+ */
+CoordinateConversionPipeline::CoordinateConversionPipeline() :
+  m_spatialReference(SpatialReference::wgs84())
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+CoordinateConversionPipeline::~CoordinateConversionPipeline()
+{
+}
+
+/*!
+  \brief Sets the format of the notations read from the input to \a formatName.
+
+  Returns \c false if there is no such format.
+ */
+bool CoordinateConversionPipeline::setInputFormat(const QString& formatName)
+{
+  std::unique_ptr<CoordinateConversionOptions> option(CoordinateFormatFactory::createFormat(formatName, nullptr));
+  if (!option)
+  {
+    m_errorString = QString("Unknown coordinate format: %1").arg(formatName);
+    return false;
+  }
+
+  m_inputParameters = CoordinateConversionParameters(option.get());
+  m_hasInputFormat = true;
+  return true;
+}
+
+/*!
+  \brief Adds \a formatName to the formats written to the output.
+
+  Returns \c false if there is no such format.
+ */
+bool CoordinateConversionPipeline::addOutputFormat(const QString& formatName)
+{
+  std::unique_ptr<CoordinateConversionOptions> option(CoordinateFormatFactory::createFormat(formatName, nullptr));
+  if (!option)
+  {
+    m_errorString = QString("Unknown coordinate format: %1").arg(formatName);
+    return false;
+  }
+
+  m_outputParameters.append(CoordinateConversionParameters(option.get()));
+  return true;
+}
+
+/*!
+  \brief Returns the spatial reference the input notations are read into.
+ */
+SpatialReference CoordinateConversionPipeline::spatialReference() const
+{
+  return m_spatialReference;
+}
+
+/*!
+  \brief Sets the spatial reference the input notations are read into to
+  \a spatialReference.
+ */
+void CoordinateConversionPipeline::setSpatialReference(const SpatialReference& spatialReference)
+{
+  m_spatialReference = spatialReference;
+}
+
+/*!
+  \brief Returns the zero-based index of the field holding the notation to convert.
+ */
+int CoordinateConversionPipeline::column() const
+{
+  return m_column;
+}
+
+/*!
+  \brief Sets the zero-based index of the field holding the notation to convert to \a column.
+ */
+void CoordinateConversionPipeline::setColumn(int column)
+{
+  m_column = qMax(0, column);
+}
+
+/*!
+  \brief Returns the character which separates the fields of a record.
+ */
+QChar CoordinateConversionPipeline::delimiter() const
+{
+  return m_delimiter;
+}
+
+/*!
+  \brief Sets the character which separates the fields of a record to \a delimiter.
+ */
+void CoordinateConversionPipeline::setDelimiter(QChar delimiter)
+{
+  m_delimiter = delimiter;
+}
+
+/*!
+  \brief Returns whether the first line of the input is a header.
+ */
+bool CoordinateConversionPipeline::hasHeader() const
+{
+  return m_hasHeader;
+}
+
+/*!
+  \brief Sets whether the first line of the input is a header to \a hasHeader.
+
+  The header is copied to the output with the names of the output formats appended.
+ */
+void CoordinateConversionPipeline::setHasHeader(bool hasHeader)
+{
+  m_hasHeader = hasHeader;
+}
+
+/*!
+  \brief Returns the number of records converted together by one thread.
+ */
+int CoordinateConversionPipeline::chunkSize() const
+{
+  return m_chunkSize;
+}
+
+/*!
+  \brief Sets the number of records converted together by one thread to \a chunkSize.
+ */
+void CoordinateConversionPipeline::setChunkSize(int chunkSize)
+{
+  m_chunkSize = qMax(1, chunkSize);
+}
+
+/*!
+  \brief Returns the maximum number of chunks held in memory at once.
+
+  A value of \c 0 (the default) uses twice the number of threads in the
+  global thread pool.
+ */
+int CoordinateConversionPipeline::maximumChunksInFlight() const
+{
+  return m_maximumChunksInFlight;
+}
+
+/*!
+  \brief Sets the maximum number of chunks held in memory at once to \a maximumChunksInFlight.
+ */
+void CoordinateConversionPipeline::setMaximumChunksInFlight(int maximumChunksInFlight)
+{
+  m_maximumChunksInFlight = qMax(0, maximumChunksInFlight);
+}
+
+/*!
+  \brief Reads records from \a input, converts them, and writes them to \a output.
+
+  Both devices must already be open. Returns \c false if the pipeline is not
+  set up or the output cannot be written; see \l errorString.
+ */
+bool CoordinateConversionPipeline::run(QIODevice* input, QIODevice* output)
+{
+  m_convertedCount = 0;
+  m_failedCount = 0;
+  m_errorString.clear();
+
+  if (!input || !output)
+  {
+    m_errorString = "The input and output must be set.";
+    return false;
+  }
+
+  if (!m_hasInputFormat || m_outputParameters.isEmpty())
+  {
+    m_errorString = "An input format and at least one output format must be set.";
+    return false;
+  }
+
+  if (m_spatialReference.isEmpty())
+    qWarning("The spatial reference is empty: conversions will fail.");
+
+  QThreadPool* threadPool = QThreadPool::globalInstance();
+  const int maximumInFlight = m_maximumChunksInFlight > 0 ? m_maximumChunksInFlight
+                                                          : qMax(1, threadPool->maxThreadCount()) * 2;
+
+  LineReader reader(input);
+  QMutex mutex;
+  QWaitCondition chunkDone;
+  std::deque<std::shared_ptr<Chunk>> inFlight;
+  bool writeFailed = false;
+
+  // writes out the oldest chunk once it has been converted
+  auto writeOldest = [&]()
+  {
+    const std::shared_ptr<Chunk> chunk = inFlight.front();
+    inFlight.pop_front();
+    {
+      QMutexLocker locker(&mutex);
+      while (!chunk->m_done)
+        chunkDone.wait(&mutex);
+    }
+
+    m_convertedCount += chunk->m_convertedCount;
+    m_failedCount += chunk->m_failedCount;
+    if (!writeFailed && output->write(chunk->m_output) != chunk->m_output.size())
+      writeFailed = true;
+  };
+
+  QByteArray line;
+  if (m_hasHeader && reader.readLine(line))
+  {
+    if (output->write(outputHeader(line)) < 0)
+      writeFailed = true;
+  }
+
+  bool moreInput = !writeFailed;
+  while (moreInput)
+  {
+    auto chunk = std::make_shared<Chunk>();
+    chunk->m_lines.reserve(m_chunkSize);
+    while (chunk->m_lines.size() < m_chunkSize)
+    {
+      if (!reader.readLine(line))
+      {
+        moreInput = false;
+        break;
+      }
+
+      chunk->m_lines.append(line);
+    }
+
+    if (chunk->m_lines.isEmpty())
+      break;
+
+    // keep the memory use bounded by waiting for the oldest chunk before starting another
+    if (static_cast<int>(inFlight.size()) >= maximumInFlight)
+      writeOldest();
+
+    inFlight.push_back(chunk);
+    threadPool->start(new CoordinateConversionRunnable([this, chunk, &mutex, &chunkDone]()
+    {
+      convertChunk(chunk.get());
+
+      QMutexLocker locker(&mutex);
+      chunk->m_done = true;
+      chunkDone.wakeAll();
+    }));
+
+    if (writeFailed)
+      break;
+  }
+
+  while (!inFlight.empty())
+    writeOldest();
+
+  if (writeFailed)
+  {
+    m_errorString = QString("Failed to write the output: %1").arg(output->errorString());
+    return false;
+  }
+
+  return true;
+}
+
+/*!
+  \brief Returns the number of records converted by the last \l run.
+ */
+qint64 CoordinateConversionPipeline::convertedCount() const
+{
+  return m_convertedCount;
+}
+
+/*!
+  \brief Returns the number of records in the last \l run whose notation
+  could not be read.
+
+  These records are written with empty output fields.
+ */
+qint64 CoordinateConversionPipeline::failedCount() const
+{
+  return m_failedCount;
+}
+
+/*!
+  \brief Returns a description of the last error.
+ */
+QString CoordinateConversionPipeline::errorString() const
+{
+  return m_errorString;
+}
+
+/*!
+  \internal
+
+  Converts the records in \a chunk. This is called from worker threads and
+  only reads the pipeline's settings.
+ */
+void CoordinateConversionPipeline::convertChunk(Chunk* chunk) const
+{
+  const char delimiter = m_delimiter.toLatin1();
+  for (const QByteArray& record : qAsConst(chunk->m_lines))
+  {
+    chunk->m_output.append(record);
+
+    const QList<QByteArray> fields = record.split(delimiter);
+    const QString notation = m_column < fields.size() ? QString::fromUtf8(fields.at(m_column)).trimmed() : QString();
+    const Point point = notation.isEmpty() ? Point() : m_inputParameters.fromNotation(notation, m_spatialReference);
+
+    if (point.isEmpty())
+    {
+      ++chunk->m_failedCount;
+      for (int i = 0; i < m_outputParameters.size(); ++i)
+        chunk->m_output.append(delimiter);
+    }
+    else
+    {
+      ++chunk->m_convertedCount;
+      for (const auto& parameters : m_outputParameters)
+        appendField(chunk->m_output, parameters.toNotation(point), delimiter);
+    }
+
+    chunk->m_output.append('\n');
+  }
+
+  // the input is no longer needed once the output is ready
+  chunk->m_lines.clear();
+}
+
+/*!
+  \internal
+ */
+QByteArray CoordinateConversionPipeline::outputHeader(const QByteArray& header) const
+{
+  QByteArray line = header;
+  for (const auto& parameters : m_outputParameters)
+    appendField(line, parameters.m_name, m_delimiter.toLatin1());
+
+  line.append('\n');
+  return line;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -17,6 +17,8 @@
 #include "CoordinateConversionResults.h"
 #include "CoordinateConversionOptions.h"
 
+#include <algorithm>
+
 namespace Esri
 {
 namespace ArcGISRuntime
@@ -79,16 +81,109 @@ CoordinateConversionResults::~CoordinateConversionResults()
 
 /*!
   \internal
+
+  Updates the model to hold \a results.
+
+  Rows are matched to the existing rows by name, so that views only update the
+  delegates which need it: rows whose notation changed emit \c dataChanged,
+  and formats which were added, removed or reordered are inserted, removed or
+  moved rather than resetting the whole model.
  */
 void CoordinateConversionResults::setResults(QList<Result>&& results)
 {
-  // set the new results
-  beginResetModel();
-  m_results.clear();
-  m_results = std::move(results);
-  endResetModel();
+  bool changed = false;
 
-  emit resultsChanged();
+  // remove the rows for formats which are no longer present
+  for (int row = m_results.size() - 1; row >= 0; --row)
+  {
+    const QString& name = m_results.at(row).m_name;
+    const bool found = std::any_of(results.cbegin(), results.cend(), [&name](const Result& result)
+    {
+      return result.m_name == name;
+    });
+
+    if (found)
+      continue;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_results.removeAt(row);
+    endRemoveRows();
+    changed = true;
+  }
+
+  // bring the remaining rows into the new order, inserting any new formats
+  int firstChangedRow = -1;
+  for (int row = 0; row < results.size(); ++row)
+  {
+    const Result& result = results.at(row);
+
+    int existingRow = -1;
+    for (int i = row; i < m_results.size(); ++i)
+    {
+      if (m_results.at(i).m_name == result.m_name)
+      {
+        existingRow = i;
+        break;
+      }
+    }
+
+    if (existingRow == -1)
+    {
+      beginInsertRows(QModelIndex(), row, row);
+      m_results.insert(row, result);
+      endInsertRows();
+      changed = true;
+    }
+    else
+    {
+      if (existingRow != row)
+      {
+        beginMoveRows(QModelIndex(), existingRow, existingRow, QModelIndex(), row);
+        m_results.move(existingRow, row);
+        endMoveRows();
+        changed = true;
+      }
+
+      Result& existing = m_results[row];
+      if (existing.m_notation != result.m_notation || existing.m_type != result.m_type)
+      {
+        existing.m_notation = result.m_notation;
+        existing.m_type = result.m_type;
+        if (firstChangedRow == -1)
+          firstChangedRow = row;
+
+        continue;
+      }
+    }
+
+    // report each run of consecutive updated rows together
+    if (firstChangedRow != -1)
+    {
+      emitDataChanged(firstChangedRow, row - 1);
+      firstChangedRow = -1;
+      changed = true;
+    }
+  }
+
+  if (firstChangedRow != -1)
+  {
+    emitDataChanged(firstChangedRow, results.size() - 1);
+    changed = true;
+  }
+
+  if (changed)
+    emit resultsChanged();
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionResults::emitDataChanged(int firstRow, int lastRow)
+{
+  static const QVector<int> changedRoles{CoordinateConversionResultsNotationRole,
+                                         CoordinateConversionResultsCoordinateTypeRole};
+
+  emit dataChanged(index(firstRow), index(lastRow), changedRoles);
 }
 
 void CoordinateConversionResults::removeResult(const QString& name)
@@ -111,13 +206,25 @@ void CoordinateConversionResults::removeResult(const QString& name)
  */
 void CoordinateConversionResults::clearResults()
 {
-  if (m_results.isEmpty())
-    return;
+  int firstChangedRow = -1;
+  int lastChangedRow = -1;
+  for (int row = 0; row < m_results.size(); ++row)
+  {
+    Result& result = m_results[row];
+    if (result.m_notation.isEmpty())
+      continue;
 
-  emit beginResetModel();
-  for (auto& result : m_results)
     result.m_notation.clear();
-  endResetModel();
+    if (firstChangedRow == -1)
+      firstChangedRow = row;
+
+    lastChangedRow = row;
+  }
+
+  if (firstChangedRow == -1)
+    return;
+
+  emitDataChanged(firstChangedRow, lastChangedRow);
 
   emit resultsChanged();
 }
@@ -0,0 +1,706 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionTrackingModel.h"
+
+// toolkit headers
+#include "CoordinateConversionOptions.h"
+#include "CoordinateFormatFactory.h"
+#include "ToolkitProfiler.h"
+
+// C++ API headers
+#include "AttributeListModel.h"
+#include "Graphic.h"
+#include "GraphicListModel.h"
+#include "GraphicsOverlay.h"
+
+// Qt headers
+#include <QSet>
+
+// STL headers
+#include <algorithm>
+#include <utility>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// compares the coordinates directly, which is cheaper than comparing the geometries
+bool samePosition(const Point& a, const Point& b)
+{
+  return a.x() == b.x() && a.y() == b.y() && a.z() == b.z() &&
+         a.spatialReference().wkid() == b.spatialReference().wkid();
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionTrackingModel
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief A table model of the notations of many tracked points.
+
+  Each row is a point identified by a key, such as an asset ID, and each
+  column is one of the model's CoordinateConversionOptions. The points are
+  set together with \l updatePoints or \l updateFromGraphicsOverlay, or one
+  at a time with \l setPoint.
+
+  An update only converts the rows which are new or whose point moved since
+  the last update, and reports \c dataChanged for just those rows, so the
+  cost of a refresh grows with the number of points which moved rather than
+  with the number tracked.
+
+  The display role of each cell is its notation, and the format names are
+  the horizontal header. The following roles are also available for views
+  which only show a list:
+  \table
+    \header
+        \li Role
+        \li Type
+        \li Description
+    \row
+        \li key
+        \li QString
+        \li The key of the tracked point.
+    \row
+        \li x
+        \li double
+        \li The x coordinate of the point.
+    \row
+        \li y
+        \li double
+        \li The y coordinate of the point.
+    \row
+        \li notations
+        \li QStringList
+        \li The notations of the point, in the order of \l coordinateFormats.
+  \endtable
+
+  \sa CoordinateConversionController
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent object.
+ */
+CoordinateConversionTrackingModel::CoordinateConversionTrackingModel(QObject* parent) :
+  QAbstractTableModel(parent)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+CoordinateConversionTrackingModel::~CoordinateConversionTrackingModel()
+{
+}
+
+/*!
+  \brief Adds a column for \a option, converting every tracked point to it.
+
+  When \a option is edited its column is converted again.
+ */
+void CoordinateConversionTrackingModel::addOption(CoordinateConversionOptions* option)
+{
+  if (!option || m_options.contains(option))
+    return;
+
+  const int column = m_options.size();
+  beginInsertColumns(QModelIndex(), column, column);
+
+  m_options.append(option);
+  m_parameters.append(CoordinateConversionParameters(option));
+  const CoordinateConversionParameters& parameters = m_parameters.last();
+  for (TrackedRow& row : m_rows)
+    row.notations.append(parameters.toNotation(row.point));
+
+  endInsertColumns();
+
+  const auto refresh = [this, option]()
+  {
+    refreshOption(option);
+  };
+
+  connect(option, &CoordinateConversionOptions::nameChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::outputModeChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::addSpacesChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::precisionChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::decimalPlacesChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::mgrsConversionModeChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::latLonFormatChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::utmConversionModeChanged, this, refresh);
+  connect(option, &CoordinateConversionOptions::garsConversionModeChanged, this, refresh);
+  connect(option, &QObject::destroyed, this, [this, option]()
+  {
+    removeOption(option);
+  });
+
+  emit coordinateFormatsChanged();
+}
+
+/*!
+  \brief Adds a column for the registered format \a formatName.
+
+  \sa CoordinateFormatRegistry
+ */
+void CoordinateConversionTrackingModel::addCoordinateFormat(const QString& formatName)
+{
+  if (coordinateFormats().contains(formatName))
+    return;
+
+  CoordinateConversionOptions* option = CoordinateFormatFactory::createFormat(formatName, this);
+  if (!option)
+  {
+    qWarning("Unknown coordinate format %s", qPrintable(formatName));
+    return;
+  }
+
+  addOption(option);
+}
+
+/*!
+  \brief Removes all the columns.
+ */
+void CoordinateConversionTrackingModel::clearOptions()
+{
+  if (m_options.isEmpty())
+    return;
+
+  beginRemoveColumns(QModelIndex(), 0, m_options.size() - 1);
+
+  for (CoordinateConversionOptions* option : m_options)
+    disconnect(option, nullptr, this, nullptr);
+
+  m_options.clear();
+  m_parameters.clear();
+  for (TrackedRow& row : m_rows)
+    row.notations.clear();
+
+  endRemoveColumns();
+
+  emit coordinateFormatsChanged();
+}
+
+/*!
+  \property CoordinateConversionTrackingModel::coordinateFormats
+  \brief The names of the formats, in column order.
+ */
+QStringList CoordinateConversionTrackingModel::coordinateFormats() const
+{
+  QStringList formatNames;
+  formatNames.reserve(m_parameters.size());
+  for (const CoordinateConversionParameters& parameters : m_parameters)
+    formatNames.append(parameters.m_name);
+
+  return formatNames;
+}
+
+/*!
+  \brief Tracks exactly the \a points, keyed by their identifiers.
+
+  Rows for keys which are not in \a points are removed, and new keys are
+  added as rows at the end, in key order. Only the new rows and the rows
+  whose point moved are converted.
+ */
+void CoordinateConversionTrackingModel::updatePoints(const QHash<QString, Point>& points)
+{
+  TrackedPoints trackedPoints;
+  trackedPoints.reserve(points.size());
+  for (auto it = points.constBegin(); it != points.constEnd(); ++it)
+    trackedPoints.append(qMakePair(it.key(), it.value()));
+
+  // QHash has no stable order, so new rows are added in key order instead
+  std::sort(trackedPoints.begin(), trackedPoints.end(), [](const TrackedPoints::value_type& a, const TrackedPoints::value_type& b)
+  {
+    return a.first < b.first;
+  });
+
+  updatePointsInternal(trackedPoints);
+}
+
+/*!
+  \brief Tracks exactly the point graphics of \a graphicsOverlay, which must
+  be a GraphicsOverlay.
+
+  Each graphic is keyed by the value of its \a keyAttribute attribute. If
+  \a keyAttribute is empty, each graphic is keyed by its identity instead.
+  Graphics without a point geometry or a key are skipped. New graphics are
+  added as rows in the order of the overlay.
+ */
+void CoordinateConversionTrackingModel::updateFromGraphicsOverlay(QObject* graphicsOverlay, const QString& keyAttribute)
+{
+  auto overlay = qobject_cast<GraphicsOverlay*>(graphicsOverlay);
+  if (!overlay)
+  {
+    qWarning("updateFromGraphicsOverlay requires a GraphicsOverlay");
+    return;
+  }
+
+  GraphicListModel* graphics = overlay->graphics();
+  if (!graphics)
+    return;
+
+  TrackedPoints trackedPoints;
+  trackedPoints.reserve(graphics->size());
+  for (int i = 0; i < graphics->size(); ++i)
+  {
+    Graphic* graphic = graphics->at(i);
+    if (!graphic)
+      continue;
+
+    const Geometry geometry = graphic->geometry();
+    if (geometry.isEmpty() || geometry.geometryType() != GeometryType::Point)
+      continue;
+
+    const QString key = keyAttribute.isEmpty() ? QString::number(reinterpret_cast<quintptr>(graphic), 16)
+                                               : graphic->attributes()->attributeValue(keyAttribute).toString();
+    if (key.isEmpty())
+      continue;
+
+    trackedPoints.append(qMakePair(key, Point(geometry)));
+  }
+
+  updatePointsInternal(trackedPoints);
+}
+
+/*!
+  \brief Tracks \a point under \a key, adding a row if \a key is new.
+
+  The row is only converted if \a point differs from its last point.
+ */
+void CoordinateConversionTrackingModel::setPoint(const QString& key, const Point& point)
+{
+  const auto it = m_rowByKey.constFind(key);
+  if (it == m_rowByKey.constEnd())
+  {
+    TrackedRow row;
+    row.key = key;
+    row.point = point;
+    convertRow(row);
+
+    const int rowIndex = m_rows.size();
+    beginInsertRows(QModelIndex(), rowIndex, rowIndex);
+    m_rows.append(row);
+    m_rowByKey.insert(key, rowIndex);
+    endInsertRows();
+
+    m_lastUpdateConversions = 1;
+    emit countChanged();
+    emit updated(m_lastUpdateConversions);
+    return;
+  }
+
+  TrackedRow& row = m_rows[it.value()];
+  if (samePosition(row.point, point))
+  {
+    m_lastUpdateConversions = 0;
+    emit updated(m_lastUpdateConversions);
+    return;
+  }
+
+  row.point = point;
+  convertRow(row);
+  emit dataChanged(index(it.value(), 0), index(it.value(), qMax(0, columnCount() - 1)));
+
+  m_lastUpdateConversions = 1;
+  emit updated(m_lastUpdateConversions);
+}
+
+/*!
+  \brief Stops tracking the point under \a key.
+ */
+void CoordinateConversionTrackingModel::removePoint(const QString& key)
+{
+  const int row = rowOf(key);
+  if (row == -1)
+    return;
+
+  beginRemoveRows(QModelIndex(), row, row);
+  m_rows.remove(row);
+  endRemoveRows();
+
+  rebuildKeyIndex();
+  emit countChanged();
+}
+
+/*!
+  \brief Stops tracking all points.
+ */
+void CoordinateConversionTrackingModel::clear()
+{
+  if (m_rows.isEmpty())
+    return;
+
+  beginResetModel();
+  m_rows.clear();
+  m_rowByKey.clear();
+  endResetModel();
+
+  emit countChanged();
+}
+
+/*!
+  \brief Returns the row of the point tracked under \a key, or \c -1.
+ */
+int CoordinateConversionTrackingModel::rowOf(const QString& key) const
+{
+  return m_rowByKey.value(key, -1);
+}
+
+/*!
+  \brief Returns the notation in the format \a formatName of the point
+  tracked under \a key, or an empty string.
+ */
+QString CoordinateConversionTrackingModel::notation(const QString& key, const QString& formatName) const
+{
+  const int row = rowOf(key);
+  if (row == -1)
+    return QString();
+
+  const int column = coordinateFormats().indexOf(formatName);
+  if (column == -1)
+    return QString();
+
+  return m_rows.at(row).notations.value(column);
+}
+
+/*!
+  \property CoordinateConversionTrackingModel::count
+  \brief The number of tracked points.
+ */
+int CoordinateConversionTrackingModel::count() const
+{
+  return m_rows.size();
+}
+
+/*!
+  \property CoordinateConversionTrackingModel::lastUpdateConversions
+  \brief The number of rows converted by the last update.
+ */
+int CoordinateConversionTrackingModel::lastUpdateConversions() const
+{
+  return m_lastUpdateConversions;
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionTrackingModel::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : m_rows.size();
+}
+
+/*!
+  \internal
+ */
+int CoordinateConversionTrackingModel::columnCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : m_parameters.size();
+}
+
+/*!
+  \internal
+ */
+QVariant CoordinateConversionTrackingModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size())
+    return QVariant();
+
+  const TrackedRow& row = m_rows.at(index.row());
+  switch (role)
+  {
+  case Qt::DisplayRole:
+    return row.notations.value(index.column());
+  case KeyRole:
+    return row.key;
+  case XRole:
+    return row.point.x();
+  case YRole:
+    return row.point.y();
+  case NotationsRole:
+    return QStringList(row.notations.toList());
+  default:
+    return QVariant();
+  }
+}
+
+/*!
+  \internal
+ */
+QVariant CoordinateConversionTrackingModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (role != Qt::DisplayRole)
+    return QVariant();
+
+  if (orientation == Qt::Vertical)
+    return section >= 0 && section < m_rows.size() ? m_rows.at(section).key : QVariant();
+
+  return section >= 0 && section < m_parameters.size() ? m_parameters.at(section).m_name : QVariant();
+}
+
+/*!
+  \internal
+ */
+QHash<int, QByteArray> CoordinateConversionTrackingModel::roleNames() const
+{
+  return {
+    {Qt::DisplayRole, "display"},
+    {KeyRole, "key"},
+    {XRole, "x"},
+    {YRole, "y"},
+    {NotationsRole, "notations"}
+  };
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionTrackingModel::updatePointsInternal(const TrackedPoints& points)
+{
+  TOOLKIT_PROFILE_SCOPE("CoordinateConversionTrackingModel::updatePoints");
+
+  const int previousCount = m_rows.size();
+
+  // drop the rows whose keys are no longer tracked
+  QSet<QString> keys;
+  keys.reserve(points.size());
+  for (const auto& point : points)
+    keys.insert(point.first);
+
+  std::vector<bool> removed(m_rows.size(), false);
+  bool anyRemoved = false;
+  for (int row = 0; row < m_rows.size(); ++row)
+  {
+    removed[row] = !keys.contains(m_rows.at(row).key);
+    anyRemoved = anyRemoved || removed[row];
+  }
+
+  if (anyRemoved)
+    removeMarkedRows(removed);
+
+  // convert the rows which moved, and collect the new ones
+  QVector<int> changedRows;
+  QVector<TrackedRow> newRows;
+  QHash<QString, int> newRowByKey;
+  for (const auto& point : points)
+  {
+    const auto existing = m_rowByKey.constFind(point.first);
+    if (existing != m_rowByKey.constEnd())
+    {
+      TrackedRow& row = m_rows[existing.value()];
+      if (samePosition(row.point, point.second))
+        continue;
+
+      row.point = point.second;
+      convertRow(row);
+      changedRows.append(existing.value());
+      continue;
+    }
+
+    // a key repeated within the update keeps its last point
+    const auto added = newRowByKey.constFind(point.first);
+    if (added != newRowByKey.constEnd())
+    {
+      newRows[added.value()].point = point.second;
+      continue;
+    }
+
+    newRowByKey.insert(point.first, newRows.size());
+    TrackedRow row;
+    row.key = point.first;
+    row.point = point.second;
+    newRows.append(row);
+  }
+
+  m_lastUpdateConversions = changedRows.size() + newRows.size();
+  emitRowsChanged(changedRows);
+
+  if (!newRows.isEmpty())
+  {
+    for (TrackedRow& row : newRows)
+      convertRow(row);
+
+    const int firstRow = m_rows.size();
+    beginInsertRows(QModelIndex(), firstRow, firstRow + newRows.size() - 1);
+    m_rows.reserve(firstRow + newRows.size());
+    for (TrackedRow& row : newRows)
+    {
+      m_rowByKey.insert(row.key, m_rows.size());
+      m_rows.append(std::move(row));
+    }
+    endInsertRows();
+  }
+
+  if (m_rows.size() != previousCount || anyRemoved)
+    emit countChanged();
+
+  emit updated(m_lastUpdateConversions);
+}
+
+/*!
+  \internal
+
+  Removes the \a marked rows, one run of consecutive rows at a time.
+ */
+void CoordinateConversionTrackingModel::removeMarkedRows(const std::vector<bool>& marked)
+{
+  int row = static_cast<int>(marked.size()) - 1;
+  while (row >= 0)
+  {
+    if (!marked[row])
+    {
+      --row;
+      continue;
+    }
+
+    const int lastRow = row;
+    while (row > 0 && marked[row - 1])
+      --row;
+
+    beginRemoveRows(QModelIndex(), row, lastRow);
+    m_rows.remove(row, lastRow - row + 1);
+    endRemoveRows();
+
+    --row;
+  }
+
+  rebuildKeyIndex();
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionTrackingModel::rebuildKeyIndex()
+{
+  m_rowByKey.clear();
+  m_rowByKey.reserve(m_rows.size());
+  for (int row = 0; row < m_rows.size(); ++row)
+    m_rowByKey.insert(m_rows.at(row).key, row);
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionTrackingModel::convertRow(TrackedRow& row) const
+{
+  row.notations.resize(m_parameters.size());
+  for (int column = 0; column < m_parameters.size(); ++column)
+    row.notations[column] = m_parameters.at(column).toNotation(row.point);
+}
+
+/*!
+  \internal
+
+  Emits \c dataChanged for the \a rows, one run of consecutive rows at a time.
+ */
+void CoordinateConversionTrackingModel::emitRowsChanged(QVector<int>& rows)
+{
+  if (rows.isEmpty() || m_parameters.isEmpty())
+    return;
+
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+  const int lastColumn = m_parameters.size() - 1;
+  int firstRow = rows.first();
+  int previousRow = firstRow;
+  for (int i = 1; i < rows.size(); ++i)
+  {
+    if (rows.at(i) == previousRow + 1)
+    {
+      previousRow = rows.at(i);
+      continue;
+    }
+
+    emit dataChanged(index(firstRow, 0), index(previousRow, lastColumn));
+    firstRow = previousRow = rows.at(i);
+  }
+
+  emit dataChanged(index(firstRow, 0), index(previousRow, lastColumn));
+}
+
+/*!
+  \internal
+
+  Converts every row again to the edited \a option.
+ */
+void CoordinateConversionTrackingModel::refreshOption(CoordinateConversionOptions* option)
+{
+  const int column = m_options.indexOf(option);
+  if (column == -1)
+    return;
+
+  const bool renamed = m_parameters.at(column).m_name != option->name();
+  m_parameters[column] = CoordinateConversionParameters(option);
+
+  const CoordinateConversionParameters& parameters = m_parameters.at(column);
+  for (TrackedRow& row : m_rows)
+    row.notations[column] = parameters.toNotation(row.point);
+
+  if (!m_rows.isEmpty())
+    emit dataChanged(index(0, column), index(m_rows.size() - 1, column));
+
+  if (renamed)
+  {
+    emit headerDataChanged(Qt::Horizontal, column, column);
+    emit coordinateFormatsChanged();
+  }
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionTrackingModel::removeOption(CoordinateConversionOptions* option)
+{
+  const int column = m_options.indexOf(option);
+  if (column == -1)
+    return;
+
+  beginRemoveColumns(QModelIndex(), column, column);
+  m_options.removeAt(column);
+  m_parameters.removeAt(column);
+  for (TrackedRow& row : m_rows)
+    row.notations.remove(column);
+  endRemoveColumns();
+
+  emit coordinateFormatsChanged();
+}
+
+/*!
+  \fn void CoordinateConversionTrackingModel::coordinateFormatsChanged()
+  \brief Signal emitted when the \l coordinateFormats property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionTrackingModel::countChanged()
+  \brief Signal emitted when the \l count property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionTrackingModel::updated(int conversions)
+  \brief Signal emitted when an update has finished, having converted
+  \a conversions rows.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -17,8 +17,8 @@
 #include "CoordinateFormatFactory.h"
 
 // toolkit headers
-#include "CoordinateConversionConstants.h"
 #include "CoordinateConversionOptions.h"
+#include "CoordinateFormatRegistry.h"
 
 // C++ API headers
 #include "GeodatabaseTypes.h"
@@ -43,52 +43,14 @@ GarsConversionMode CoordinateFormatFactory::GARS_CONVERSION_MODE = GarsConversio
 
 CoordinateConversionOptions* CoordinateFormatFactory::createFormat(const QString& formatName, QObject* parent)
 {
+  auto& registry = CoordinateFormatRegistry::instance();
+  const int formatId = registry.formatId(formatName);
+  if (!registry.isRegistered(formatId))
+    return nullptr;
+
   CoordinateConversionOptions* option = new CoordinateConversionOptions(parent);
   option->setName(formatName);
-
-  if (formatName.compare(CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
-    option->setLatLonFormat(LatitudeLongitudeFormat::DegreesDecimalMinutes);
-  }
-  else if (formatName.compare(CoordinateConversionConstants::USNG_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng);
-    option->setPrecision(usngPrecision());
-    option->setAddSpaces(usngUseSpaces());
-  }
-  else if (formatName.compare(CoordinateConversionConstants::UTM_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm);
-    option->setUtmConversionMode(utmConversioMode());
-    option->setAddSpaces(utmUseSpaces());
-  }
-  else if (formatName.compare(CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
-    option->setLatLonFormat(LatitudeLongitudeFormat::DegreesMinutesSeconds);
-    option->setDecimalPlaces(degreesMinutesSecondsDecimalPlaces());
-  }
-  else if (formatName.compare(CoordinateConversionConstants::MGRS_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs);
-    option->setMgrsConversionMode(mgrsConversionMode());
-  }
-  else if (formatName.compare(CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
-    option->setLatLonFormat(LatitudeLongitudeFormat::DecimalDegrees);
-  }
-  else if (formatName.compare(CoordinateConversionConstants::GARS_FORMAT, Qt::CaseInsensitive) == 0)
-  {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeGars);
-    option->setGarsConversionMode(garsConversionMode());
-  }
-  else
-  {
-    delete option;
-    return nullptr;
-  }
+  registry.configure(formatId, option);
 
   return option;
 }
@@ -0,0 +1,321 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateFormatRegistry.h"
+
+// toolkit headers
+#include "CoordinateConversionConstants.h"
+#include "CoordinateConversionOptions.h"
+#include "CoordinateFormatFactory.h"
+
+// Qt headers
+#include <QReadLocker>
+#include <QWriteLocker>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateFormatRegistry
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief The set of coordinate formats known to the coordinate conversion tool.
+
+  Each built-in format has an integer id, and a custom format is given one
+  when it is registered. Looking up a name which is neither never adds it.
+  Names are compared without regard to case, so \c "mgrs" and \c "MGRS"
+  share an id.
+  The \l CoordinateConversionController compares these ids rather than the
+  names themselves.
+
+  The registry contains the formats listed in \l CoordinateConversionConstants.
+  Applications can add their own formats, such as a national grid, with
+  \l registerFormat. Custom formats should be registered before the
+  \l CoordinateConversionController is created so they appear in its list of
+  coordinate formats.
+
+  \sa {Coordinate Conversion Tool}
+ */
+
+/*!
+  \typedef CoordinateFormatRegistry::Formatter
+  \brief A function which returns the notation for a point.
+ */
+
+/*!
+  \typedef CoordinateFormatRegistry::Parser
+  \brief A function which returns the point, in the given spatial reference,
+  described by a notation.
+ */
+
+/*!
+  \variable CoordinateFormatRegistry::InvalidFormatId
+  \brief The id returned for a format name which is not known to the registry.
+ */
+constexpr int CoordinateFormatRegistry::InvalidFormatId;
+
+/*!
+  \brief Returns the singleton instance of the registry.
+ */
+CoordinateFormatRegistry& CoordinateFormatRegistry::instance()
+{
+  static CoordinateFormatRegistry instance;
+
+  return instance;
+}
+
+/*!
+  \internal
+ */
+CoordinateFormatRegistry::CoordinateFormatRegistry()
+{
+  registerBuiltInFormat(CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
+    option->setLatLonFormat(LatitudeLongitudeFormat::DecimalDegrees);
+  });
+
+  registerBuiltInFormat(CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
+    option->setLatLonFormat(LatitudeLongitudeFormat::DegreesDecimalMinutes);
+  });
+
+  registerBuiltInFormat(CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
+    option->setLatLonFormat(LatitudeLongitudeFormat::DegreesMinutesSeconds);
+    option->setDecimalPlaces(CoordinateFormatFactory::degreesMinutesSecondsDecimalPlaces());
+  });
+
+  registerBuiltInFormat(CoordinateConversionConstants::MGRS_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs);
+    option->setMgrsConversionMode(CoordinateFormatFactory::mgrsConversionMode());
+  });
+
+  registerBuiltInFormat(CoordinateConversionConstants::USNG_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng);
+    option->setPrecision(CoordinateFormatFactory::usngPrecision());
+    option->setAddSpaces(CoordinateFormatFactory::usngUseSpaces());
+  });
+
+  registerBuiltInFormat(CoordinateConversionConstants::UTM_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm);
+    option->setUtmConversionMode(CoordinateFormatFactory::utmConversioMode());
+    option->setAddSpaces(CoordinateFormatFactory::utmUseSpaces());
+  });
+
+  registerBuiltInFormat(CoordinateConversionConstants::GARS_FORMAT, [](CoordinateConversionOptions* option)
+  {
+    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeGars);
+    option->setGarsConversionMode(CoordinateFormatFactory::garsConversionMode());
+  });
+}
+
+/*!
+  \brief The destructor.
+ */
+CoordinateFormatRegistry::~CoordinateFormatRegistry()
+{
+}
+
+/*!
+  \brief Returns the id for \a formatName.
+
+  Returns \l InvalidFormatId if \a formatName is neither a built-in format
+  nor a registered one. Looking a name up never adds it to the registry.
+ */
+int CoordinateFormatRegistry::formatId(const QString& formatName) const
+{
+  if (formatName.isEmpty())
+    return InvalidFormatId;
+
+  QReadLocker locker(&m_lock);
+  return m_ids.value(formatName.toCaseFolded(), InvalidFormatId);
+}
+
+/*!
+  \brief Returns the name for \a formatId, as it was given when the format was
+  added to the registry.
+ */
+QString CoordinateFormatRegistry::formatName(int formatId) const
+{
+  QReadLocker locker(&m_lock);
+  if (formatId < 0 || formatId >= m_entries.size())
+    return QString();
+
+  return m_entries.at(formatId).m_name;
+}
+
+/*!
+  \brief Returns whether a format has been registered for \a formatId.
+ */
+bool CoordinateFormatRegistry::isRegistered(int formatId) const
+{
+  QReadLocker locker(&m_lock);
+  if (formatId < 0 || formatId >= m_entries.size())
+    return false;
+
+  return m_entries.at(formatId).m_registered;
+}
+
+/*!
+  \brief Returns the names of the registered formats, in the order they were registered.
+ */
+QStringList CoordinateFormatRegistry::formatNames() const
+{
+  QReadLocker locker(&m_lock);
+  QStringList names;
+  for (const Entry& entry : m_entries)
+  {
+    if (entry.m_registered)
+      names.append(entry.m_name);
+  }
+
+  return names;
+}
+
+/*!
+  \brief Registers the custom format \a formatName and returns its id.
+
+  \a formatter is used to convert points to the format and \a parser is used
+  to read notations in the format. Either may be empty if the format is only
+  used for output or for input. Registering a name which is already registered
+  replaces its functions.
+
+  Conversions can run on worker threads, so both functions must be safe to call
+  from any thread.
+ */
+int CoordinateFormatRegistry::registerFormat(const QString& formatName, Formatter formatter, Parser parser)
+{
+  if (formatName.isEmpty())
+  {
+    qWarning("A coordinate format cannot be registered without a name.");
+    return InvalidFormatId;
+  }
+
+  QWriteLocker locker(&m_lock);
+  const int id = formatIdInternal(formatName);
+  Entry& entry = m_entries[id];
+  entry.m_registered = true;
+  entry.m_formatter = std::move(formatter);
+  entry.m_parser = std::move(parser);
+  m_revision.ref();
+
+  return id;
+}
+
+/*!
+  \brief Returns a count which changes whenever a format is registered.
+
+  Anything which keeps the functions of a format, or the id of a name which
+  was not known, can compare the revision to know when to look them up again.
+ */
+int CoordinateFormatRegistry::revision() const
+{
+  return m_revision.loadAcquire();
+}
+
+/*!
+  \brief Returns the function used to convert points to the custom format
+  \a formatId, or an empty function for the built-in formats.
+ */
+CoordinateFormatRegistry::Formatter CoordinateFormatRegistry::formatter(int formatId) const
+{
+  QReadLocker locker(&m_lock);
+  if (formatId < 0 || formatId >= m_entries.size())
+    return Formatter();
+
+  return m_entries.at(formatId).m_formatter;
+}
+
+/*!
+  \brief Returns the function used to read notations in the custom format
+  \a formatId, or an empty function for the built-in formats.
+ */
+CoordinateFormatRegistry::Parser CoordinateFormatRegistry::parser(int formatId) const
+{
+  QReadLocker locker(&m_lock);
+  if (formatId < 0 || formatId >= m_entries.size())
+    return Parser();
+
+  return m_entries.at(formatId).m_parser;
+}
+
+/*!
+  \brief Applies the settings for the format \a formatId to \a option.
+ */
+void CoordinateFormatRegistry::configure(int formatId, CoordinateConversionOptions* option) const
+{
+  if (!option)
+    return;
+
+  Configure configure;
+  {
+    QReadLocker locker(&m_lock);
+    if (formatId < 0 || formatId >= m_entries.size())
+      return;
+
+    configure = m_entries.at(formatId).m_configure;
+  }
+
+  if (configure)
+    configure(option);
+}
+
+/*!
+  \internal
+ */
+void CoordinateFormatRegistry::registerBuiltInFormat(const QString& formatName, Configure configure)
+{
+  QWriteLocker locker(&m_lock);
+  Entry& entry = m_entries[formatIdInternal(formatName)];
+  entry.m_registered = true;
+  entry.m_configure = std::move(configure);
+}
+
+/*!
+  \internal
+
+  The write lock must be held.
+ */
+int CoordinateFormatRegistry::formatIdInternal(const QString& formatName)
+{
+  const QString key = formatName.toCaseFolded();
+  auto it = m_ids.constFind(key);
+  if (it != m_ids.constEnd())
+    return it.value();
+
+  const int id = m_entries.size();
+  Entry entry;
+  entry.m_name = formatName;
+  m_entries.append(entry);
+  m_ids.insert(key, id);
+
+  return id;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
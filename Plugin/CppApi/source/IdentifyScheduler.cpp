@@ -0,0 +1,453 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "IdentifyScheduler.h"
+#include "ToolResourceProvider.h"
+
+// C++ API headers
+#include "GeoView.h"
+#include "MapQuickView.h"
+#include "SceneQuickView.h"
+
+// Qt headers
+#include <QTimer>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::IdentifyScheduler
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief Manages identify requests on the view of a ToolResourceProvider.
+
+  Identify requests made in quick succession, such as repeated taps or
+  identifying on hover, are coalesced so that only the newest request in
+  each \l coalesceInterval is sent. Starting a request cancels the tasks of
+  older requests of the same kind, no more than \l maximumConcurrentTasks
+  tasks run at once, and only the result of the newest request is
+  delivered. Results of superseded requests are dropped.
+
+  A task which fails gives up its slot when the view reports the error, so
+  failures do not hold back later requests.
+
+  The scheduler listens for completed tasks on its resource provider, so
+  the view's identify signals must reach the provider. Per-view contexts
+  from \l {ToolResourceProvider::forGeoView}{forGeoView} forward them
+  automatically.
+
+  \note As with the view's own identify signals, the receiver of
+  \l identifyLayersCompleted and \l identifyGraphicsOverlaysCompleted is
+  responsible for the results. The scheduler never frees results itself,
+  whether delivered, superseded or cancelled, since other receivers of the
+  view's signals may still use them.
+ */
+
+/*!
+  \brief Constructs a scheduler for the view of \a resourceProvider, with an
+  optional \a parent.
+
+  If \a resourceProvider is \c nullptr the global
+  \l {ToolResourceProvider::instance}{ToolResourceProvider::instance()} is used.
+ */
+IdentifyScheduler::IdentifyScheduler(ToolResourceProvider* resourceProvider, QObject* parent) :
+  QObject(parent),
+  m_coalesceTimer(new QTimer(this)),
+  m_scheduler(RequestKindCount)
+{
+  // by default, requests made within about one display frame are merged
+  m_coalesceTimer->setSingleShot(true);
+  m_coalesceTimer->setInterval(16);
+  connect(m_coalesceTimer, &QTimer::timeout, this, &IdentifyScheduler::startPendingRequests);
+
+  setResourceProvider(resourceProvider);
+}
+
+/*!
+  \brief The destructor.
+
+  Any running tasks are cancelled.
+ */
+IdentifyScheduler::~IdentifyScheduler()
+{
+  cancel();
+}
+
+/*!
+  \brief Returns the resource provider whose view is identified.
+ */
+ToolResourceProvider* IdentifyScheduler::resourceProvider() const
+{
+  return m_resourceProvider ? m_resourceProvider.data() : ToolResourceProvider::instance();
+}
+
+/*!
+  \brief Sets the resource provider whose view is identified to \a resourceProvider.
+
+  Requests for the previous provider are cancelled.
+ */
+void IdentifyScheduler::setResourceProvider(ToolResourceProvider* resourceProvider)
+{
+  cancel();
+
+  for (const auto& connection : qAsConst(m_providerConnections))
+    disconnect(connection);
+  m_providerConnections.clear();
+
+  m_resourceProvider = resourceProvider;
+
+  ToolResourceProvider* provider = this->resourceProvider();
+  m_providerConnections.append(connect(provider, &ToolResourceProvider::identifyLayersCompleted,
+                                       this, &IdentifyScheduler::onIdentifyLayersCompleted));
+  m_providerConnections.append(connect(provider, &ToolResourceProvider::identifyGraphicsOverlaysCompleted,
+                                       this, &IdentifyScheduler::onIdentifyGraphicsOverlaysCompleted));
+  m_providerConnections.append(connect(provider, &ToolResourceProvider::geoViewChanged, this, [this]()
+  {
+    cancel();
+    connectGeoView();
+  }));
+
+  connectGeoView();
+}
+
+/*!
+  \brief Requests an identify of the layers at \a screenPoint.
+
+  \sa identifyLayersCompleted
+ */
+void IdentifyScheduler::identifyLayers(const QPointF& screenPoint)
+{
+  request(LayersRequest, screenPoint);
+}
+
+/*!
+  \brief Requests an identify of the graphics overlays at \a screenPoint.
+
+  \sa identifyGraphicsOverlaysCompleted
+ */
+void IdentifyScheduler::identifyGraphicsOverlays(const QPointF& screenPoint)
+{
+  request(GraphicsOverlaysRequest, screenPoint);
+}
+
+/*!
+  \brief Cancels every pending request and running task.
+ */
+void IdentifyScheduler::cancel()
+{
+  m_coalesceTimer->stop();
+  m_scheduler.cancel();
+  updateBusy();
+}
+
+/*!
+  \property IdentifyScheduler::busy
+  \brief Whether any request is pending or any task is running.
+ */
+bool IdentifyScheduler::isBusy() const
+{
+  return m_busy;
+}
+
+/*!
+  \property IdentifyScheduler::maximumConcurrentTasks
+  \brief The maximum number of identify tasks that run at once.
+
+  A request which would exceed this number waits for a running task to
+  finish. The default is \c 2.
+ */
+int IdentifyScheduler::maximumConcurrentTasks() const
+{
+  return m_scheduler.maximumConcurrentTasks();
+}
+
+void IdentifyScheduler::setMaximumConcurrentTasks(int maximumConcurrentTasks)
+{
+  maximumConcurrentTasks = qMax(1, maximumConcurrentTasks);
+  if (maximumConcurrentTasks == m_scheduler.maximumConcurrentTasks())
+    return;
+
+  m_scheduler.setMaximumConcurrentTasks(maximumConcurrentTasks);
+  emit maximumConcurrentTasksChanged();
+
+  startPendingRequests();
+}
+
+/*!
+  \property IdentifyScheduler::coalesceInterval
+  \brief The time in milliseconds within which requests are merged into
+  the newest one.
+
+  The default is \c 16, about one display frame.
+ */
+int IdentifyScheduler::coalesceInterval() const
+{
+  return m_coalesceTimer->interval();
+}
+
+void IdentifyScheduler::setCoalesceInterval(int coalesceInterval)
+{
+  coalesceInterval = qMax(0, coalesceInterval);
+  if (coalesceInterval == m_coalesceTimer->interval())
+    return;
+
+  m_coalesceTimer->setInterval(coalesceInterval);
+  emit coalesceIntervalChanged();
+}
+
+/*!
+  \property IdentifyScheduler::tolerance
+  \brief The tolerance in device-independent pixels passed to the identify.
+
+  The default is \c 12.
+ */
+double IdentifyScheduler::tolerance() const
+{
+  return m_tolerance;
+}
+
+void IdentifyScheduler::setTolerance(double tolerance)
+{
+  if (tolerance == m_tolerance)
+    return;
+
+  m_tolerance = tolerance;
+  emit toleranceChanged();
+}
+
+/*!
+  \property IdentifyScheduler::returnPopupsOnly
+  \brief Whether the identify only returns popups.
+
+  The default is \c false.
+ */
+bool IdentifyScheduler::returnPopupsOnly() const
+{
+  return m_returnPopupsOnly;
+}
+
+void IdentifyScheduler::setReturnPopupsOnly(bool returnPopupsOnly)
+{
+  if (returnPopupsOnly == m_returnPopupsOnly)
+    return;
+
+  m_returnPopupsOnly = returnPopupsOnly;
+  emit returnPopupsOnlyChanged();
+}
+
+/*!
+  \property IdentifyScheduler::maximumResults
+  \brief The maximum number of results per layer or graphics overlay.
+
+  The default is \c 1.
+ */
+int IdentifyScheduler::maximumResults() const
+{
+  return m_maximumResults;
+}
+
+void IdentifyScheduler::setMaximumResults(int maximumResults)
+{
+  if (maximumResults == m_maximumResults)
+    return;
+
+  m_maximumResults = maximumResults;
+  emit maximumResultsChanged();
+}
+
+/*!
+  \internal
+
+  Replaces any pending request of the same \a kind with one at \a screenPoint.
+ */
+void IdentifyScheduler::request(RequestKind kind, const QPointF& screenPoint)
+{
+  m_screenPoints[kind] = screenPoint;
+  m_scheduler.request(kind);
+
+  if (!m_coalesceTimer->isActive())
+    m_coalesceTimer->start();
+
+  updateBusy();
+}
+
+/*!
+  \internal
+
+  Starts the pending requests for which there is room.
+ */
+void IdentifyScheduler::startPendingRequests()
+{
+  GeoView* geoView = resourceProvider()->geoView();
+
+  // failed tasks whose error has not been reported yet still hold a slot
+  m_scheduler.removeFinishedTasks();
+
+  m_scheduler.startPendingRequests([this, geoView](int kind, QPointF& screenPoint) -> TaskWatcher
+  {
+    if (!geoView)
+      return TaskWatcher();
+
+    screenPoint = m_screenPoints[kind];
+    return kind == LayersRequest
+        ? geoView->identifyLayers(screenPoint.x(), screenPoint.y(), m_tolerance, m_returnPopupsOnly, m_maximumResults)
+        : geoView->identifyGraphicsOverlays(screenPoint.x(), screenPoint.y(), m_tolerance, m_returnPopupsOnly, m_maximumResults);
+  });
+
+  updateBusy();
+}
+
+/*!
+  \internal
+
+  Listens for the errors of the view of the resource provider, which is
+  how failed identify tasks are reported.
+ */
+void IdentifyScheduler::connectGeoView()
+{
+  for (const auto& connection : qAsConst(m_viewConnections))
+    disconnect(connection);
+  m_viewConnections.clear();
+
+  GeoView* geoView = resourceProvider()->geoView();
+  if (auto mapView = dynamic_cast<MapQuickView*>(geoView))
+  {
+    m_viewConnections.append(connect(mapView, &MapQuickView::errorOccurred, this, [this]()
+    {
+      onErrorOccurred();
+    }));
+  }
+  else if (auto sceneView = dynamic_cast<SceneQuickView*>(geoView))
+  {
+    m_viewConnections.append(connect(sceneView, &SceneQuickView::errorOccurred, this, [this]()
+    {
+      onErrorOccurred();
+    }));
+  }
+}
+
+/*!
+  \internal
+
+  The error does not say which task failed, so every finished task gives up
+  its slot.
+ */
+void IdentifyScheduler::onErrorOccurred()
+{
+  m_scheduler.removeFinishedTasks();
+  startPendingRequests();
+}
+
+/*!
+  \internal
+ */
+void IdentifyScheduler::onIdentifyLayersCompleted(QUuid taskId, QList<IdentifyLayerResult*> identifyResults)
+{
+  Scheduler::Task task;
+  if (!m_scheduler.takeTask(taskId, task))
+    return;
+
+  // the slot is free again, and a waiting request may use it
+  startPendingRequests();
+
+  // other receivers of the view's signal may use the results, so they are not freed here
+  if (!m_scheduler.isNewest(task))
+    return;
+
+  emit identifyLayersCompleted(task.data, identifyResults);
+}
+
+/*!
+  \internal
+ */
+void IdentifyScheduler::onIdentifyGraphicsOverlaysCompleted(QUuid taskId, QList<IdentifyGraphicsOverlayResult*> identifyResults)
+{
+  Scheduler::Task task;
+  if (!m_scheduler.takeTask(taskId, task))
+    return;
+
+  // the slot is free again, and a waiting request may use it
+  startPendingRequests();
+
+  // other receivers of the view's signal may use the results, so they are not freed here
+  if (!m_scheduler.isNewest(task))
+    return;
+
+  emit identifyGraphicsOverlaysCompleted(task.data, identifyResults);
+}
+
+/*!
+  \internal
+ */
+void IdentifyScheduler::updateBusy()
+{
+  const bool busy = m_scheduler.isBusy();
+  if (busy == m_busy)
+    return;
+
+  m_busy = busy;
+  emit busyChanged();
+}
+
+/*!
+  \fn void IdentifyScheduler::identifyLayersCompleted(const QPointF& screenPoint, QList<Esri::ArcGISRuntime::IdentifyLayerResult*> identifyResults)
+  \brief Signal emitted with the \a identifyResults of the newest layer
+  identify, made at \a screenPoint.
+ */
+
+/*!
+  \fn void IdentifyScheduler::identifyGraphicsOverlaysCompleted(const QPointF& screenPoint, QList<Esri::ArcGISRuntime::IdentifyGraphicsOverlayResult*> identifyResults)
+  \brief Signal emitted with the \a identifyResults of the newest graphics
+  overlay identify, made at \a screenPoint.
+ */
+
+/*!
+  \fn void IdentifyScheduler::busyChanged()
+  \brief Signal emitted when the \l busy property changes.
+ */
+
+/*!
+  \fn void IdentifyScheduler::maximumConcurrentTasksChanged()
+  \brief Signal emitted when the \l maximumConcurrentTasks property changes.
+ */
+
+/*!
+  \fn void IdentifyScheduler::coalesceIntervalChanged()
+  \brief Signal emitted when the \l coalesceInterval property changes.
+ */
+
+/*!
+  \fn void IdentifyScheduler::toleranceChanged()
+  \brief Signal emitted when the \l tolerance property changes.
+ */
+
+/*!
+  \fn void IdentifyScheduler::returnPopupsOnlyChanged()
+  \brief Signal emitted when the \l returnPopupsOnly property changes.
+ */
+
+/*!
+  \fn void IdentifyScheduler::maximumResultsChanged()
+  \brief Signal emitted when the \l maximumResults property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
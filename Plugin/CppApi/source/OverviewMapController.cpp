@@ -0,0 +1,392 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "OverviewMapController.h"
+
+// toolkit headers
+#include "ToolManager.h"
+#include "ToolkitProfiler.h"
+#include "ViewpointObserver.h"
+
+// C++ API headers
+#include "GeometryEngine.h"
+#include "Graphic.h"
+#include "GraphicListModel.h"
+#include "GraphicsOverlay.h"
+#include "GraphicsOverlayListModel.h"
+#include "Map.h"
+#include "MapQuickView.h"
+#include "Polygon.h"
+#include "SimpleFillSymbol.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+bool isLoaded(Map* map)
+{
+  return map && map->loadStatus() == LoadStatus::Loaded;
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::OverviewMapController
+  \inmodule ArcGISQtToolkit
+  \brief The controller for an overview map which follows a main map view.
+  \since Esri::ArcGISRuntime 100.5
+
+  The overview shows the map around the main view at \l zoomRatio times its
+  scale, with everything outside the visible area of the main view shaded
+  in \l fillColor.
+
+  The shading is a single graphic whose geometry is replaced as the main
+  view moves. The visible area is read from the shared
+  \l ViewpointObserver of the main view, so the overview is updated at most
+  once per frame, and movements smaller than \l pixelThreshold are not
+  drawn at all.
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent object.
+ */
+OverviewMapController::OverviewMapController(QObject* parent) :
+  AbstractTool(parent)
+{
+  ToolManager::instance().addTool(this);
+
+  m_fillSymbol = new SimpleFillSymbol(SimpleFillSymbolStyle::Solid, m_fillColor, nullptr, this);
+  m_aoiOverlay = new GraphicsOverlay(this);
+  m_aoiGraphic = new Graphic(Geometry(), m_fillSymbol, this);
+  m_aoiOverlay->graphics()->append(m_aoiGraphic);
+}
+
+/*!
+  \brief The destructor.
+ */
+OverviewMapController::~OverviewMapController()
+{
+  // the overlay is a child of the controller, so the overview must not keep it
+  removeOverlayFromOverview();
+}
+
+/*!
+  \brief Sets the main map view which the overview follows to \a geoView.
+
+  \a geoView must be a MapQuickView.
+ */
+void OverviewMapController::setGeoView(QObject* geoView)
+{
+  if (!geoView || std::strcmp(geoView->metaObject()->className(), MapQuickView::staticMetaObject.className()) != 0)
+    return;
+
+  auto mapView = reinterpret_cast<MapQuickView*>(geoView);
+  if (mapView == m_mapView)
+    return;
+
+  for (const auto& connection : m_viewConnections)
+    disconnect(connection);
+  m_viewConnections.clear();
+
+  m_mapView = mapView;
+  m_drawnExtent = Envelope();
+
+  ViewpointObserver* observer = ViewpointObserver::forGeoView(m_mapView);
+  if (observer)
+  {
+    m_viewConnections.append(connect(observer, &ViewpointObserver::extentChanged, this, [this]()
+    {
+      updateAreaOfInterest(false);
+    }));
+  }
+
+  m_viewConnections.append(connect(m_mapView, &QObject::destroyed, this, [this]()
+  {
+    m_mapView = nullptr;
+    m_viewConnections.clear();
+    connectMaps();
+  }));
+
+  connectMaps();
+  updateAreaOfInterest(true);
+}
+
+/*!
+  \brief Sets the map view which shows the overview to \a overviewView.
+
+  \a overviewView must be a MapQuickView. The controller adds the graphics
+  overlay which shades the area outside the main view to it.
+ */
+void OverviewMapController::setOverviewView(QObject* overviewView)
+{
+  if (!overviewView || std::strcmp(overviewView->metaObject()->className(), MapQuickView::staticMetaObject.className()) != 0)
+    return;
+
+  auto mapView = reinterpret_cast<MapQuickView*>(overviewView);
+  if (mapView == m_overviewView)
+    return;
+
+  if (m_overviewView)
+  {
+    removeOverlayFromOverview();
+    disconnect(m_overviewConnection);
+  }
+
+  m_overviewView = mapView;
+  m_drawnExtent = Envelope();
+  m_overviewView->graphicsOverlays()->append(m_aoiOverlay);
+
+  m_overviewConnection = connect(m_overviewView, &QObject::destroyed, this, [this]()
+  {
+    m_overviewView = nullptr;
+    connectMaps();
+  });
+
+  connectMaps();
+  updateAreaOfInterest(true);
+}
+
+/*!
+  \brief Zooms the overview to the initial viewpoint of the main map.
+ */
+void OverviewMapController::zoomAll()
+{
+  if (!m_mapView || !m_overviewView || !m_mapView->map())
+    return;
+
+  m_overviewView->setViewpointRotation(0.0);
+  m_overviewView->setViewpointGeometry(m_mapView->map()->initialViewpoint().targetGeometry());
+}
+
+/*!
+  \brief Redraws the area of interest and recenters the overview, even if
+  the main view has not moved.
+ */
+void OverviewMapController::update()
+{
+  updateAreaOfInterest(true);
+}
+
+/*!
+  \property OverviewMapController::zoomRatio
+  \brief How many times larger the scale of the overview is than the scale
+  of the main view.
+
+  The default is \c 10.
+ */
+double OverviewMapController::zoomRatio() const
+{
+  return m_zoomRatio;
+}
+
+void OverviewMapController::setZoomRatio(double zoomRatio)
+{
+  if (zoomRatio == m_zoomRatio || zoomRatio <= 0.0)
+    return;
+
+  m_zoomRatio = zoomRatio;
+  emit zoomRatioChanged();
+  updateAreaOfInterest(true);
+}
+
+/*!
+  \property OverviewMapController::pixelThreshold
+  \brief The smallest movement of the visible area, in device independent
+  pixels of the overview, which is drawn.
+
+  The default is \c 1.0.
+ */
+double OverviewMapController::pixelThreshold() const
+{
+  return m_pixelThreshold;
+}
+
+void OverviewMapController::setPixelThreshold(double pixelThreshold)
+{
+  if (pixelThreshold == m_pixelThreshold)
+    return;
+
+  m_pixelThreshold = pixelThreshold;
+  emit pixelThresholdChanged();
+}
+
+/*!
+  \property OverviewMapController::fillColor
+  \brief The color used to shade the area outside the visible area of the
+  main view.
+
+  The default is black at 37.5% opacity.
+ */
+QColor OverviewMapController::fillColor() const
+{
+  return m_fillColor;
+}
+
+void OverviewMapController::setFillColor(const QColor& fillColor)
+{
+  if (fillColor == m_fillColor)
+    return;
+
+  m_fillColor = fillColor;
+  m_fillSymbol->setColor(m_fillColor);
+  emit fillColorChanged();
+}
+
+/*!
+  \brief Returns the name of this tool, \c "OverviewMap".
+ */
+QString OverviewMapController::toolName() const
+{
+  return "OverviewMap";
+}
+
+/*!
+  \internal
+
+  Draws the area of interest once both maps have loaded.
+ */
+void OverviewMapController::connectMaps()
+{
+  for (const auto& connection : m_mapConnections)
+    disconnect(connection);
+  m_mapConnections.clear();
+
+  const QList<MapQuickView*> views{m_mapView, m_overviewView};
+  for (MapQuickView* view : views)
+  {
+    Map* map = view ? view->map() : nullptr;
+    if (!map || isLoaded(map))
+      continue;
+
+    m_mapConnections.append(connect(map, &Map::doneLoading, this, [this]()
+    {
+      updateAreaOfInterest(true);
+    }));
+  }
+}
+
+/*!
+  \internal
+
+  Removes the area of interest overlay from the overview view, which would
+  otherwise keep a pointer to it once the controller has gone.
+ */
+void OverviewMapController::removeOverlayFromOverview()
+{
+  if (!m_overviewView)
+    return;
+
+  const int index = m_overviewView->graphicsOverlays()->indexOf(m_aoiOverlay);
+  if (index != -1)
+    m_overviewView->graphicsOverlays()->removeAt(index);
+}
+
+/*!
+  \internal
+
+  Replaces the geometry of the area of interest graphic and recenters the
+  overview. Unless \a force is \c true, nothing is done when the visible area
+  has not moved by \l pixelThreshold since it was last drawn.
+ */
+void OverviewMapController::updateAreaOfInterest(bool force)
+{
+  if (!m_mapView || !m_overviewView)
+    return;
+
+  Map* map = m_mapView->map();
+  Map* overviewMap = m_overviewView->map();
+  if (!isLoaded(map) || !isLoaded(overviewMap))
+    return;
+
+  TOOLKIT_PROFILE_SCOPE("OverviewMapController::updateAreaOfInterest");
+
+  const SpatialReference spatialReference = overviewMap->spatialReference();
+  GeometryEngine* geometryEngine = GeometryEngine::instance();
+
+  Polygon visibleArea = m_mapView->visibleArea();
+  if (visibleArea.isEmpty())
+    return;
+
+  if (visibleArea.spatialReference() != spatialReference)
+    visibleArea = geometryEngine->project(visibleArea, spatialReference);
+
+  const Envelope extent = visibleArea.extent();
+  if (!force && !movedEnough(extent))
+    return;
+
+  m_drawnExtent = extent;
+
+  Geometry fullExtent = map->initialViewpoint().targetGeometry().extent();
+  if (fullExtent.spatialReference() != spatialReference)
+    fullExtent = geometryEngine->project(fullExtent, spatialReference);
+
+  // only the geometry changes, the graphic and its symbol are reused
+  m_aoiGraphic->setGeometry(geometryEngine->difference(fullExtent, visibleArea));
+  m_overviewView->setViewpointCenter(extent.center(), m_mapView->mapScale() * m_zoomRatio);
+}
+
+/*!
+  \internal
+
+  Returns whether any edge of \a extent is at least \l pixelThreshold
+  pixels of the overview away from the extent last drawn.
+ */
+bool OverviewMapController::movedEnough(const Envelope& extent) const
+{
+  if (m_drawnExtent.isEmpty())
+    return true;
+
+  const double unitsPerPixel = m_overviewView->unitsPerDIP();
+  if (!(unitsPerPixel > 0.0))
+    return true;
+
+  const double movement = std::max({std::abs(extent.xMin() - m_drawnExtent.xMin()),
+                                    std::abs(extent.yMin() - m_drawnExtent.yMin()),
+                                    std::abs(extent.xMax() - m_drawnExtent.xMax()),
+                                    std::abs(extent.yMax() - m_drawnExtent.yMax())});
+
+  return movement / unitsPerPixel >= m_pixelThreshold;
+}
+
+/*!
+  \fn void OverviewMapController::zoomRatioChanged()
+  \brief Signal emitted when the \l zoomRatio property changes.
+ */
+
+/*!
+  \fn void OverviewMapController::pixelThresholdChanged()
+  \brief Signal emitted when the \l pixelThreshold property changes.
+ */
+
+/*!
+  \fn void OverviewMapController::fillColorChanged()
+  \brief Signal emitted when the \l fillColor property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,567 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "PopupStackModel.h"
+
+// C++ API headers
+#include "IdentifyLayerResult.h"
+#include "Popup.h"
+#include "PopupManager.h"
+
+// Qt headers
+#include <QGuiApplication>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::PopupStackModel
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief A list model of popups which only creates PopupManagers for the
+  popups being looked at.
+
+  A PopupManager builds the field and attachment models of its popup, which
+  is wasted work for the many results of an identify on a dense layer that
+  are never shown. This model holds the popups and creates a PopupManager
+  only for the \l currentIndex and the \l lookAhead popups after it, keeping
+  at most \l maximumLoadedPages of them. The least recently used are released
+  first, and all of those outside the current window are released by
+  \l releaseOffscreenPages, which is also called when the application is
+  suspended or hidden.
+
+  Rows are exposed to views \l pageSize at a time through \c fetchMore, so a
+  list of thousands of results does not create thousands of delegates.
+
+  Pass the model to the \c popupStackModel property of PopupStackView
+  instead of building a list of PopupManagers.
+
+  The model takes ownership of the popups added to it.
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent object.
+ */
+PopupStackModel::PopupStackModel(QObject* parent) :
+  QAbstractListModel(parent)
+{
+  // the closest thing to a memory warning Qt offers on every platform
+  auto application = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
+  if (application)
+  {
+    connect(application, &QGuiApplication::applicationStateChanged, this, [this](Qt::ApplicationState state)
+    {
+      if (state == Qt::ApplicationSuspended || state == Qt::ApplicationHidden)
+        releaseOffscreenPages();
+    });
+  }
+}
+
+/*!
+  \brief The destructor.
+ */
+PopupStackModel::~PopupStackModel()
+{
+}
+
+/*!
+  \brief Replaces the popups in the stack with \a popups.
+ */
+void PopupStackModel::setPopups(const QList<Popup*>& popups)
+{
+  clear();
+  appendPopups(popups);
+}
+
+/*!
+  \brief Adds \a popups to the end of the stack.
+
+  The first page of rows is fetched straight away.
+ */
+void PopupStackModel::appendPopups(const QList<Popup*>& popups)
+{
+  const int previousTotal = m_popups.size();
+  for (Popup* popup : popups)
+  {
+    if (!popup)
+      continue;
+
+    popup->setParent(this);
+    m_popups.append(popup);
+  }
+
+  if (m_popups.size() == previousTotal)
+    return;
+
+  emit totalCountChanged();
+
+  if (m_fetchedCount < m_pageSize)
+    fetchTo(m_pageSize - 1);
+
+  loadWindow();
+}
+
+/*!
+  \brief Adds the popups of \a identifyResults, including those of their
+  sublayer results, to the end of the stack.
+ */
+void PopupStackModel::appendIdentifyResults(const QList<IdentifyLayerResult*>& identifyResults)
+{
+  QList<Popup*> popups;
+  for (IdentifyLayerResult* identifyResult : identifyResults)
+    collectPopups(identifyResult, popups);
+
+  appendPopups(popups);
+}
+
+/*!
+  \brief Removes and deletes every popup and PopupManager in the stack.
+ */
+void PopupStackModel::clear()
+{
+  if (m_popups.isEmpty())
+    return;
+
+  beginResetModel();
+  for (PopupManager* manager : m_managers)
+    manager->deleteLater();
+  m_managers.clear();
+  m_recentPages.clear();
+
+  for (Popup* popup : m_popups)
+    popup->deleteLater();
+  m_popups.clear();
+
+  const bool countWasChanged = m_fetchedCount != 0;
+  const bool indexWasChanged = m_currentIndex != 0;
+  m_fetchedCount = 0;
+  m_currentIndex = 0;
+  endResetModel();
+
+  if (countWasChanged)
+    emit countChanged();
+  emit totalCountChanged();
+  if (indexWasChanged)
+    emit currentIndexChanged();
+  updateCurrentPopupManager();
+}
+
+/*!
+  \brief Returns the popup at \a index, or \c nullptr.
+ */
+QObject* PopupStackModel::popup(int index) const
+{
+  if (index < 0 || index >= m_popups.size())
+    return nullptr;
+
+  return m_popups.at(index);
+}
+
+/*!
+  \brief Returns the PopupManager for the popup at \a index, creating it if
+  needed, or \c nullptr if there is no such popup.
+
+  The PopupManager may be released later, once it is no longer near the
+  \l currentIndex, so do not keep it.
+ */
+QObject* PopupStackModel::popupManager(int index)
+{
+  if (index < 0 || index >= m_popups.size())
+    return nullptr;
+
+  PopupManager* manager = m_managers.value(index, nullptr);
+  if (!manager)
+  {
+    manager = new PopupManager(m_popups.at(index), this);
+    m_managers.insert(index, manager);
+
+    if (index < m_fetchedCount)
+    {
+      const QModelIndex modelIndex = createIndex(index, 0);
+      emit dataChanged(modelIndex, modelIndex, {PopupManagerRole, LoadedRole});
+    }
+  }
+
+  touchPage(index);
+  releasePages(false);
+  return manager;
+}
+
+/*!
+  \brief Releases the PopupManagers of every popup outside the current
+  window of \l currentIndex and \l lookAhead.
+
+  Call this when the platform warns that memory is low.
+ */
+void PopupStackModel::releaseOffscreenPages()
+{
+  releasePages(true);
+}
+
+/*!
+  \property PopupStackModel::count
+  \brief The number of rows which have been fetched.
+ */
+int PopupStackModel::count() const
+{
+  return m_fetchedCount;
+}
+
+/*!
+  \property PopupStackModel::totalCount
+  \brief The number of popups in the stack, including those which have not
+  been fetched yet.
+ */
+int PopupStackModel::totalCount() const
+{
+  return m_popups.size();
+}
+
+/*!
+  \property PopupStackModel::currentIndex
+  \brief The index of the popup being displayed.
+
+  Setting the index fetches rows up to it and creates the PopupManagers of
+  the new window.
+ */
+int PopupStackModel::currentIndex() const
+{
+  return m_currentIndex;
+}
+
+void PopupStackModel::setCurrentIndex(int currentIndex)
+{
+  currentIndex = qBound(0, currentIndex, qMax(0, m_popups.size() - 1));
+  if (currentIndex == m_currentIndex)
+    return;
+
+  m_currentIndex = currentIndex;
+  loadWindow();
+  emit currentIndexChanged();
+}
+
+/*!
+  \property PopupStackModel::currentPopupManager
+  \brief The PopupManager of the popup at \l currentIndex, or \c nullptr
+  if the stack is empty.
+
+  It is created when the current index changes or popups are added, so
+  reading it never changes the model.
+ */
+QObject* PopupStackModel::currentPopupManager() const
+{
+  return m_currentPopupManager;
+}
+
+/*!
+  \property PopupStackModel::lookAhead
+  \brief The number of popups after \l currentIndex whose PopupManagers are
+  created before they are displayed.
+
+  The default is \c 1.
+ */
+int PopupStackModel::lookAhead() const
+{
+  return m_lookAhead;
+}
+
+void PopupStackModel::setLookAhead(int lookAhead)
+{
+  lookAhead = qMax(0, lookAhead);
+  if (lookAhead == m_lookAhead)
+    return;
+
+  m_lookAhead = lookAhead;
+  loadWindow();
+  emit lookAheadChanged();
+}
+
+/*!
+  \property PopupStackModel::maximumLoadedPages
+  \brief The most PopupManagers kept at once.
+
+  The current popup and the look-ahead popups are always kept, even when
+  there are more of them than this. The default is \c 3.
+ */
+int PopupStackModel::maximumLoadedPages() const
+{
+  return m_maximumLoadedPages;
+}
+
+void PopupStackModel::setMaximumLoadedPages(int maximumLoadedPages)
+{
+  maximumLoadedPages = qMax(1, maximumLoadedPages);
+  if (maximumLoadedPages == m_maximumLoadedPages)
+    return;
+
+  m_maximumLoadedPages = maximumLoadedPages;
+  releasePages(false);
+  emit maximumLoadedPagesChanged();
+}
+
+/*!
+  \property PopupStackModel::pageSize
+  \brief The number of rows added each time a view fetches more.
+
+  The default is \c 20.
+ */
+int PopupStackModel::pageSize() const
+{
+  return m_pageSize;
+}
+
+void PopupStackModel::setPageSize(int pageSize)
+{
+  pageSize = qMax(1, pageSize);
+  if (pageSize == m_pageSize)
+    return;
+
+  m_pageSize = pageSize;
+  emit pageSizeChanged();
+}
+
+/*!
+  \internal
+ */
+int PopupStackModel::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : m_fetchedCount;
+}
+
+/*!
+  \internal
+
+  The popup manager role does not create a PopupManager; it is \c null
+  until the popup is in the current window or \l popupManager is called.
+ */
+QVariant PopupStackModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || index.row() >= m_fetchedCount)
+    return QVariant();
+
+  Popup* popup = m_popups.at(index.row());
+  switch (role)
+  {
+  case PopupRole:
+    return QVariant::fromValue<QObject*>(popup);
+  case PopupManagerRole:
+    return QVariant::fromValue<QObject*>(m_managers.value(index.row(), nullptr));
+  case TitleRole:
+    return popup->title();
+  case LoadedRole:
+    return m_managers.contains(index.row());
+  default:
+    break;
+  }
+
+  return QVariant();
+}
+
+/*!
+  \internal
+ */
+bool PopupStackModel::canFetchMore(const QModelIndex& parent) const
+{
+  return !parent.isValid() && m_fetchedCount < m_popups.size();
+}
+
+/*!
+  \internal
+ */
+void PopupStackModel::fetchMore(const QModelIndex& parent)
+{
+  if (parent.isValid())
+    return;
+
+  fetchTo(m_fetchedCount + m_pageSize - 1);
+}
+
+/*!
+  \internal
+ */
+QHash<int, QByteArray> PopupStackModel::roleNames() const
+{
+  return {{PopupRole, "popup"}, {PopupManagerRole, "popupManager"}, {TitleRole, "title"}, {LoadedRole, "loaded"}};
+}
+
+/*!
+  \internal
+ */
+bool PopupStackModel::isInWindow(int index) const
+{
+  return index >= m_currentIndex && index <= m_currentIndex + m_lookAhead;
+}
+
+/*!
+  \internal
+
+  Exposes the rows up to and including \a index.
+ */
+void PopupStackModel::fetchTo(int index)
+{
+  const int last = qMin(index, m_popups.size() - 1);
+  if (last < m_fetchedCount)
+    return;
+
+  beginInsertRows(QModelIndex(), m_fetchedCount, last);
+  m_fetchedCount = last + 1;
+  endInsertRows();
+
+  emit countChanged();
+}
+
+/*!
+  \internal
+
+  Creates the PopupManagers of the current popup and the look-ahead popups.
+ */
+void PopupStackModel::loadWindow()
+{
+  if (m_popups.isEmpty())
+    return;
+
+  const int last = qMin(m_currentIndex + m_lookAhead, m_popups.size() - 1);
+  fetchTo(last);
+
+  // the look-ahead first, so the current popup ends up the most recently used
+  for (int i = last; i >= m_currentIndex; --i)
+    popupManager(i);
+
+  updateCurrentPopupManager();
+}
+
+/*!
+  \internal
+ */
+void PopupStackModel::updateCurrentPopupManager()
+{
+  PopupManager* manager = m_managers.value(m_currentIndex, nullptr);
+  if (manager == m_currentPopupManager)
+    return;
+
+  m_currentPopupManager = manager;
+  emit currentPopupManagerChanged();
+}
+
+/*!
+  \internal
+
+  Releases the least recently used PopupManagers outside the current window,
+  until no more than \l maximumLoadedPages are left, or all of them when
+  \a offscreenOnly is \c true.
+ */
+void PopupStackModel::releasePages(bool offscreenOnly)
+{
+  const QList<int> recentPages = m_recentPages;
+  int loaded = m_managers.size();
+  for (int index : recentPages)
+  {
+    if (!offscreenOnly && loaded <= m_maximumLoadedPages)
+      break;
+
+    if (isInWindow(index))
+      continue;
+
+    releasePage(index);
+    --loaded;
+  }
+}
+
+/*!
+  \internal
+ */
+void PopupStackModel::releasePage(int index)
+{
+  PopupManager* manager = m_managers.take(index);
+  if (!manager)
+    return;
+
+  m_recentPages.removeOne(index);
+  manager->deleteLater();
+
+  if (index < m_fetchedCount)
+  {
+    const QModelIndex modelIndex = createIndex(index, 0);
+    emit dataChanged(modelIndex, modelIndex, {PopupManagerRole, LoadedRole});
+  }
+}
+
+/*!
+  \internal
+ */
+void PopupStackModel::touchPage(int index)
+{
+  m_recentPages.removeOne(index);
+  m_recentPages.append(index);
+}
+
+/*!
+  \internal
+ */
+void PopupStackModel::collectPopups(IdentifyLayerResult* identifyResult, QList<Popup*>& popups) const
+{
+  if (!identifyResult)
+    return;
+
+  popups.append(identifyResult->popups());
+
+  const QList<IdentifyLayerResult*> sublayerResults = identifyResult->sublayerResults();
+  for (IdentifyLayerResult* sublayerResult : sublayerResults)
+    collectPopups(sublayerResult, popups);
+}
+
+/*!
+  \fn void PopupStackModel::countChanged()
+  \brief Signal emitted when the \l count property changes.
+ */
+
+/*!
+  \fn void PopupStackModel::totalCountChanged()
+  \brief Signal emitted when the \l totalCount property changes.
+ */
+
+/*!
+  \fn void PopupStackModel::currentIndexChanged()
+  \brief Signal emitted when the \l currentIndex property changes.
+ */
+
+/*!
+  \fn void PopupStackModel::currentPopupManagerChanged()
+  \brief Signal emitted when the \l currentPopupManager property changes.
+ */
+
+/*!
+  \fn void PopupStackModel::lookAheadChanged()
+  \brief Signal emitted when the \l lookAhead property changes.
+ */
+
+/*!
+  \fn void PopupStackModel::maximumLoadedPagesChanged()
+  \brief Signal emitted when the \l maximumLoadedPages property changes.
+ */
+
+/*!
+  \fn void PopupStackModel::pageSizeChanged()
+  \brief Signal emitted when the \l pageSize property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,762 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "SearchController.h"
+
+// toolkit headers
+#include "ToolManager.h"
+#include "ViewpointObserver.h"
+
+// C++ API headers
+#include "GeocodeParameters.h"
+#include "LocatorTask.h"
+#include "MapQuickView.h"
+#include "Point.h"
+#include "SuggestParameters.h"
+
+// Qt headers
+#include <QTimer>
+#include <QVariantMap>
+
+// STL headers
+#include <cstring>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::SearchController
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief The controller behind a search box, which requests suggestions and
+  geocodes from a locator.
+
+  Setting \l searchText does not send a request straight away. Suggestions
+  are requested once the text has not changed for \l debounceInterval
+  milliseconds, and changing the text cancels any suggest task which is
+  still running for the old text. No more than \l maximumConcurrentTasks
+  tasks run at once, and only the results of the newest request of each
+  kind are delivered.
+
+  Suggestions and geocode results are cached by the normalized search
+  text (whitespace simplified, case folded) and the visible area of the
+  view set with \l setGeoView, rounded so that small pans reuse the same
+  entries. The \l cacheSize most recently used queries are kept, and
+  repeating one of them does not send a request at all.
+
+  Bind \l searchText to the \c searchTextInput of SearchBox and call
+  \l geocode from its \c search signal.
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent object.
+
+  The controller uses the ArcGIS World Geocoding Service until the
+  \l locatorUrl is changed or \l setLocatorTask is called.
+ */
+SearchController::SearchController(QObject* parent) :
+  AbstractTool(parent),
+  m_debounceTimer(new QTimer(this)),
+  m_scheduler(RequestKindCount),
+  m_suggestCache(50),
+  m_geocodeCache(50)
+{
+  ToolManager::instance().addTool(this);
+
+  // long enough to skip the keystrokes of a word typed at normal speed
+  m_debounceTimer->setSingleShot(true);
+  m_debounceTimer->setInterval(300);
+  connect(m_debounceTimer, &QTimer::timeout, this, &SearchController::requestSuggestions);
+
+  setLocatorUrl(QUrl(QStringLiteral("https://geocode.arcgis.com/arcgis/rest/services/World/GeocodeServer")));
+}
+
+/*!
+  \brief The destructor.
+
+  Any running tasks are cancelled.
+ */
+SearchController::~SearchController()
+{
+  cancel();
+}
+
+/*!
+  \brief Sets the view whose visible area guides the search to \a geoView.
+
+  \a geoView must be a MapQuickView. Results near the center of its visible
+  area are preferred.
+ */
+void SearchController::setGeoView(QObject* geoView)
+{
+  if (!geoView || std::strcmp(geoView->metaObject()->className(), MapQuickView::staticMetaObject.className()) != 0)
+    return;
+
+  auto mapView = reinterpret_cast<MapQuickView*>(geoView);
+  if (mapView == m_mapView)
+    return;
+
+  disconnect(m_viewConnection);
+  m_mapView = mapView;
+  m_viewConnection = connect(m_mapView, &QObject::destroyed, this, [this]()
+  {
+    m_mapView = nullptr;
+  });
+}
+
+/*!
+  \brief Geocodes the \l searchText.
+
+  Waiting suggestions are dropped, since the user has finished typing.
+
+  \sa geocodeCompleted
+ */
+void SearchController::geocode()
+{
+  m_debounceTimer->stop();
+  m_scheduler.supersede(SuggestRequest);
+
+  const QString key = cacheKey(QStringLiteral("geocode"), m_searchText);
+  const QList<GeocodeResult>* cached = m_geocodeCache.object(key);
+  if (cached)
+  {
+    // a newer request makes any geocode still running obsolete
+    m_scheduler.supersede(GeocodeRequest);
+    setGeocodeResults(*cached);
+    updateBusy();
+    return;
+  }
+
+  request(GeocodeRequest, m_searchText, key);
+  startPendingRequests();
+}
+
+/*!
+  \brief Geocodes the suggestion at \a suggestionIndex in \l suggestions.
+
+  \sa geocodeCompleted
+ */
+void SearchController::geocodeSuggestion(int suggestionIndex)
+{
+  if (suggestionIndex < 0 || suggestionIndex >= m_suggestResults.size())
+  {
+    qWarning("No suggestion at index %d", suggestionIndex);
+    return;
+  }
+
+  m_debounceTimer->stop();
+  m_scheduler.supersede(SuggestRequest);
+
+  const SuggestResult suggestResult = m_suggestResults.at(suggestionIndex);
+  const QString key = cacheKey(QStringLiteral("suggestion"), suggestResult.label());
+  const QList<GeocodeResult>* cached = m_geocodeCache.object(key);
+  if (cached)
+  {
+    m_scheduler.supersede(GeocodeRequest);
+    setGeocodeResults(*cached);
+    updateBusy();
+    return;
+  }
+
+  request(GeocodeRequest, suggestResult.label(), key);
+  m_requests[GeocodeRequest].suggestResult = suggestResult;
+  m_requests[GeocodeRequest].fromSuggestion = true;
+  startPendingRequests();
+}
+
+/*!
+  \brief Cancels every waiting request and running task.
+ */
+void SearchController::cancel()
+{
+  m_debounceTimer->stop();
+  m_scheduler.cancel();
+  updateBusy();
+}
+
+/*!
+  \brief Removes all cached suggestions and geocode results.
+ */
+void SearchController::clearCache()
+{
+  m_suggestCache.clear();
+  m_geocodeCache.clear();
+}
+
+/*!
+  \brief Returns the locator the controller searches.
+ */
+LocatorTask* SearchController::locatorTask() const
+{
+  return m_locatorTask;
+}
+
+/*!
+  \brief Sets the locator the controller searches to \a locatorTask.
+
+  Running tasks are cancelled and the cache is cleared. The controller does
+  not take ownership of \a locatorTask.
+ */
+void SearchController::setLocatorTask(LocatorTask* locatorTask)
+{
+  if (locatorTask == m_locatorTask)
+    return;
+
+  cancel();
+  clearCache();
+
+  for (const auto& connection : qAsConst(m_locatorConnections))
+    disconnect(connection);
+  m_locatorConnections.clear();
+
+  m_locatorTask = locatorTask;
+  connectLocatorTask();
+}
+
+/*!
+  \property SearchController::searchText
+  \brief The text to search for.
+
+  Suggestions for the text are requested after \l debounceInterval, unless
+  they are cached. Text shorter than \l minimumSearchLength clears the
+  suggestions.
+ */
+QString SearchController::searchText() const
+{
+  return m_searchText;
+}
+
+void SearchController::setSearchText(const QString& searchText)
+{
+  if (searchText == m_searchText)
+    return;
+
+  m_searchText = searchText;
+  emit searchTextChanged();
+
+  // the suggestions for the old text are not wanted any more
+  m_scheduler.supersede(SuggestRequest);
+
+  if (m_searchText.simplified().length() < m_minimumSearchLength)
+  {
+    m_debounceTimer->stop();
+    setSuggestResults(QList<SuggestResult>());
+    updateBusy();
+    return;
+  }
+
+  const QList<SuggestResult>* cached = m_suggestCache.object(cacheKey(QStringLiteral("suggest"), m_searchText));
+  if (cached)
+  {
+    m_debounceTimer->stop();
+    setSuggestResults(*cached);
+    updateBusy();
+    return;
+  }
+
+  // restarts the wait on every keystroke
+  m_debounceTimer->start();
+  updateBusy();
+}
+
+/*!
+  \property SearchController::locatorUrl
+  \brief The URL of the geocode service the controller creates its own
+  locator for.
+
+  The default is the ArcGIS World Geocoding Service.
+
+  \sa setLocatorTask
+ */
+QUrl SearchController::locatorUrl() const
+{
+  return m_locatorUrl;
+}
+
+void SearchController::setLocatorUrl(const QUrl& locatorUrl)
+{
+  if (locatorUrl == m_locatorUrl)
+    return;
+
+  m_locatorUrl = locatorUrl;
+
+  LocatorTask* oldLocatorTask = m_ownedLocatorTask;
+  m_ownedLocatorTask = m_locatorUrl.isEmpty() ? nullptr : new LocatorTask(m_locatorUrl, this);
+  setLocatorTask(m_ownedLocatorTask);
+  delete oldLocatorTask;
+
+  emit locatorUrlChanged();
+}
+
+/*!
+  \property SearchController::suggestions
+  \brief The labels of the suggestions for the \l searchText.
+ */
+QStringList SearchController::suggestions() const
+{
+  QStringList labels;
+  labels.reserve(m_suggestResults.size());
+  for (const SuggestResult& suggestResult : m_suggestResults)
+    labels.append(suggestResult.label());
+
+  return labels;
+}
+
+/*!
+  \brief Returns the suggestions for the \l searchText.
+ */
+QList<SuggestResult> SearchController::suggestResults() const
+{
+  return m_suggestResults;
+}
+
+/*!
+  \property SearchController::geocodeResults
+  \brief The results of the last geocode.
+
+  Each result is a map with the \c label, \c score, \c x and \c y of the
+  result, in the spatial reference of the locator.
+ */
+QVariantList SearchController::geocodeResults() const
+{
+  QVariantList results;
+  results.reserve(m_geocodeResults.size());
+  for (const GeocodeResult& geocodeResult : m_geocodeResults)
+  {
+    const Point location = geocodeResult.displayLocation();
+    results.append(QVariantMap
+    {
+      {QStringLiteral("label"), geocodeResult.label()},
+      {QStringLiteral("score"), geocodeResult.score()},
+      {QStringLiteral("x"), location.x()},
+      {QStringLiteral("y"), location.y()}
+    });
+  }
+
+  return results;
+}
+
+/*!
+  \brief Returns the results of the last geocode.
+ */
+QList<GeocodeResult> SearchController::geocodeResultList() const
+{
+  return m_geocodeResults;
+}
+
+/*!
+  \property SearchController::busy
+  \brief Whether any request is waiting or any task is running.
+ */
+bool SearchController::isBusy() const
+{
+  return m_busy;
+}
+
+/*!
+  \property SearchController::debounceInterval
+  \brief The time in milliseconds the \l searchText must stay unchanged
+  before suggestions are requested.
+
+  The default is \c 300.
+ */
+int SearchController::debounceInterval() const
+{
+  return m_debounceTimer->interval();
+}
+
+void SearchController::setDebounceInterval(int debounceInterval)
+{
+  debounceInterval = qMax(0, debounceInterval);
+  if (debounceInterval == m_debounceTimer->interval())
+    return;
+
+  m_debounceTimer->setInterval(debounceInterval);
+  emit debounceIntervalChanged();
+}
+
+/*!
+  \property SearchController::minimumSearchLength
+  \brief The fewest characters for which suggestions are requested.
+
+  The default is \c 3.
+ */
+int SearchController::minimumSearchLength() const
+{
+  return m_minimumSearchLength;
+}
+
+void SearchController::setMinimumSearchLength(int minimumSearchLength)
+{
+  minimumSearchLength = qMax(1, minimumSearchLength);
+  if (minimumSearchLength == m_minimumSearchLength)
+    return;
+
+  m_minimumSearchLength = minimumSearchLength;
+  emit minimumSearchLengthChanged();
+}
+
+/*!
+  \property SearchController::maximumConcurrentTasks
+  \brief The maximum number of locator tasks that run at once.
+
+  A request which would exceed this number waits for a running task to
+  finish. The default is \c 2.
+ */
+int SearchController::maximumConcurrentTasks() const
+{
+  return m_scheduler.maximumConcurrentTasks();
+}
+
+void SearchController::setMaximumConcurrentTasks(int maximumConcurrentTasks)
+{
+  maximumConcurrentTasks = qMax(1, maximumConcurrentTasks);
+  if (maximumConcurrentTasks == m_scheduler.maximumConcurrentTasks())
+    return;
+
+  m_scheduler.setMaximumConcurrentTasks(maximumConcurrentTasks);
+  emit maximumConcurrentTasksChanged();
+
+  startPendingRequests();
+}
+
+/*!
+  \property SearchController::maximumResults
+  \brief The maximum number of suggestions or geocode results requested.
+
+  Changing it clears the cache. The default is \c 6.
+ */
+int SearchController::maximumResults() const
+{
+  return m_maximumResults;
+}
+
+void SearchController::setMaximumResults(int maximumResults)
+{
+  maximumResults = qMax(1, maximumResults);
+  if (maximumResults == m_maximumResults)
+    return;
+
+  m_maximumResults = maximumResults;
+  clearCache();
+  emit maximumResultsChanged();
+}
+
+/*!
+  \property SearchController::cacheSize
+  \brief The number of queries whose suggestions, and separately whose
+  geocode results, are cached.
+
+  The default is \c 50.
+ */
+int SearchController::cacheSize() const
+{
+  return m_suggestCache.maxCost();
+}
+
+void SearchController::setCacheSize(int cacheSize)
+{
+  cacheSize = qMax(0, cacheSize);
+  if (cacheSize == m_suggestCache.maxCost())
+    return;
+
+  m_suggestCache.setMaxCost(cacheSize);
+  m_geocodeCache.setMaxCost(cacheSize);
+  emit cacheSizeChanged();
+}
+
+/*!
+  \brief Returns the name of the tool - \c "Search".
+ */
+QString SearchController::toolName() const
+{
+  return QStringLiteral("Search");
+}
+
+/*!
+  \internal
+ */
+void SearchController::connectLocatorTask()
+{
+  if (!m_locatorTask)
+    return;
+
+  m_locatorConnections.append(connect(m_locatorTask, &LocatorTask::suggestCompleted, this, &SearchController::onSuggestCompleted));
+  m_locatorConnections.append(connect(m_locatorTask, &LocatorTask::geocodeCompleted, this, &SearchController::onGeocodeCompleted));
+  m_locatorConnections.append(connect(m_locatorTask, &LocatorTask::errorOccurred, this, [this]()
+  {
+    onErrorOccurred();
+  }));
+  m_locatorConnections.append(connect(m_locatorTask, &QObject::destroyed, this, [this]()
+  {
+    m_locatorTask = nullptr;
+    m_locatorConnections.clear();
+    m_scheduler.clearTasks();
+    updateBusy();
+  }));
+}
+
+/*!
+  \internal
+
+  Requests suggestions for the text once it has stopped changing.
+ */
+void SearchController::requestSuggestions()
+{
+  request(SuggestRequest, m_searchText, cacheKey(QStringLiteral("suggest"), m_searchText));
+  startPendingRequests();
+}
+
+/*!
+  \internal
+
+  Replaces any waiting request of the same \a kind.
+ */
+void SearchController::request(RequestKind kind, const QString& text, const QString& cacheKey)
+{
+  Request& request = m_requests[kind];
+  request.text = text;
+  request.cacheKey = cacheKey;
+  request.suggestResult = SuggestResult();
+  request.fromSuggestion = false;
+  m_scheduler.request(kind);
+}
+
+/*!
+  \internal
+
+  Starts the waiting requests for which there is room.
+ */
+void SearchController::startPendingRequests()
+{
+  Envelope extent;
+  if (m_mapView)
+  {
+    ViewpointObserver* observer = ViewpointObserver::forGeoView(m_mapView);
+    if (observer)
+      extent = observer->extent();
+  }
+
+  m_scheduler.startPendingRequests([this, &extent](int kind, QString& taskCacheKey) -> TaskWatcher
+  {
+    if (!m_locatorTask)
+      return TaskWatcher();
+
+    const Request& request = m_requests[kind];
+    taskCacheKey = request.cacheKey;
+
+    if (kind == SuggestRequest)
+    {
+      SuggestParameters parameters;
+      parameters.setMaxResults(m_maximumResults);
+      if (!extent.isEmpty())
+        parameters.setPreferredSearchLocation(extent.center());
+
+      return m_locatorTask->suggest(request.text, parameters);
+    }
+
+    if (request.fromSuggestion)
+      return m_locatorTask->geocodeWithSuggestResult(request.suggestResult);
+
+    GeocodeParameters parameters;
+    parameters.setMaxResults(m_maximumResults);
+    if (!extent.isEmpty())
+      parameters.setPreferredSearchLocation(extent.center());
+
+    return m_locatorTask->geocodeWithParameters(request.text, parameters);
+  });
+
+  updateBusy();
+}
+
+/*!
+  \internal
+ */
+void SearchController::onSuggestCompleted(QUuid taskId, const QList<SuggestResult>& suggestResults)
+{
+  Scheduler::Task task;
+  if (!m_scheduler.takeTask(taskId, task))
+    return;
+
+  // the slot is free again, and a waiting request may use it
+  startPendingRequests();
+
+  m_suggestCache.insert(task.data, new QList<SuggestResult>(suggestResults));
+
+  if (!m_scheduler.isNewest(task))
+    return;
+
+  setSuggestResults(suggestResults);
+}
+
+/*!
+  \internal
+ */
+void SearchController::onGeocodeCompleted(QUuid taskId, const QList<GeocodeResult>& geocodeResults)
+{
+  Scheduler::Task task;
+  if (!m_scheduler.takeTask(taskId, task))
+    return;
+
+  // the slot is free again, and a waiting request may use it
+  startPendingRequests();
+
+  m_geocodeCache.insert(task.data, new QList<GeocodeResult>(geocodeResults));
+
+  if (!m_scheduler.isNewest(task))
+    return;
+
+  setGeocodeResults(geocodeResults);
+}
+
+/*!
+  \internal
+
+  The error does not say which task failed, so every finished task gives up
+  its slot.
+ */
+void SearchController::onErrorOccurred()
+{
+  m_scheduler.removeFinishedTasks();
+  startPendingRequests();
+}
+
+/*!
+  \internal
+ */
+void SearchController::setSuggestResults(const QList<SuggestResult>& suggestResults)
+{
+  if (suggestResults.isEmpty() && m_suggestResults.isEmpty())
+    return;
+
+  m_suggestResults = suggestResults;
+  emit suggestionsChanged();
+}
+
+/*!
+  \internal
+ */
+void SearchController::setGeocodeResults(const QList<GeocodeResult>& geocodeResults)
+{
+  m_geocodeResults = geocodeResults;
+  emit geocodeResultsChanged();
+  emit geocodeCompleted(m_geocodeResults);
+}
+
+/*!
+  \internal
+
+  Returns the key of \a text searched around the visible area. The area is
+  rounded to a few significant digits so nearby views share entries.
+ */
+QString SearchController::cacheKey(const QString& prefix, const QString& text) const
+{
+  QString key = prefix + QLatin1Char('|') + text.simplified().toCaseFolded();
+
+  if (m_mapView)
+  {
+    ViewpointObserver* observer = ViewpointObserver::forGeoView(m_mapView);
+    const Envelope extent = observer ? observer->extent() : Envelope();
+    if (!extent.isEmpty())
+    {
+      const Point center = extent.center();
+      key += QStringLiteral("|%1,%2,%3")
+          .arg(QString::number(center.x(), 'g', 3),
+               QString::number(center.y(), 'g', 3),
+               QString::number(extent.width(), 'g', 2));
+    }
+  }
+
+  return key;
+}
+
+/*!
+  \internal
+ */
+void SearchController::updateBusy()
+{
+  const bool busy = m_debounceTimer->isActive() || m_scheduler.isBusy();
+
+  if (busy == m_busy)
+    return;
+
+  m_busy = busy;
+  emit busyChanged();
+}
+
+/*!
+  \fn void SearchController::searchTextChanged()
+  \brief Signal emitted when the \l searchText property changes.
+ */
+
+/*!
+  \fn void SearchController::locatorUrlChanged()
+  \brief Signal emitted when the \l locatorUrl property changes.
+ */
+
+/*!
+  \fn void SearchController::suggestionsChanged()
+  \brief Signal emitted when the \l suggestions property changes.
+ */
+
+/*!
+  \fn void SearchController::geocodeResultsChanged()
+  \brief Signal emitted when the \l geocodeResults property changes.
+ */
+
+/*!
+  \fn void SearchController::geocodeCompleted(const QList<Esri::ArcGISRuntime::GeocodeResult>& geocodeResults)
+  \brief Signal emitted when a geocode, or a cached geocode, completes with
+  \a geocodeResults.
+ */
+
+/*!
+  \fn void SearchController::busyChanged()
+  \brief Signal emitted when the \l busy property changes.
+ */
+
+/*!
+  \fn void SearchController::debounceIntervalChanged()
+  \brief Signal emitted when the \l debounceInterval property changes.
+ */
+
+/*!
+  \fn void SearchController::minimumSearchLengthChanged()
+  \brief Signal emitted when the \l minimumSearchLength property changes.
+ */
+
+/*!
+  \fn void SearchController::maximumConcurrentTasksChanged()
+  \brief Signal emitted when the \l maximumConcurrentTasks property changes.
+ */
+
+/*!
+  \fn void SearchController::maximumResultsChanged()
+  \brief Signal emitted when the \l maximumResults property changes.
+ */
+
+/*!
+  \fn void SearchController::cacheSizeChanged()
+  \brief Signal emitted when the \l cacheSize property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,435 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ThumbnailImageProvider.h"
+
+// Qt headers
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThread>
+#include <QUrl>
+
+// STL headers
+#include <atomic>
+#include <limits>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \internal
+  \brief The memory and disk caches shared between the provider and the
+  responses still running on its thread pool.
+ */
+class ThumbnailCache
+{
+public:
+  explicit ThumbnailCache(int memoryCacheSize) :
+    m_images(memoryCacheSize)
+  {
+  }
+
+  bool find(const QString& cacheKey, QImage& image)
+  {
+    {
+      QMutexLocker locker(&m_mutex);
+      QImage* cached = m_images.object(cacheKey);
+      if (cached)
+      {
+        image = *cached;
+        return true;
+      }
+    }
+
+    // a thumbnail written by an earlier run
+    const QString path = diskPath(cacheKey);
+    if (path.isEmpty() || !QFile::exists(path))
+      return false;
+
+    QImageReader reader(path);
+    image = reader.read();
+    if (image.isNull())
+      return false;
+
+    insertInMemory(cacheKey, image);
+    return true;
+  }
+
+  void insert(const QString& cacheKey, const QImage& image)
+  {
+    insertInMemory(cacheKey, image);
+
+    const QString path = diskPath(cacheKey);
+    if (path.isEmpty())
+      return;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit())
+      qWarning("Could not write the thumbnail cache file %s", qPrintable(path));
+  }
+
+  int memoryCacheSize() const
+  {
+    QMutexLocker locker(&m_mutex);
+    return m_images.maxCost();
+  }
+
+  void setMemoryCacheSize(int memoryCacheSize)
+  {
+    QMutexLocker locker(&m_mutex);
+    m_images.setMaxCost(memoryCacheSize);
+  }
+
+  QString diskCachePath() const
+  {
+    QMutexLocker locker(&m_mutex);
+    return m_diskCachePath;
+  }
+
+  void setDiskCachePath(const QString& diskCachePath)
+  {
+    if (!diskCachePath.isEmpty() && !QDir().mkpath(diskCachePath))
+    {
+      qWarning("Could not create the thumbnail cache directory %s", qPrintable(diskCachePath));
+      return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_diskCachePath = diskCachePath;
+  }
+
+  void clear()
+  {
+    QMutexLocker locker(&m_mutex);
+    m_images.clear();
+
+    if (m_diskCachePath.isEmpty())
+      return;
+
+    // the directory may hold other files, so only the names diskPath gives are removed
+    static const QRegularExpression cacheFileName(QStringLiteral("^[0-9a-f]{32}\\.png$"));
+    QDir directory(m_diskCachePath);
+    const QStringList files = directory.entryList(QStringList{QStringLiteral("*.png")}, QDir::Files);
+    for (const QString& file : files)
+    {
+      if (cacheFileName.match(file).hasMatch())
+        directory.remove(file);
+    }
+  }
+
+private:
+  void insertInMemory(const QString& cacheKey, const QImage& image)
+  {
+    // the cost is the decoded size in bytes, so the limit bounds the memory used
+    QMutexLocker locker(&m_mutex);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    const int cost = static_cast<int>(qMin<qsizetype>(image.sizeInBytes(), std::numeric_limits<int>::max()));
+#else
+    const int cost = image.byteCount();
+#endif // QT_VERSION
+    m_images.insert(cacheKey, new QImage(image), cost);
+  }
+
+  QString diskPath(const QString& cacheKey) const
+  {
+    QMutexLocker locker(&m_mutex);
+    if (m_diskCachePath.isEmpty())
+      return QString();
+
+    const QByteArray hash = QCryptographicHash::hash(cacheKey.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QDir(m_diskCachePath).filePath(QString::fromLatin1(hash) + QStringLiteral(".png"));
+  }
+
+  mutable QMutex m_mutex;
+  QCache<QString, QImage> m_images;
+  QString m_diskCachePath;
+};
+
+/*!
+  \internal
+  \brief Decodes one thumbnail on the provider's thread pool.
+ */
+class ThumbnailImageResponse : public QQuickImageResponse, public QRunnable
+{
+public:
+  ThumbnailImageResponse(const std::shared_ptr<ThumbnailCache>& cache, const QString& id, const QSize& requestedSize) :
+    m_cache(cache),
+    m_requestedSize(requestedSize)
+  {
+    // the response is deleted by the engine, not by the thread pool
+    setAutoDelete(false);
+
+    // the id is the percent-encoded attachment URL, which may follow an attachment ID and a "/"
+    const int separator = id.lastIndexOf(QLatin1Char('/'));
+    m_url = QUrl(QUrl::fromPercentEncoding(id.mid(separator + 1).toUtf8()));
+  }
+
+  QQuickTextureFactory* textureFactory() const override
+  {
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+  }
+
+  QString errorString() const override
+  {
+    return m_errorString;
+  }
+
+  void cancel() override
+  {
+    m_canceled = true;
+  }
+
+  void run() override
+  {
+    // delegates scrolled out of view cancel their requests before they start
+    if (!m_canceled)
+      load();
+
+    emit finished();
+  }
+
+private:
+  void load()
+  {
+    QString path;
+    if (m_url.isLocalFile())
+      path = m_url.toLocalFile();
+    else if (m_url.scheme() == QStringLiteral("qrc"))
+      path = QStringLiteral(":") + m_url.path();
+    else if (m_url.isRelative())
+      path = m_url.path();
+
+    if (path.isEmpty())
+    {
+      m_errorString = QStringLiteral("Thumbnails can only be decoded from local attachment data: ") + m_url.toString();
+      return;
+    }
+
+    // attachment IDs are only unique within a feature, so the key is the URL of the data.
+    // The file's size and modification time keep the disk cache from serving replaced data.
+    const QFileInfo fileInfo(path);
+    const QString cacheKey = m_url.toString() +
+        QStringLiteral("#%1-%2@%3x%4").arg(fileInfo.lastModified().toMSecsSinceEpoch()).arg(fileInfo.size())
+                                      .arg(m_requestedSize.width()).arg(m_requestedSize.height());
+    if (m_cache->find(cacheKey, m_image))
+      return;
+
+    QImageReader reader(path);
+
+    // decode straight to the thumbnail size instead of scaling a full resolution image
+    const QSize fullSize = reader.size();
+    if (fullSize.isValid() && (m_requestedSize.width() > 0 || m_requestedSize.height() > 0))
+    {
+      QSize boundingSize = m_requestedSize;
+      if (boundingSize.width() <= 0)
+        boundingSize.setWidth(fullSize.width());
+      if (boundingSize.height() <= 0)
+        boundingSize.setHeight(fullSize.height());
+
+      if (fullSize.width() > boundingSize.width() || fullSize.height() > boundingSize.height())
+        reader.setScaledSize(fullSize.scaled(boundingSize, Qt::KeepAspectRatio));
+    }
+
+    if (m_canceled)
+      return;
+
+    m_image = reader.read();
+    if (m_image.isNull())
+    {
+      m_errorString = reader.errorString();
+      return;
+    }
+
+    m_cache->insert(cacheKey, m_image);
+  }
+
+  std::shared_ptr<ThumbnailCache> m_cache;
+  QUrl m_url;
+  QSize m_requestedSize;
+  QImage m_image;
+  QString m_errorString;
+  std::atomic<bool> m_canceled{false};
+};
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ThumbnailImageProvider
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief An image provider which decodes attachment thumbnails on worker
+  threads and caches them.
+
+  Delegates of an attachment list only show small thumbnails, yet an
+  \c Image loading the attachment URL decodes the whole photo on the GUI
+  thread. This provider decodes each image straight to the requested
+  \c sourceSize on its own thread pool, keeps the results in a memory cache
+  bounded by \l memoryCacheSize() bytes, and optionally writes them to
+  \l diskCachePath() so the next run does not decode them again.
+
+  Images are requested as
+  \c {image://arcgistoolkitthumbnails/<attachment URL>}, with the URL
+  percent-encoded. The thumbnails are cached by the URL, the size and
+  modification time of its data, and the requested size, so thumbnails of
+  different features never collide. Only local attachment data (file and
+  qrc URLs) is decoded.
+
+  The toolkit plugin adds the provider to its engine. Applications which
+  register the toolkit types through \c registerToolkitTypes add it
+  themselves:
+
+  \code
+  engine.addImageProvider(ThumbnailImageProvider::providerId(), new ThumbnailImageProvider);
+  \endcode
+
+  and then set the \c thumbnailProviderId of AttachmentListView to
+  \l providerId().
+ */
+
+/*!
+  \brief The constructor that accepts the \a memoryCacheSize in bytes and an
+  optional \a diskCachePath.
+ */
+ThumbnailImageProvider::ThumbnailImageProvider(int memoryCacheSize, const QString& diskCachePath) :
+  QQuickAsyncImageProvider(),
+  m_cache(std::make_shared<ThumbnailCache>(memoryCacheSize))
+{
+  // leave threads for the renderer and the runtime
+  m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+
+  if (!diskCachePath.isEmpty())
+    m_cache->setDiskCachePath(diskCachePath);
+}
+
+/*!
+  \brief The destructor.
+ */
+ThumbnailImageProvider::~ThumbnailImageProvider()
+{
+  m_threadPool.waitForDone();
+}
+
+/*!
+  \brief Returns the id under which the provider is added to the engine.
+ */
+QString ThumbnailImageProvider::providerId()
+{
+  return QStringLiteral("arcgistoolkitthumbnails");
+}
+
+/*!
+  \brief Starts decoding the image \a id at \a requestedSize on a worker thread.
+
+  When \a requestedSize is not set, the image is decoded to fit
+  \l defaultThumbnailSize().
+ */
+QQuickImageResponse* ThumbnailImageProvider::requestImageResponse(const QString& id, const QSize& requestedSize)
+{
+  QSize size = requestedSize;
+  if (size.width() <= 0 && size.height() <= 0)
+    size = QSize(m_defaultThumbnailSize, m_defaultThumbnailSize);
+
+  auto response = new ThumbnailImageResponse(m_cache, id, size);
+  m_threadPool.start(response);
+  return response;
+}
+
+/*!
+  \brief Returns the most bytes of decoded thumbnails kept in memory.
+
+  The least recently used thumbnails are dropped first. The default is 32 MB.
+ */
+int ThumbnailImageProvider::memoryCacheSize() const
+{
+  return m_cache->memoryCacheSize();
+}
+
+/*!
+  \brief Sets the most bytes of decoded thumbnails kept in memory to \a memoryCacheSize.
+ */
+void ThumbnailImageProvider::setMemoryCacheSize(int memoryCacheSize)
+{
+  m_cache->setMemoryCacheSize(memoryCacheSize);
+}
+
+/*!
+  \brief Returns the directory thumbnails are written to, or an empty string
+  for no disk cache.
+
+  The default is an empty string.
+ */
+QString ThumbnailImageProvider::diskCachePath() const
+{
+  return m_cache->diskCachePath();
+}
+
+/*!
+  \brief Sets the directory thumbnails are written to to \a diskCachePath,
+  creating it if needed.
+
+  Pass an empty string to turn the disk cache off.
+ */
+void ThumbnailImageProvider::setDiskCachePath(const QString& diskCachePath)
+{
+  m_cache->setDiskCachePath(diskCachePath);
+}
+
+/*!
+  \brief Returns the size images are decoded to fit when the request has no
+  \c sourceSize.
+
+  The default is \c 256 pixels.
+ */
+int ThumbnailImageProvider::defaultThumbnailSize() const
+{
+  return m_defaultThumbnailSize;
+}
+
+/*!
+  \brief Sets the size images are decoded to fit when the request has no
+  \c sourceSize to \a defaultThumbnailSize.
+ */
+void ThumbnailImageProvider::setDefaultThumbnailSize(int defaultThumbnailSize)
+{
+  m_defaultThumbnailSize = defaultThumbnailSize;
+}
+
+/*!
+  \brief Removes all thumbnails from the memory and disk caches.
+
+  Only the files the cache wrote are deleted from \l diskCachePath; any
+  other files in the directory are left alone.
+ */
+void ThumbnailImageProvider::clearCache()
+{
+  m_cache->clear();
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
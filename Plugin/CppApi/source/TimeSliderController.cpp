@@ -15,6 +15,7 @@
  *  limitations under the License.
  ******************************************************************************/
 
+#include "FeatureLayer.h"
 #include "LayerListModel.h"
 #include "Map.h"
 #include "MapQuickView.h"
@@ -24,12 +25,25 @@
 #include "TimeValue.h"
 
 #include "TimeSliderController.h"
+#include "TimeSliderDensityIndex.h"
+#include "TimeSliderStepsModel.h"
 #include "ToolManager.h"
+#include "ToolkitProfiler.h"
 
+#include <QSet>
+#include <QTimer>
+
+#include <algorithm>
 #include <cstring>
 
 using namespace Esri::ArcGISRuntime;
 
+namespace
+{
+// the longest time playback waits for the view to finish drawing a step before moving on
+constexpr int maximumDrawWaitMS = 5000;
+}
+
 namespace Esri
 {
 namespace ArcGISRuntime
@@ -37,21 +51,6 @@ namespace ArcGISRuntime
 namespace Toolkit
 {
 
-/*!
- \internal
- */
-TimeExtent unionTimeExtent(const TimeExtent& timeExtent,
-                           const TimeExtent& otherTimeExtent)
-{
-  if (otherTimeExtent.isEmpty())
-    return timeExtent;
-
-  auto startTime = timeExtent.startTime() < otherTimeExtent.startTime() ? timeExtent.startTime() : otherTimeExtent.startTime();
-  auto endTime = timeExtent.endTime() > otherTimeExtent.endTime() ? timeExtent.endTime() : otherTimeExtent.endTime();
-
-  return TimeExtent(startTime, endTime);
-}
-
 /*!
  \internal
  */
@@ -147,7 +146,8 @@ bool operator == (const TimeExtent& timeExtent, const TimeExtent& otherTimeExten
 
   The controller presents the temporal range of the data as a number of steps.
   These steps allow the temporal extent to be set and animated by stepping through
-  the range.
+  the range. Steps are measured in whole milliseconds, and steps of months or
+  longer follow the calendar.
 
   \note The controller will be automatically created by a TimeSlider
   so you do not need to create this type.
@@ -159,8 +159,27 @@ bool operator == (const TimeExtent& timeExtent, const TimeExtent& otherTimeExten
    \brief The constructor that accepts an optional \a parent object.
  */
 TimeSliderController::TimeSliderController(QObject* parent):
-  AbstractTool(parent)
+  AbstractTool(parent),
+  m_steps(new TimeSliderStepsModel(this)),
+  m_updateTimer(new QTimer(this))
 {
+  // bursts of layer changes (e.g. a web map loading many layers) are coalesced into one update
+  m_updateTimer->setSingleShot(true);
+  m_updateTimer->setInterval(0);
+  connect(m_updateTimer, &QTimer::timeout, this, &TimeSliderController::initializeTimeProperties);
+
+  m_playbackTimer = new QTimer(this);
+  m_playbackTimer->setSingleShot(true);
+  connect(m_playbackTimer, &QTimer::timeout, this, &TimeSliderController::onPlaybackTimeout);
+
+  m_densityIndex = new TimeSliderDensityIndex(this);
+  connect(m_densityIndex, &TimeSliderDensityIndex::countsChanged, this, [this](int firstStep, int lastStep)
+  {
+    m_steps->updateStepCounts(firstStep, lastStep);
+    emit stepCountsChanged(firstStep, lastStep);
+  });
+  connect(m_densityIndex, &TimeSliderDensityIndex::readyChanged, this, &TimeSliderController::densityIndexReadyChanged);
+
   ToolManager::instance().addTool(this);
 }
 
@@ -169,6 +188,7 @@ TimeSliderController::TimeSliderController(QObject* parent):
  */
 TimeSliderController::~TimeSliderController()
 {
+  clearLayerTimeInfo();
 }
 
 /*!
@@ -222,82 +242,206 @@ void TimeSliderController::setGeoView(QObject* geoView)
     }
   }
 
+  connectDrawStatus();
+
   calculateStepPositions();
   emit currentTimeExtentChanged();
 }
 
 /*!
  \internal
+
+ Recalculates the full time extent and the steps from the cached properties
+ of the operational layers. Signals are only emitted for values which change.
  */
 void TimeSliderController::initializeTimeProperties()
 {
+  TOOLKIT_PROFILE_SCOPE("TimeSliderController::initializeTimeProperties");
+
+  m_updateTimer->stop();
+
   if (!m_operationalLayers)
     return;
 
-  // Get all the layers that are visible and are participating in time-based filtering
-  QList<TimeAware*> timeAwareLayers;
-  for (int i = 0 ; i < m_operationalLayers->rowCount(); i++)
+  if (m_layersDirty)
+    syncLayerTimeInfo();
+
+  // Union the layers that are visible and are participating in time-based filtering
+  const auto timeUnion = m_layerTimes.timeUnion();
+  const TimeExtent fullTimeExtent = timeUnion.fullTimeExtent;
+  TimeValue timeStepInterval = timeUnion.timeInterval;
+  const QList<FeatureTable*> featureTables = timeUnion.featureTables;
+
+  if (!timeUnion.anyTimeAware || fullTimeExtent.isEmpty())
+    return;
+
+  const auto start = fullTimeExtent.startTime().toMSecsSinceEpoch();
+  const auto end = fullTimeExtent.endTime().toMSecsSinceEpoch();
+  const auto range = end - start;
+
+  if (timeStepInterval.isEmpty())
   {
-    auto layer = m_operationalLayers->at(i);
-    if (!layer)
-      continue;
+    TimeUnit estimatedUnit = toTimeUnit(range);
+    timeStepInterval = TimeValue(1.0, estimatedUnit);
+  }
 
-    auto timeAwareLayer = dynamic_cast<TimeAware*>(layer);
-    if (!timeAwareLayer)
-      continue;
+  // integer milliseconds, with calendar units following the calendar, so long ranges do not drift
+  const auto timeSteps = TimeSliderSteps::fromInterval(fullTimeExtent.startTime(), fullTimeExtent.endTime(), timeStepInterval);
 
-    if (layer->loadStatus() != LoadStatus::Loaded && layer->loadStatus() != LoadStatus::FailedToLoad)
-    {
-      connect(layer, &Layer::doneLoading, this, &TimeSliderController::onOperationalLayersChanged);
-      continue;
-    }
+  const bool stepsChanged = !(fullTimeExtent == m_fullTimeExtent)
+      || timeSteps != m_timeSteps;
 
-    if (!timeAwareLayer->isTimeFilteringEnabled())
-      continue;
+  if (stepsChanged)
+  {
+    setFullTimeExtent(fullTimeExtent);
+    m_timeSteps = timeSteps;
+    setNumberOfSteps(timeSteps.numberOfSteps());
 
-    if (!layer->isVisible())
-      continue;
+    // the step positions are calculated by the steps model, so update it first
+    setStepTimes();
 
-    timeAwareLayers.append(timeAwareLayer);
+    calculateStepPositions();
+
+    emit currentTimeExtentChanged();
   }
 
-  if (timeAwareLayers.empty())
-    return;
+  updateDensityIndex(featureTables, stepsChanged);
+}
 
-  TimeValue timeStepInterval;
-  for (auto timeAware : qAsConst(timeAwareLayers))
+/*!
+ \internal
+
+ Requests that the time properties are recalculated once control returns to the event loop.
+ */
+void TimeSliderController::scheduleTimePropertiesUpdate()
+{
+  if (!m_updateTimer->isActive())
+    m_updateTimer->start();
+}
+
+/*!
+ \internal
+
+ Brings the per-layer cache in line with the operational layers. Only layers
+ which are new to the cache are inspected.
+ */
+void TimeSliderController::syncLayerTimeInfo()
+{
+  m_layersDirty = false;
+
+  QSet<Layer*> currentLayers;
+  const int layerCount = m_operationalLayers->rowCount();
+  currentLayers.reserve(layerCount);
+  for (int i = 0 ; i < layerCount; i++)
   {
-    if (!timeAware)
+    auto layer = m_operationalLayers->at(i);
+    if (!layer)
       continue;
 
-    setFullTimeExtent(unionTimeExtent(timeAware->fullTimeExtent(), m_fullTimeExtent));
+    currentLayers.insert(layer);
+    if (!m_layerTimes.contains(layer))
+      addLayerTimeInfo(layer);
+  }
 
-    const auto timeAwareInterval = timeAware->timeInterval();
-    if (timeStepInterval.isEmpty())
-      timeStepInterval = timeAwareInterval;
-    else if (timeAwareInterval > timeStepInterval)
-      timeStepInterval = timeAwareInterval;
+  const auto cachedLayers = m_layerTimes.layers();
+  for (auto layer : cachedLayers)
+  {
+    if (!currentLayers.contains(layer))
+      removeLayerTimeInfo(layer);
   }
+}
 
-  const auto start = m_fullTimeExtent.startTime().toMSecsSinceEpoch();
-  const auto end = m_fullTimeExtent.endTime().toMSecsSinceEpoch();
-  const auto range = end - start;
+/*!
+ \internal
+ */
+void TimeSliderController::addLayerTimeInfo(Layer* layer)
+{
+  m_layerTimes.insert(layer);
 
-  if (timeStepInterval.isEmpty())
+  QList<QMetaObject::Connection> connections;
+  if (m_layerTimes.isTimeAware(layer))
   {
-    TimeUnit estimatedUnit = toTimeUnit(range);
-    timeStepInterval = TimeValue(1.0, estimatedUnit);
+    connections.append(connect(layer, &Layer::doneLoading, this, [this, layer]()
+    {
+      updateLayerTimeInfo(layer);
+      scheduleTimePropertiesUpdate();
+    }));
   }
 
-  m_intervalMS = toMilliseconds(timeStepInterval);
+  connections.append(connect(layer, &QObject::destroyed, this, [this, layer]()
+  {
+    m_layerTimes.remove(layer);
+    m_layerConnections.remove(layer);
+    scheduleTimePropertiesUpdate();
+  }));
 
-  setNumberOfSteps((range / m_intervalMS) + 1);
+  m_layerConnections.insert(layer, connections);
+  updateLayerTimeInfo(layer);
+}
 
-  calculateStepPositions();
+/*!
+ \internal
+ */
+void TimeSliderController::updateLayerTimeInfo(Layer* layer)
+{
+  if (!m_layerTimes.isTimeAware(layer))
+    return;
 
-  setStepTimes();
+  const bool loaded = layer->loadStatus() == LoadStatus::Loaded || layer->loadStatus() == LoadStatus::FailedToLoad;
+  if (!loaded)
+    return;
 
-  emit currentTimeExtentChanged();
+  auto timeAwareLayer = dynamic_cast<TimeAware*>(layer);
+  m_layerTimes.setTimeProperties(layer, timeAwareLayer->fullTimeExtent(), timeAwareLayer->timeInterval());
+}
+
+/*!
+ \internal
+ */
+void TimeSliderController::removeLayerTimeInfo(Layer* layer)
+{
+  const auto connections = m_layerConnections.take(layer);
+  for (const auto& connection : connections)
+    disconnect(connection);
+
+  m_layerTimes.remove(layer);
+}
+
+/*!
+ \internal
+ */
+void TimeSliderController::clearLayerTimeInfo()
+{
+  for (const auto& connections : qAsConst(m_layerConnections))
+  {
+    for (const auto& connection : connections)
+      disconnect(connection);
+  }
+
+  m_layerConnections.clear();
+  m_layerTimes.clear();
+  m_layersDirty = true;
+}
+
+/*!
+ \internal
+ */
+void TimeSliderController::setOperationalLayers(LayerListModel* operationalLayers)
+{
+  if (operationalLayers == m_operationalLayers)
+    return;
+
+  for (const auto& connection : qAsConst(m_operationalLayersConnections))
+    disconnect(connection);
+  m_operationalLayersConnections.clear();
+  clearLayerTimeInfo();
+
+  m_operationalLayers = operationalLayers;
+  if (!m_operationalLayers)
+    return;
+
+  m_operationalLayersConnections.append(connect(m_operationalLayers, &LayerListModel::layerAdded, this, &TimeSliderController::onOperationalLayersChanged));
+  m_operationalLayersConnections.append(connect(m_operationalLayers, &LayerListModel::layerRemoved, this, &TimeSliderController::onOperationalLayersChanged));
 }
 
 /*!
@@ -312,12 +456,14 @@ void TimeSliderController::setNumberOfSteps(int numberOfSteps)
   emit numberOfStepsChanged();
 }
 
+/*!
+ \internal
+
+ Updates the steps model. The step times themselves are only calculated when requested.
+ */
 void TimeSliderController::setStepTimes()
 {
-  m_stepTimes.clear();
-
-  for (auto i = 0; i < m_numberOfSteps; ++i)
-    m_stepTimes.push_back( m_fullTimeExtent.startTime().addMSecs(i * m_intervalMS) );
+  m_steps->setSteps(m_timeSteps);
 
   emit stepTimesChanged();
 }
@@ -397,14 +543,55 @@ int TimeSliderController::endStep() const
   return m_endStep;
 }
 
+/*!
+ \brief Returns the start time of every step.
+
+ The list is built each time it is requested, and holds one entry per step.
+ For large numbers of steps use \l stepTime or the \l steps model instead.
+
+ \sa numberOfSteps
+ */
 QVariantList TimeSliderController::stepTimes() const
 {
-  return m_stepTimes;
+  QVariantList stepTimes;
+  stepTimes.reserve(qMax(0, m_numberOfSteps));
+  for (auto i = 0; i < m_numberOfSteps; ++i)
+    stepTimes.push_back(stepTime(i));
+
+  return stepTimes;
+}
+
+/*!
+ \brief Returns the steps as a list model with a \c stepTime role.
+ \since Esri::ArcGISRuntime 100.5
+
+ Each step time is calculated when it is requested.
+
+ \sa TimeSliderStepsModel
+ */
+QAbstractListModel* TimeSliderController::steps() const
+{
+  return m_steps;
+}
+
+/*!
+ \brief Returns the start time of the step \a stepIndex.
+ \since Esri::ArcGISRuntime 100.5
+
+ Returns an invalid QDateTime if there is no such step.
+
+ \sa numberOfSteps
+ */
+QDateTime TimeSliderController::stepTime(int stepIndex) const
+{
+  return m_steps->stepTime(stepIndex);
 }
 
 /*!
  \brief Sets the start step index of the current time extent to \a intervalIndex.
 
+ Indexes outside the steps are clamped to the first or last step.
+
  \sa numberOfSteps
  */
 void TimeSliderController::setStartInterval(int intervalIndex)
@@ -412,22 +599,17 @@ void TimeSliderController::setStartInterval(int intervalIndex)
   if (m_fullTimeExtent.isEmpty())
       return;
 
-  const auto start = m_fullTimeExtent.startTime().toMSecsSinceEpoch();
-  const auto newStart = QDateTime::fromMSecsSinceEpoch(start + (intervalIndex * m_intervalMS));
-
-  auto newExtent = TimeExtent(newStart, currentExtentEnd());
-  if (m_sceneView)
-    m_sceneView->setTimeExtent(newExtent);
-  else if (m_mapView)
-    m_mapView->setTimeExtent(newExtent);
-
-  calculateStepPositions();
-  emit currentTimeExtentChanged();
+  // calendar steps clamp their times to the range, so the index is clamped to match
+  intervalIndex = qBound(0, intervalIndex, m_timeSteps.numberOfSteps() - 1);
+  const auto newStart = m_timeSteps.toDateTime(m_timeSteps.stepStart(intervalIndex));
+  applyTimeExtent(TimeExtent(newStart, currentExtentEnd()), intervalIndex, m_endStep);
 }
 
 /*!
  \brief Sets the end step index of the current time extent to \a intervalIndex.
 
+ Indexes outside the steps are clamped to the first or last step.
+
  \sa numberOfSteps
  */
 void TimeSliderController::setEndInterval(int intervalIndex)
@@ -435,22 +617,16 @@ void TimeSliderController::setEndInterval(int intervalIndex)
   if (m_fullTimeExtent.isEmpty())
     return;
 
-  const auto start = m_fullTimeExtent.startTime().toMSecsSinceEpoch();
-  const auto newEnd = QDateTime::fromMSecsSinceEpoch(start + (intervalIndex * m_intervalMS));
-
-  auto newExtent = TimeExtent(currentExtentStart(), newEnd);
-  if (m_sceneView)
-    m_sceneView->setTimeExtent(newExtent);
-  else if (m_mapView)
-    m_mapView->setTimeExtent(newExtent);
-
-  calculateStepPositions();
-  emit currentTimeExtentChanged();
+  intervalIndex = qBound(0, intervalIndex, m_timeSteps.numberOfSteps() - 1);
+  const auto newEnd = m_timeSteps.toDateTime(m_timeSteps.stepStart(intervalIndex));
+  applyTimeExtent(TimeExtent(currentExtentStart(), newEnd), m_startStep, intervalIndex);
 }
 
 /*!
  \brief Sets the start and end steps of the current time extent to \a startIndex and \a endIndex.
 
+ Indexes outside the steps are clamped to the first or last step.
+
  \sa numberOfSteps
  */
 void TimeSliderController::setStartAndEndIntervals(int startIndex, int endIndex)
@@ -458,17 +634,38 @@ void TimeSliderController::setStartAndEndIntervals(int startIndex, int endIndex)
   if (m_fullTimeExtent.isEmpty())
     return;
 
-  const auto start = m_fullTimeExtent.startTime().toMSecsSinceEpoch();
-  const auto newStart = QDateTime::fromMSecsSinceEpoch(start + (startIndex * m_intervalMS));
-  const auto newEnd = QDateTime::fromMSecsSinceEpoch(start + (endIndex * m_intervalMS));
+  startIndex = qBound(0, startIndex, m_timeSteps.numberOfSteps() - 1);
+  endIndex = qBound(0, endIndex, m_timeSteps.numberOfSteps() - 1);
+  const auto newStart = m_timeSteps.toDateTime(m_timeSteps.stepStart(startIndex));
+  const auto newEnd = m_timeSteps.toDateTime(m_timeSteps.stepStart(endIndex));
+  applyTimeExtent(TimeExtent(newStart, newEnd), startIndex, endIndex);
+}
 
-  auto newExtent = TimeExtent(newStart, newEnd);
+/*!
+ \internal
+
+ Sets the time extent of the geoView to \a timeExtent, which starts at the
+ step \a startStep and ends at the step \a endStep. The steps are already
+ known, so they are not looked up from the new extent again.
+ */
+void TimeSliderController::applyTimeExtent(const TimeExtent& timeExtent, int startStep, int endStep)
+{
   if (m_sceneView)
-    m_sceneView->setTimeExtent(newExtent);
+    m_sceneView->setTimeExtent(timeExtent);
   else if (m_mapView)
-    m_mapView->setTimeExtent(newExtent);
+    m_mapView->setTimeExtent(timeExtent);
+
+  // without a geoView the current extent is the full extent, so its steps are looked up
+  if (m_sceneView || m_mapView)
+  {
+    setStartStep(startStep);
+    setEndStep(endStep);
+  }
+  else
+  {
+    calculateStepPositions();
+  }
 
-  calculateStepPositions();
   emit currentTimeExtentChanged();
 }
 
@@ -492,12 +689,9 @@ void TimeSliderController::calculateStepPositions()
   if (m_fullTimeExtent.isEmpty())
     return;
 
-  const auto fullStartMs = fullExtentStart().toMSecsSinceEpoch();
-  m_startStep = (currentExtentStart().toMSecsSinceEpoch() - fullStartMs) / m_intervalMS;
-  m_endStep = (currentExtentEnd().toMSecsSinceEpoch() - fullStartMs) / m_intervalMS;
-
-  emit startStepChanged();
-  emit endStepChanged();
+  const auto extent = currentTimeExtent();
+  setStartStep(m_steps->stepIndex(extent.startTime()));
+  setEndStep(m_steps->stepIndex(extent.endTime()));
 }
 
 /*!
@@ -542,7 +736,8 @@ int TimeSliderController::numberOfSteps() const
  */
 void TimeSliderController::onOperationalLayersChanged()
 {
-  initializeTimeProperties();
+  m_layersDirty = true;
+  scheduleTimePropertiesUpdate();
 }
 
 /*!
@@ -553,9 +748,7 @@ void TimeSliderController::onMapChanged()
   if (!m_mapView->map())
     return;
 
-  m_operationalLayers = m_mapView->map()->operationalLayers();
-  connect(m_operationalLayers, &LayerListModel::layerAdded, this, &TimeSliderController::onOperationalLayersChanged);
-  connect(m_operationalLayers, &LayerListModel::layerRemoved, this, &TimeSliderController::onOperationalLayersChanged);
+  setOperationalLayers(m_mapView->map()->operationalLayers());
   initializeTimeProperties();
 }
 
@@ -567,12 +760,505 @@ void TimeSliderController::onSceneChanged()
   if (!m_sceneView->arcGISScene())
     return;
 
-  m_operationalLayers = m_sceneView->arcGISScene()->operationalLayers();
-  connect(m_operationalLayers, &LayerListModel::layerAdded, this, &TimeSliderController::onOperationalLayersChanged);
-  connect(m_operationalLayers, &LayerListModel::layerRemoved, this, &TimeSliderController::onOperationalLayersChanged);
+  setOperationalLayers(m_sceneView->arcGISScene()->operationalLayers());
   initializeTimeProperties();
 }
 
+/*!
+ \brief Starts playback of the time steps.
+
+ \sa playing
+ */
+void TimeSliderController::play()
+{
+  setPlaying(true);
+}
+
+/*!
+ \brief Pauses playback of the time steps.
+
+ \sa playing
+ */
+void TimeSliderController::pause()
+{
+  setPlaying(false);
+}
+
+/*!
+ \brief Moves the current time extent forward by one step.
+
+ Pinned ends of the time extent do not move.
+ */
+void TimeSliderController::stepForward()
+{
+  const int lastStep = m_numberOfSteps - 1;
+  const int delta = stepDelta(1, false);
+  setStartAndEndIntervals(m_startTimePinned ? m_startStep : qMin(m_startStep + delta, lastStep),
+                          m_endTimePinned ? m_endStep : qMin(m_endStep + delta, lastStep));
+}
+
+/*!
+ \brief Moves the current time extent back by one step.
+
+ Pinned ends of the time extent do not move.
+ */
+void TimeSliderController::stepBack()
+{
+  const int delta = stepDelta(-1, false);
+  setStartAndEndIntervals(m_startTimePinned ? m_startStep : qMax(m_startStep + delta, 0),
+                          m_endTimePinned ? m_endStep : qMax(m_endStep + delta, 0));
+}
+
+/*!
+ \property TimeSliderController::playing
+ \brief Whether the time extent is being animated through the steps.
+ \since Esri::ArcGISRuntime 100.5
+
+ Each step is shown for at least \l playbackInterval milliseconds. When
+ \l waitForDrawing is \c true, playback also waits for the geoView to finish
+ drawing a step before moving to the next one, so the animation runs no
+ faster than the view can draw.
+
+ The default is \c false.
+ */
+bool TimeSliderController::isPlaying() const
+{
+  return m_playing;
+}
+
+void TimeSliderController::setPlaying(bool playing)
+{
+  if (playing == m_playing)
+    return;
+
+  m_playing = playing;
+  if (m_playing)
+    scheduleNextFrame(false);
+  else
+    m_playbackTimer->stop();
+
+  emit playingChanged();
+}
+
+/*!
+ \property TimeSliderController::playbackLoop
+ \brief Whether to loop when playback reaches the end of the steps.
+ \since Esri::ArcGISRuntime 100.5
+
+ The default is \c true.
+ */
+bool TimeSliderController::playbackLoop() const
+{
+  return m_playbackLoop;
+}
+
+void TimeSliderController::setPlaybackLoop(bool playbackLoop)
+{
+  if (playbackLoop == m_playbackLoop)
+    return;
+
+  m_playbackLoop = playbackLoop;
+  emit playbackLoopChanged();
+}
+
+/*!
+ \property TimeSliderController::playbackReverse
+ \brief Whether to reverse the playback direction when playback reaches
+ the end of the steps.
+ \since Esri::ArcGISRuntime 100.5
+
+ \note This property has no effect if \l playbackLoop is \c false.
+
+ The default is \c false.
+ */
+bool TimeSliderController::playbackReverse() const
+{
+  return m_playbackReverse;
+}
+
+void TimeSliderController::setPlaybackReverse(bool playbackReverse)
+{
+  if (playbackReverse == m_playbackReverse)
+    return;
+
+  m_playbackReverse = playbackReverse;
+  emit playbackReverseChanged();
+}
+
+/*!
+ \property TimeSliderController::playbackInterval
+ \brief The minimum time in milliseconds that each step is shown during playback.
+ \since Esri::ArcGISRuntime 100.5
+
+ The default is \c 500.
+ */
+int TimeSliderController::playbackInterval() const
+{
+  return m_playbackInterval;
+}
+
+void TimeSliderController::setPlaybackInterval(int playbackInterval)
+{
+  playbackInterval = qMax(0, playbackInterval);
+  if (playbackInterval == m_playbackInterval)
+    return;
+
+  m_playbackInterval = playbackInterval;
+  emit playbackIntervalChanged();
+}
+
+/*!
+ \property TimeSliderController::waitForDrawing
+ \brief Whether playback waits for the geoView to finish drawing each step.
+ \since Esri::ArcGISRuntime 100.5
+
+ A step which does not make the view draw moves on after the playback
+ interval. If the view does not report that drawing has completed, playback
+ moves on after a few seconds.
+
+ The default is \c true.
+ */
+bool TimeSliderController::waitForDrawing() const
+{
+  return m_waitForDrawing;
+}
+
+void TimeSliderController::setWaitForDrawing(bool waitForDrawing)
+{
+  if (waitForDrawing == m_waitForDrawing)
+    return;
+
+  m_waitForDrawing = waitForDrawing;
+  if (!m_waitForDrawing && m_awaitingDraw)
+    onDrawCompleted();
+
+  emit waitForDrawingChanged();
+}
+
+/*!
+ \property TimeSliderController::startTimePinned
+ \brief Whether the start of the current time extent stays fixed while
+ stepping and during playback.
+ \since Esri::ArcGISRuntime 100.5
+
+ The default is \c false.
+ */
+bool TimeSliderController::isStartTimePinned() const
+{
+  return m_startTimePinned;
+}
+
+void TimeSliderController::setStartTimePinned(bool startTimePinned)
+{
+  if (startTimePinned == m_startTimePinned)
+    return;
+
+  m_startTimePinned = startTimePinned;
+  emit startTimePinnedChanged();
+}
+
+/*!
+ \property TimeSliderController::endTimePinned
+ \brief Whether the end of the current time extent stays fixed while
+ stepping and during playback.
+ \since Esri::ArcGISRuntime 100.5
+
+ The default is \c false.
+ */
+bool TimeSliderController::isEndTimePinned() const
+{
+  return m_endTimePinned;
+}
+
+void TimeSliderController::setEndTimePinned(bool endTimePinned)
+{
+  if (endTimePinned == m_endTimePinned)
+    return;
+
+  m_endTimePinned = endTimePinned;
+  emit endTimePinnedChanged();
+}
+
+/*!
+ \internal
+ */
+void TimeSliderController::connectDrawStatus()
+{
+  disconnect(m_drawStatusConnection);
+  m_awaitingDraw = false;
+  m_viewDrawing = false;
+
+  auto handler = [this](DrawStatus drawStatus)
+  {
+    m_viewDrawing = drawStatus == DrawStatus::InProgress;
+    if (drawStatus == DrawStatus::Completed)
+      onDrawCompleted();
+  };
+
+  if (m_mapView)
+    m_drawStatusConnection = connect(m_mapView, &MapQuickView::drawStatusChanged, this, handler);
+  else if (m_sceneView)
+    m_drawStatusConnection = connect(m_sceneView, &SceneQuickView::drawStatusChanged, this, handler);
+}
+
+/*!
+ \internal
+
+ Starts the timer for the next playback frame. When \a awaitDrawing is
+ \c true the frame also waits for the view to finish drawing.
+ */
+void TimeSliderController::scheduleNextFrame(bool awaitDrawing)
+{
+  m_awaitingDraw = awaitDrawing && m_waitForDrawing && geoView();
+  m_frameClock.start();
+  m_playbackTimer->start(m_playbackInterval);
+}
+
+/*!
+ \internal
+ */
+void TimeSliderController::onPlaybackTimeout()
+{
+  if (!m_playing)
+    return;
+
+  if (m_awaitingDraw)
+  {
+    // a step which needs no redraw never completes a draw, so only wait while the view is
+    // drawing, and not forever
+    const auto waited = m_frameClock.elapsed();
+    if (m_viewDrawing && waited < maximumDrawWaitMS)
+    {
+      m_playbackTimer->start(static_cast<int>(maximumDrawWaitMS - waited));
+      return;
+    }
+
+    m_awaitingDraw = false;
+  }
+
+  advancePlayback();
+}
+
+/*!
+ \internal
+ */
+void TimeSliderController::onDrawCompleted()
+{
+  if (!m_awaitingDraw)
+    return;
+
+  m_awaitingDraw = false;
+  if (!m_playing)
+    return;
+
+  // the minimum interval has already passed, so there is no reason to wait any longer
+  if (m_frameClock.elapsed() >= m_playbackInterval)
+  {
+    m_playbackTimer->stop();
+    advancePlayback();
+  }
+}
+
+/*!
+ \internal
+
+ Moves playback on by one step, handling the end of the steps according to
+ \l playbackLoop, \l playbackReverse and the pinned ends of the time extent.
+ */
+void TimeSliderController::advancePlayback()
+{
+  if (m_numberOfSteps <= 0)
+  {
+    setPlaying(false);
+    return;
+  }
+
+  const int lastStep = m_numberOfSteps - 1;
+  int newStart = -1;
+  int newEnd = -1;
+  bool atEnd = false;
+
+  if (m_needsRestart)
+  {
+    newStart = 0;
+    newEnd = m_endStep - m_startStep;
+    m_needsRestart = false;
+    atEnd = newEnd == lastStep;
+  }
+  else
+  {
+    const int delta = stepDelta(m_animateReverse ? -1 : 1, true);
+    newStart = m_startStep + delta;
+    newEnd = m_endStep + delta;
+
+    atEnd = (!m_startTimePinned && (newStart < 0 || newStart > lastStep)) ||
+            (!m_endTimePinned && (newEnd < 0 || newEnd > lastStep));
+  }
+
+  if (!atEnd)
+  {
+    setStartAndEndIntervals(m_startTimePinned ? m_startStep : newStart,
+                            m_endTimePinned ? m_endStep : newEnd);
+    scheduleNextFrame(true);
+    return;
+  }
+
+  if (!m_playbackLoop)
+  {
+    setPlaying(false);
+    return;
+  }
+  else if (m_playbackReverse)
+  {
+    m_animateReverse = !m_animateReverse;
+  }
+  else if (m_startTimePinned || m_endTimePinned)
+  {
+    setPlaying(false);
+    return;
+  }
+  else
+  {
+    m_needsRestart = true;
+  }
+
+  scheduleNextFrame(false);
+}
+
+/*!
+ \brief Returns the number of features in the step \a stepIndex.
+ \since Esri::ArcGISRuntime 100.5
+
+ Returns \c -1 if the count is not known, for example while the density
+ index is still being built or when \l densityIndexEnabled is \c false.
+
+ \sa densityIndexEnabled
+ */
+qint64 TimeSliderController::stepCount(int stepIndex) const
+{
+  return m_densityIndex->count(stepIndex);
+}
+
+/*!
+ \property TimeSliderController::densityIndexEnabled
+ \brief Whether the controller counts the features in each step.
+ \since Esri::ArcGISRuntime 100.5
+
+ The counts are built in the background, with count queries on the feature
+ tables of the visible, time-aware feature layers. They are available from
+ \l stepCount and the \c stepCount role of \l steps, and allow
+ \l skipEmptySteps to skip steps with no data. Ranges of more than 10000
+ steps are not counted.
+
+ The default is \c false.
+ */
+bool TimeSliderController::isDensityIndexEnabled() const
+{
+  return m_densityIndexEnabled;
+}
+
+void TimeSliderController::setDensityIndexEnabled(bool densityIndexEnabled)
+{
+  if (densityIndexEnabled == m_densityIndexEnabled)
+    return;
+
+  m_densityIndexEnabled = densityIndexEnabled;
+  m_steps->setDensityIndex(m_densityIndexEnabled ? m_densityIndex : nullptr);
+
+  if (m_densityIndexEnabled)
+    initializeTimeProperties();
+  else
+  {
+    m_densityIndex->clear();
+    m_densityFeatureTables.clear();
+  }
+
+  emit densityIndexEnabledChanged();
+}
+
+/*!
+ \property TimeSliderController::densityIndexReady
+ \brief Whether the feature count of every step is known.
+ \since Esri::ArcGISRuntime 100.5
+
+ \sa densityIndexEnabled
+ */
+bool TimeSliderController::isDensityIndexReady() const
+{
+  return m_densityIndex->isReady();
+}
+
+/*!
+ \property TimeSliderController::skipEmptySteps
+ \brief Whether stepping and playback skip steps which contain no features.
+ \since Esri::ArcGISRuntime 100.5
+
+ This property only has an effect once \l densityIndexReady is \c true.
+
+ The default is \c false.
+ */
+bool TimeSliderController::skipEmptySteps() const
+{
+  return m_skipEmptySteps;
+}
+
+void TimeSliderController::setSkipEmptySteps(bool skipEmptySteps)
+{
+  if (skipEmptySteps == m_skipEmptySteps)
+    return;
+
+  m_skipEmptySteps = skipEmptySteps;
+  emit skipEmptyStepsChanged();
+}
+
+/*!
+ \internal
+
+ Rebuilds the density index if it is enabled and either the steps or the
+ set of \a featureTables have changed.
+ */
+void TimeSliderController::updateDensityIndex(QList<FeatureTable*> featureTables, bool stepsChanged)
+{
+  if (!m_densityIndexEnabled)
+    return;
+
+  std::sort(featureTables.begin(), featureTables.end());
+  if (!stepsChanged && featureTables == m_densityFeatureTables && m_densityIndex->numberOfSteps() == m_numberOfSteps)
+    return;
+
+  m_densityFeatureTables = featureTables;
+  m_densityIndex->build(m_densityFeatureTables, m_timeSteps);
+}
+
+/*!
+ \internal
+
+ Returns how many steps to move in \a direction (1 or -1) so that the time
+ extent contains data. Without a complete density index this is always one
+ step. If no later step has data, \a stopAtEnd returns a move past the
+ last step, otherwise a single step is returned.
+ */
+int TimeSliderController::stepDelta(int direction, bool stopAtEnd) const
+{
+  if (!m_skipEmptySteps || !m_densityIndex->isReady() || (m_startTimePinned && m_endTimePinned))
+    return direction;
+
+  const int lastStep = m_numberOfSteps - 1;
+  for (int delta = direction; ; delta += direction)
+  {
+    const int newStart = m_startTimePinned ? m_startStep : m_startStep + delta;
+    const int newEnd = m_endTimePinned ? m_endStep : m_endStep + delta;
+
+    if (newStart < 0 || newEnd < 0 || newStart > lastStep || newEnd > lastStep)
+      return stopAtEnd ? delta : direction;
+
+    // the extent ends where step newEnd starts, so that step's bucket is outside it
+    const int lastCountedStep = newEnd > newStart ? newEnd - 1 : newStart;
+    if (m_densityIndex->count(newStart, lastCountedStep) != 0)
+      return delta;
+  }
+}
+
 /*!
   \fn void TimeSliderController::numberOfStepsChanged()
   \brief Signal emitted when the \l numberOfSteps property changes.
@@ -588,6 +1274,11 @@ void TimeSliderController::onSceneChanged()
   \brief Signal emitted when the \l currentTimeExtent property changes.
  */
 
+/*!
+  \fn void TimeSliderController::stepTimesChanged()
+  \brief Signal emitted when the \l stepTimes property changes.
+ */
+
 /*!
   \fn void TimeSliderController::startStepChanged()
   \brief Signal emitted when the \l startStep property changes.
@@ -598,6 +1289,62 @@ void TimeSliderController::onSceneChanged()
   \brief Signal emitted when the \l endStep property changes.
  */
 
+/*!
+  \fn void TimeSliderController::playingChanged()
+  \brief Signal emitted when the \l playing property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::playbackLoopChanged()
+  \brief Signal emitted when the \l playbackLoop property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::playbackReverseChanged()
+  \brief Signal emitted when the \l playbackReverse property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::playbackIntervalChanged()
+  \brief Signal emitted when the \l playbackInterval property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::waitForDrawingChanged()
+  \brief Signal emitted when the \l waitForDrawing property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::startTimePinnedChanged()
+  \brief Signal emitted when the \l startTimePinned property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::endTimePinnedChanged()
+  \brief Signal emitted when the \l endTimePinned property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::densityIndexEnabledChanged()
+  \brief Signal emitted when the \l densityIndexEnabled property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::densityIndexReadyChanged()
+  \brief Signal emitted when the \l densityIndexReady property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::skipEmptyStepsChanged()
+  \brief Signal emitted when the \l skipEmptySteps property changes.
+ */
+
+/*!
+  \fn void TimeSliderController::stepCountsChanged(int firstStep, int lastStep)
+  \brief Signal emitted when the feature counts of the steps \a firstStep
+  to \a lastStep change.
+ */
+
 } // Toolkit
 } // ArcGISRuntime
 } // Esri
@@ -0,0 +1,437 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "TimeSliderDensityIndex.h"
+
+// C++ API headers
+#include "FeatureTable.h"
+#include "QueryParameters.h"
+#include "TimeExtent.h"
+
+// Qt headers
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(lcToolkitDensityIndex, "esri.toolkit.timeslider.densityindex")
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::TimeSliderDensityIndex
+  \internal
+
+  Counts the features in each step of a TimeSliderController, so that steps
+  with no data can be skipped.
+
+  The counts come from one \c queryFeatureCount per feature table and step,
+  with only a few queries running at once. A step's count is \c -1 until
+  every table has reported it. If a table reports an error, the index stops
+  building and its steps stay unknown. A table destroyed while the index
+  builds is left out of the steps it has not reported.
+
+  The queries are made in step order as earlier ones complete, so memory
+  does not grow with the number of queries. Ranges of more than
+  \l maximumIndexedSteps steps are not indexed at all, as counting them
+  would take too many queries.
+ */
+
+/*!
+  \internal
+ */
+TimeSliderDensityIndex::TimeSliderDensityIndex(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \internal
+ */
+TimeSliderDensityIndex::~TimeSliderDensityIndex()
+{
+  clear();
+}
+
+/*!
+  \internal
+
+  Starts counting the features of \a featureTables in each of the \a steps.
+  Any build which is still running is cancelled.
+ */
+void TimeSliderDensityIndex::build(const QList<FeatureTable*>& featureTables, const TimeSliderSteps& steps)
+{
+  clear();
+
+  const int numberOfSteps = steps.numberOfSteps();
+  if (featureTables.isEmpty() || numberOfSteps <= 0)
+    return;
+
+  if (numberOfSteps > maximumIndexedSteps())
+  {
+    qCDebug(lcToolkitDensityIndex, "Not indexing %d steps, which is more than %d", numberOfSteps, maximumIndexedSteps());
+    return;
+  }
+
+  m_steps = steps;
+  m_counts.fill(-1, numberOfSteps);
+  m_partialCounts.fill(0, numberOfSteps);
+  m_outstanding.fill(featureTables.size(), numberOfSteps);
+  m_remainingSteps = numberOfSteps;
+
+  for (auto featureTable : featureTables)
+  {
+    m_connections.append(connect(featureTable, &FeatureTable::queryFeatureCountCompleted, this,
+                                 [this, featureTable](QUuid taskId, qint64 count)
+    {
+      onQueryFeatureCountCompleted(featureTable, taskId, count);
+    }));
+
+    m_connections.append(connect(featureTable, &FeatureTable::errorOccurred, this, [this, featureTable]()
+    {
+      onQueryError(featureTable);
+    }));
+
+    m_connections.append(connect(featureTable, &QObject::destroyed, this, [this]()
+    {
+      onTableDestroyed();
+    }));
+  }
+
+  m_featureTables.reserve(featureTables.size());
+  for (auto featureTable : featureTables)
+    m_featureTables.append(featureTable);
+
+  startQueries();
+}
+
+/*!
+  \internal
+
+  Cancels any running queries and forgets all counts.
+ */
+void TimeSliderDensityIndex::clear()
+{
+  for (const auto& connection : qAsConst(m_connections))
+    disconnect(connection);
+  m_connections.clear();
+
+  for (auto it = m_taskWatchers.begin(); it != m_taskWatchers.end(); ++it)
+    it.value().cancel();
+
+  m_taskWatchers.clear();
+  m_running.clear();
+  m_featureTables.clear();
+  m_nextStep = 0;
+  m_nextTable = 0;
+
+  const int oldSteps = m_counts.size();
+  m_counts.clear();
+  m_partialCounts.clear();
+  m_outstanding.clear();
+  m_cumulativeCounts.clear();
+  m_remainingSteps = 0;
+
+  setReady(false);
+
+  if (oldSteps > 0)
+    emit countsChanged(0, oldSteps - 1);
+}
+
+/*!
+  \internal
+
+  Returns whether the count of every step is known.
+ */
+bool TimeSliderDensityIndex::isReady() const
+{
+  return m_ready;
+}
+
+/*!
+  \internal
+ */
+int TimeSliderDensityIndex::numberOfSteps() const
+{
+  return m_counts.size();
+}
+
+/*!
+  \internal
+
+  Returns the number of features in the step \a stepIndex, or \c -1 if it is not known.
+ */
+qint64 TimeSliderDensityIndex::count(int stepIndex) const
+{
+  if (stepIndex < 0 || stepIndex >= m_counts.size())
+    return -1;
+
+  return m_counts.at(stepIndex);
+}
+
+/*!
+  \internal
+
+  Returns the number of features in the steps from \a firstStep to
+  \a lastStep inclusive, or \c -1 if any of them is not known.
+ */
+qint64 TimeSliderDensityIndex::count(int firstStep, int lastStep) const
+{
+  if (firstStep > lastStep)
+    qSwap(firstStep, lastStep);
+
+  if (firstStep < 0 || lastStep >= m_counts.size())
+    return -1;
+
+  if (m_ready)
+    return m_cumulativeCounts.at(lastStep + 1) - m_cumulativeCounts.at(firstStep);
+
+  qint64 total = 0;
+  for (int i = firstStep; i <= lastStep; ++i)
+  {
+    const auto stepCount = m_counts.at(i);
+    if (stepCount < 0)
+      return -1;
+
+    total += stepCount;
+  }
+
+  return total;
+}
+
+/*!
+  \internal
+ */
+int TimeSliderDensityIndex::maximumQueriesInFlight() const
+{
+  return m_maximumQueriesInFlight;
+}
+
+/*!
+  \internal
+ */
+void TimeSliderDensityIndex::setMaximumQueriesInFlight(int maximumQueriesInFlight)
+{
+  m_maximumQueriesInFlight = qMax(1, maximumQueriesInFlight);
+  startQueries();
+}
+
+/*!
+  \internal
+
+  Returns the most steps which are indexed. Above it, the counts of all
+  steps stay unknown.
+ */
+int TimeSliderDensityIndex::maximumIndexedSteps()
+{
+  return 10000;
+}
+
+/*!
+  \internal
+ */
+void TimeSliderDensityIndex::startQueries()
+{
+  // query step by step, so the start of the range fills in first
+  while (!m_featureTables.isEmpty() && m_nextStep < m_counts.size() && m_running.size() < m_maximumQueriesInFlight)
+  {
+    PendingQuery query;
+    query.featureTable = m_featureTables.at(m_nextTable);
+    query.stepIndex = m_nextStep;
+    if (++m_nextTable == m_featureTables.size())
+    {
+      m_nextTable = 0;
+      ++m_nextStep;
+    }
+
+    if (!query.featureTable)
+    {
+      abandon();
+      return;
+    }
+
+    const auto stepStart = m_steps.stepTime(query.stepIndex);
+    // end the bucket just before the next step starts, so no feature is counted twice
+    const auto stepEnd = m_steps.toDateTime(m_steps.stepStart(query.stepIndex + 1) - 1);
+
+    QueryParameters parameters;
+    parameters.setWhereClause(QStringLiteral("1=1"));
+    parameters.setTimeExtent(TimeExtent(stepStart, stepEnd));
+
+    auto taskWatcher = query.featureTable->queryFeatureCount(parameters);
+    if (!taskWatcher.isValid())
+    {
+      abandon();
+      return;
+    }
+
+    m_running.insert(taskWatcher.taskId(), query);
+    m_taskWatchers.insert(taskWatcher.taskId(), taskWatcher);
+  }
+}
+
+/*!
+  \internal
+ */
+void TimeSliderDensityIndex::onQueryFeatureCountCompleted(FeatureTable* featureTable, QUuid taskId, qint64 count)
+{
+  auto it = m_running.find(taskId);
+  if (it == m_running.end() || it->featureTable != featureTable)
+    return;
+
+  const int stepIndex = it->stepIndex;
+  m_running.erase(it);
+  m_taskWatchers.remove(taskId);
+
+  addCount(stepIndex, count);
+  startQueries();
+}
+
+/*!
+  \internal
+ */
+void TimeSliderDensityIndex::onQueryError(FeatureTable* featureTable)
+{
+  // the table may report errors from other operations, so only react while it has queries running
+  for (const auto& query : qAsConst(m_running))
+  {
+    if (query.featureTable == featureTable)
+    {
+      abandon();
+      return;
+    }
+  }
+}
+
+/*!
+  \internal
+
+  A destroyed table no longer has features to count, so the steps it has not
+  reported yet are completed without it, rather than waiting for queries
+  which will never finish.
+ */
+void TimeSliderDensityIndex::onTableDestroyed()
+{
+  // the table's queries are those whose table pointer has just been cleared
+  for (auto it = m_running.begin(); it != m_running.end();)
+  {
+    if (it->featureTable)
+    {
+      ++it;
+      continue;
+    }
+
+    const int stepIndex = it->stepIndex;
+    m_taskWatchers.remove(it.key());
+    it = m_running.erase(it);
+    addCount(stepIndex, 0);
+  }
+
+  for (int table = m_featureTables.size() - 1; table >= 0; --table)
+  {
+    if (m_featureTables.at(table))
+      continue;
+
+    // tables before the cursor have already been asked for the cursor's step
+    const int firstUnqueriedStep = table < m_nextTable ? m_nextStep + 1 : m_nextStep;
+    for (int stepIndex = firstUnqueriedStep; stepIndex < m_counts.size(); ++stepIndex)
+      addCount(stepIndex, 0);
+
+    m_featureTables.removeAt(table);
+    if (table < m_nextTable)
+      --m_nextTable;
+  }
+
+  if (m_nextTable >= m_featureTables.size())
+  {
+    m_nextTable = 0;
+    if (!m_featureTables.isEmpty())
+      ++m_nextStep;
+  }
+
+  startQueries();
+}
+
+/*!
+  \internal
+
+  Stops building the index. Steps which are already counted keep their counts.
+ */
+void TimeSliderDensityIndex::abandon()
+{
+  qCWarning(lcToolkitDensityIndex, "Could not count the features of a time-aware layer, so empty steps cannot be skipped");
+
+  for (const auto& connection : qAsConst(m_connections))
+    disconnect(connection);
+  m_connections.clear();
+
+  for (auto it = m_taskWatchers.begin(); it != m_taskWatchers.end(); ++it)
+    it.value().cancel();
+  m_taskWatchers.clear();
+  m_running.clear();
+  m_featureTables.clear();
+}
+
+/*!
+  \internal
+
+  Adds the \a count of one table to the step \a stepIndex.
+ */
+void TimeSliderDensityIndex::addCount(int stepIndex, qint64 count)
+{
+  m_partialCounts[stepIndex] += count;
+  if (--m_outstanding[stepIndex] == 0)
+  {
+    m_counts[stepIndex] = m_partialCounts.at(stepIndex);
+    finishStep(stepIndex);
+  }
+}
+
+/*!
+  \internal
+ */
+void TimeSliderDensityIndex::finishStep(int stepIndex)
+{
+  emit countsChanged(stepIndex, stepIndex);
+
+  if (--m_remainingSteps > 0)
+    return;
+
+  m_cumulativeCounts.resize(m_counts.size() + 1);
+  m_cumulativeCounts[0] = 0;
+  for (int i = 0; i < m_counts.size(); ++i)
+    m_cumulativeCounts[i + 1] = m_cumulativeCounts.at(i) + m_counts.at(i);
+
+  setReady(true);
+}
+
+/*!
+  \internal
+ */
+void TimeSliderDensityIndex::setReady(bool ready)
+{
+  if (ready == m_ready)
+    return;
+
+  m_ready = ready;
+  emit readyChanged();
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "TimeSliderLayerTimes.h"
+
+// C++ API headers
+#include "FeatureLayer.h"
+#include "Layer.h"
+#include "TimeAware.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+TimeExtent unionTimeExtent(const TimeExtent& timeExtent, const TimeExtent& otherTimeExtent)
+{
+  if (otherTimeExtent.isEmpty())
+    return timeExtent;
+
+  auto startTime = timeExtent.startTime() < otherTimeExtent.startTime() ? timeExtent.startTime() : otherTimeExtent.startTime();
+  auto endTime = timeExtent.endTime() > otherTimeExtent.endTime() ? timeExtent.endTime() : otherTimeExtent.endTime();
+
+  return TimeExtent(startTime, endTime);
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::TimeSliderLayerTimes
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \internal
+  \brief The time properties of the layers of a TimeSliderController.
+
+  The properties of each layer are read once, when it finishes loading, so
+  that finding the full time extent and interval of many layers does not
+  query each of them again.
+ */
+
+/*!
+  \internal
+ */
+bool TimeSliderLayerTimes::contains(Layer* layer) const
+{
+  return m_entries.contains(layer);
+}
+
+/*!
+  \internal
+ */
+bool TimeSliderLayerTimes::isTimeAware(Layer* layer) const
+{
+  return m_entries.value(layer).timeAware;
+}
+
+/*!
+  \internal
+ */
+QList<Layer*> TimeSliderLayerTimes::layers() const
+{
+  return m_entries.keys();
+}
+
+/*!
+  \internal
+
+  Adds \a layer, whose time properties are not known until
+  \l setTimeProperties is called.
+ */
+void TimeSliderLayerTimes::insert(Layer* layer)
+{
+  Entry entry;
+  entry.timeAware = dynamic_cast<TimeAware*>(layer) != nullptr;
+  m_entries.insert(layer, entry);
+}
+
+/*!
+  \internal
+
+  Sets the time properties of \a layer, once it has loaded, to
+  \a fullTimeExtent and \a timeInterval.
+ */
+void TimeSliderLayerTimes::setTimeProperties(Layer* layer, const TimeExtent& fullTimeExtent, const TimeValue& timeInterval)
+{
+  auto it = m_entries.find(layer);
+  if (it == m_entries.end() || !it->timeAware)
+    return;
+
+  it->loaded = true;
+  it->fullTimeExtent = fullTimeExtent;
+  it->timeInterval = timeInterval;
+}
+
+/*!
+  \internal
+ */
+void TimeSliderLayerTimes::remove(Layer* layer)
+{
+  m_entries.remove(layer);
+}
+
+/*!
+  \internal
+ */
+void TimeSliderLayerTimes::clear()
+{
+  m_entries.clear();
+}
+
+/*!
+  \internal
+
+  Returns the union of the time extents of the loaded layers which are
+  visible and have time filtering enabled, with the largest of their
+  intervals and their feature tables.
+ */
+TimeSliderLayerTimes::Union TimeSliderLayerTimes::timeUnion() const
+{
+  Union result;
+  for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+  {
+    const Entry& entry = it.value();
+    if (!entry.timeAware || !entry.loaded)
+      continue;
+
+    auto timeAwareLayer = dynamic_cast<TimeAware*>(it.key());
+    if (!timeAwareLayer || !timeAwareLayer->isTimeFilteringEnabled())
+      continue;
+
+    if (!it.key()->isVisible())
+      continue;
+
+    result.anyTimeAware = true;
+    result.fullTimeExtent = result.fullTimeExtent.isEmpty() ? entry.fullTimeExtent
+                                                            : unionTimeExtent(result.fullTimeExtent, entry.fullTimeExtent);
+
+    if (result.timeInterval.isEmpty() || entry.timeInterval > result.timeInterval)
+      result.timeInterval = entry.timeInterval;
+
+    auto featureLayer = dynamic_cast<FeatureLayer*>(it.key());
+    if (featureLayer && featureLayer->featureTable())
+      result.featureTables.append(featureLayer->featureTable());
+  }
+
+  return result;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,321 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "TimeSliderSteps.h"
+
+// STL headers
+#include <algorithm>
+#include <limits>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr qint64 millisecondsPerSecond = 1000;
+constexpr qint64 millisecondsPerMinute = 60 * millisecondsPerSecond;
+constexpr qint64 millisecondsPerHour = 60 * millisecondsPerMinute;
+constexpr qint64 millisecondsPerDay = 24 * millisecondsPerHour;
+constexpr qint64 millisecondsPerWeek = 7 * millisecondsPerDay;
+
+// the average Gregorian month, for calendar intervals which are not whole months
+constexpr double millisecondsPerAverageMonth = 30.436875 * millisecondsPerDay;
+
+// calendar steps beyond this many are approximated by average months rather than tabulated
+constexpr qint64 maximumCalendarSteps = 1 << 20;
+
+// returns the number of months in one calendar unit, or 0 for fixed units
+int monthsPerUnit(TimeUnit unit)
+{
+  switch (unit)
+  {
+  case TimeUnit::Centuries:
+    return 1200;
+  case TimeUnit::Decades:
+    return 120;
+  case TimeUnit::Years:
+    return 12;
+  case TimeUnit::Months:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+qint64 millisecondsPerUnit(TimeUnit unit)
+{
+  switch (unit)
+  {
+  case TimeUnit::Weeks:
+    return millisecondsPerWeek;
+  case TimeUnit::Days:
+    return millisecondsPerDay;
+  case TimeUnit::Hours:
+    return millisecondsPerHour;
+  case TimeUnit::Minutes:
+    return millisecondsPerMinute;
+  case TimeUnit::Seconds:
+    return millisecondsPerSecond;
+  default:
+    return 1;
+  }
+}
+
+int toStepIndex(qint64 stepIndex)
+{
+  return static_cast<int>(qBound<qint64>(std::numeric_limits<int>::min(), stepIndex, std::numeric_limits<int>::max()));
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::TimeSliderSteps
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \internal
+  \brief The steps of a TimeSliderController, held as integer milliseconds.
+
+  Steps of fixed units, from milliseconds to weeks, are a start and an
+  interval, so a step's time and the step containing a time are both
+  found with integer arithmetic.
+
+  Steps of calendar units, from months to centuries, follow the calendar:
+  a step of one month starting on the 31st of January ends on the last day
+  of February rather than after an average month. Their starts are
+  tabulated once, and the step containing a time is found by binary
+  search.
+
+  Neither lookup allocates, and the number of steps of a long range does
+  not drift with rounding.
+ */
+
+/*!
+  \internal
+
+  Returns the steps of \a interval from \a startTime which cover the range
+  to \a endTime, the last step being the one containing \a endTime.
+  Calendar intervals which are not a whole number of months are treated as
+  multiples of an average month.
+ */
+TimeSliderSteps TimeSliderSteps::fromInterval(const QDateTime& startTime, const QDateTime& endTime, const TimeValue& interval)
+{
+  if (!startTime.isValid() || !endTime.isValid() || endTime < startTime || interval.duration() <= 0.0)
+    return TimeSliderSteps();
+
+  const qint64 start = startTime.toMSecsSinceEpoch();
+  const qint64 end = endTime.toMSecsSinceEpoch();
+  const qint64 range = end - start;
+
+  qint64 intervalMSecs = 0;
+  const int unitMonths = monthsPerUnit(interval.unit());
+  if (unitMonths > 0)
+  {
+    const double months = interval.duration() * unitMonths;
+    const int wholeMonths = qRound(months);
+    const qint64 estimatedSteps = wholeMonths > 0 ? range / (wholeMonths * 28 * millisecondsPerDay) + 2 : 0;
+
+    if (wholeMonths > 0 && qFuzzyCompare(months, static_cast<double>(wholeMonths)) && estimatedSteps <= maximumCalendarSteps)
+    {
+      TimeSliderSteps steps = fixed(startTime, 1, 1);
+      steps.m_calendarStepStarts.reserve(static_cast<int>(estimatedSteps) + 1);
+
+      // each step is counted from the start, so short months do not shift the later steps
+      for (int i = 0; ; ++i)
+      {
+        const qint64 stepStart = startTime.addMonths(i * wholeMonths).toMSecsSinceEpoch();
+        steps.m_calendarStepStarts.append(stepStart);
+        if (stepStart > end)
+          break;
+      }
+
+      steps.m_numberOfSteps = steps.m_calendarStepStarts.size() - 1;
+      steps.m_intervalMSecs = qMax<qint64>(1, (steps.m_calendarStepStarts.last() - start) / steps.m_numberOfSteps);
+      return steps;
+    }
+
+    intervalMSecs = qRound64(months * millisecondsPerAverageMonth);
+  }
+  else
+  {
+    intervalMSecs = qRound64(interval.duration() * millisecondsPerUnit(interval.unit()));
+  }
+
+  intervalMSecs = qMax<qint64>(1, intervalMSecs);
+  const qint64 numberOfSteps = range / intervalMSecs + 1;
+  return fixed(startTime, intervalMSecs, static_cast<int>(qMin<qint64>(numberOfSteps, std::numeric_limits<int>::max())));
+}
+
+/*!
+  \internal
+
+  Returns \a numberOfSteps steps of \a intervalMSecs milliseconds from
+  \a startTime.
+ */
+TimeSliderSteps TimeSliderSteps::fixed(const QDateTime& startTime, qint64 intervalMSecs, int numberOfSteps)
+{
+  TimeSliderSteps steps;
+  if (!startTime.isValid() || intervalMSecs <= 0 || numberOfSteps <= 0)
+    return steps;
+
+  steps.m_startMSecs = startTime.toMSecsSinceEpoch();
+  steps.m_intervalMSecs = intervalMSecs;
+  steps.m_numberOfSteps = numberOfSteps;
+
+  // step times are given in the time spec of the start; a time zone is shown as local time
+  steps.m_timeSpec = startTime.timeSpec() == Qt::TimeZone ? Qt::LocalTime : startTime.timeSpec();
+  steps.m_offsetFromUtc = startTime.timeSpec() == Qt::OffsetFromUTC ? startTime.offsetFromUtc() : 0;
+
+  return steps;
+}
+
+/*!
+  \internal
+ */
+bool TimeSliderSteps::isEmpty() const
+{
+  return m_numberOfSteps == 0;
+}
+
+/*!
+  \internal
+
+  Returns whether the steps follow the calendar.
+ */
+bool TimeSliderSteps::isCalendar() const
+{
+  return !m_calendarStepStarts.isEmpty();
+}
+
+/*!
+  \internal
+ */
+int TimeSliderSteps::numberOfSteps() const
+{
+  return m_numberOfSteps;
+}
+
+/*!
+  \internal
+
+  Returns the interval between steps, which for calendar steps is their
+  average.
+ */
+qint64 TimeSliderSteps::intervalMSecs() const
+{
+  return m_intervalMSecs;
+}
+
+/*!
+  \internal
+
+  Returns the start of the step \a stepIndex in milliseconds since the
+  epoch. A \a stepIndex of \l numberOfSteps gives the end of the last step.
+
+  Fixed steps are extrapolated beyond the range, while calendar steps are
+  clamped to it.
+ */
+qint64 TimeSliderSteps::stepStart(int stepIndex) const
+{
+  if (isCalendar())
+    return m_calendarStepStarts.at(qBound(0, stepIndex, m_calendarStepStarts.size() - 1));
+
+  return m_startMSecs + stepIndex * m_intervalMSecs;
+}
+
+/*!
+  \internal
+
+  Returns the time at the start of the step \a stepIndex, or an invalid
+  QDateTime if there is no such step.
+ */
+QDateTime TimeSliderSteps::stepTime(int stepIndex) const
+{
+  if (stepIndex < 0 || stepIndex >= m_numberOfSteps)
+    return QDateTime();
+
+  return toDateTime(stepStart(stepIndex));
+}
+
+/*!
+  \internal
+
+  Returns the index of the step which contains \a msecsSinceEpoch, or
+  \c -1 if there are no steps.
+
+  Times before the first step give a negative index. Times after the last
+  step give an index past it, which for calendar steps is always
+  \l numberOfSteps.
+ */
+int TimeSliderSteps::stepIndex(qint64 msecsSinceEpoch) const
+{
+  if (m_numberOfSteps == 0)
+    return -1;
+
+  if (isCalendar())
+  {
+    const auto it = std::upper_bound(m_calendarStepStarts.cbegin(), m_calendarStepStarts.cend(), msecsSinceEpoch);
+    return static_cast<int>(it - m_calendarStepStarts.cbegin()) - 1;
+  }
+
+  // round towards negative infinity, so the step before the start is -1
+  const qint64 offset = msecsSinceEpoch - m_startMSecs;
+  const qint64 stepIndex = offset >= 0 ? offset / m_intervalMSecs
+                                       : -((-offset + m_intervalMSecs - 1) / m_intervalMSecs);
+  return toStepIndex(stepIndex);
+}
+
+/*!
+  \internal
+
+  Returns \a msecsSinceEpoch as a QDateTime in the time spec of the steps.
+ */
+QDateTime TimeSliderSteps::toDateTime(qint64 msecsSinceEpoch) const
+{
+  if (m_timeSpec == Qt::OffsetFromUTC)
+    return QDateTime::fromMSecsSinceEpoch(msecsSinceEpoch, Qt::OffsetFromUTC, m_offsetFromUtc);
+
+  return QDateTime::fromMSecsSinceEpoch(msecsSinceEpoch, m_timeSpec);
+}
+
+/*!
+  \internal
+ */
+bool TimeSliderSteps::operator==(const TimeSliderSteps& other) const
+{
+  return m_startMSecs == other.m_startMSecs &&
+         m_intervalMSecs == other.m_intervalMSecs &&
+         m_numberOfSteps == other.m_numberOfSteps &&
+         m_timeSpec == other.m_timeSpec &&
+         m_offsetFromUtc == other.m_offsetFromUtc &&
+         m_calendarStepStarts == other.m_calendarStepStarts;
+}
+
+/*!
+  \internal
+ */
+bool TimeSliderSteps::operator!=(const TimeSliderSteps& other) const
+{
+  return !(*this == other);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,239 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "TimeSliderStepsModel.h"
+#include "TimeSliderDensityIndex.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::TimeSliderStepsModel
+  \inmodule ArcGISQtToolkit
+  \ingroup ToolTimeSlider
+  \since Esri::ArcGISRuntime 100.5
+
+  \brief A list model of the time steps of a TimeSliderController.
+
+  The model holds only the start time, the interval and the number of steps,
+  as integer milliseconds. The time of each step is calculated when it is
+  requested, so a time range with a very large number of steps uses no more
+  memory than a short one. Steps of months or longer follow the calendar,
+  and only their start times are kept.
+
+  The following roles are available:
+  \table
+    \header
+        \li Role
+        \li Type
+        \li Description
+    \row
+        \li stepTime
+        \li QDateTime
+        \li The time at the start of the step.
+    \row
+        \li stepIndex
+        \li int
+        \li The index of the step.
+    \row
+        \li stepCount
+        \li qint64
+        \li The number of features in the step, or \c -1 if it is not known.
+             Counts are only available while the controller's
+             \l {TimeSliderController::densityIndexEnabled}{densityIndexEnabled}
+             is \c true.
+  \endtable
+
+  The model can also be created in QML, so that the QML API TimeSlider
+  shares the same step arithmetic. In that case \l setSteps must be
+  called to describe the steps.
+
+  \sa {Time Slider Tool}
+ */
+
+/*!
+  \brief The constructor that accepts an optional \a parent object.
+ */
+TimeSliderStepsModel::TimeSliderStepsModel(QObject* parent) :
+  QAbstractListModel(parent)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+TimeSliderStepsModel::~TimeSliderStepsModel()
+{
+}
+
+/*!
+  \internal
+ */
+int TimeSliderStepsModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return m_timeSteps.numberOfSteps();
+}
+
+/*!
+  \internal
+ */
+QVariant TimeSliderStepsModel::data(const QModelIndex& index, int role) const
+{
+  const int row = index.row();
+  if (row < 0 || row >= m_timeSteps.numberOfSteps())
+    return QVariant();
+
+  switch (role)
+  {
+  case Qt::DisplayRole:
+  case StepTimeRole:
+    return QVariant(stepTime(row));
+  case StepIndexRole:
+    return QVariant(row);
+  case StepCountRole:
+    return QVariant(m_densityIndex ? m_densityIndex->count(row) : qint64(-1));
+  default:
+    break;
+  }
+
+  return QVariant();
+}
+
+/*!
+  \property TimeSliderStepsModel::count
+  \brief The number of steps in the model.
+ */
+int TimeSliderStepsModel::count() const
+{
+  return m_timeSteps.numberOfSteps();
+}
+
+/*!
+  \brief Returns the time at the start of the step \a stepIndex.
+
+  Returns an invalid QDateTime if there is no such step.
+ */
+QDateTime TimeSliderStepsModel::stepTime(int stepIndex) const
+{
+  return m_timeSteps.stepTime(stepIndex);
+}
+
+/*!
+  \brief Returns the index of the step which contains \a time.
+
+  The index is not clamped to the range of steps, so times before the
+  first step give a negative index. Returns \c -1 if there are no steps.
+ */
+int TimeSliderStepsModel::stepIndex(const QDateTime& time) const
+{
+  if (!time.isValid())
+    return -1;
+
+  return m_timeSteps.stepIndex(time.toMSecsSinceEpoch());
+}
+
+/*!
+  \brief Sets the model to \a numberOfSteps steps of \a intervalMS milliseconds
+  from \a startTime.
+
+  The interval is rounded to whole milliseconds. The model is only reset if
+  the steps change.
+ */
+void TimeSliderStepsModel::setSteps(const QDateTime& startTime, double intervalMS, int numberOfSteps)
+{
+  setSteps(TimeSliderSteps::fixed(startTime, qRound64(intervalMS), numberOfSteps));
+}
+
+/*!
+  \internal
+
+  Sets the model to \a steps. The model is only reset if the steps change.
+ */
+void TimeSliderStepsModel::setSteps(const TimeSliderSteps& steps)
+{
+  if (steps == m_timeSteps)
+    return;
+
+  const bool countChanging = steps.numberOfSteps() != m_timeSteps.numberOfSteps();
+
+  beginResetModel();
+  m_timeSteps = steps;
+  endResetModel();
+
+  if (countChanging)
+    emit countChanged();
+}
+
+/*!
+  \internal
+ */
+const TimeSliderSteps& TimeSliderStepsModel::steps() const
+{
+  return m_timeSteps;
+}
+
+/*!
+  \internal
+
+  Sets the index which provides the \c stepCount role to \a densityIndex.
+ */
+void TimeSliderStepsModel::setDensityIndex(const TimeSliderDensityIndex* densityIndex)
+{
+  if (densityIndex == m_densityIndex)
+    return;
+
+  m_densityIndex = densityIndex;
+  updateStepCounts(0, m_timeSteps.numberOfSteps() - 1);
+}
+
+/*!
+  \internal
+
+  Notifies views that the counts of the steps \a firstStep to \a lastStep have changed.
+ */
+void TimeSliderStepsModel::updateStepCounts(int firstStep, int lastStep)
+{
+  firstStep = qMax(0, firstStep);
+  lastStep = qMin(m_timeSteps.numberOfSteps() - 1, lastStep);
+  if (firstStep > lastStep)
+    return;
+
+  emit dataChanged(index(firstStep), index(lastStep), {StepCountRole});
+}
+
+/*!
+  \internal
+ */
+QHash<int, QByteArray> TimeSliderStepsModel::roleNames() const
+{
+  return {{StepTimeRole, "stepTime"}, {StepIndexRole, "stepIndex"}, {StepCountRole, "stepCount"}};
+}
+
+/*!
+  \fn void TimeSliderStepsModel::countChanged()
+  \brief Signal emitted when the \l count property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -54,28 +54,61 @@ ToolManager::~ToolManager()
 /*! \brief Adds \a tool to the manager.
  *
  * The \l AbstractTool can be retrieved from the manager by supplying
- * the tool name or by requesting it by type.
+ * the tool name or by requesting it by type. Several tools with the same
+ * name can be registered at once.
+ *
+ * The manager also routes events: while the tool is active it is connected
+ * to the pointer and location signals of its
+ * \l {AbstractTool::resourceProvider}{resourceProvider}, and when it becomes
+ * inactive those connections are dropped, so idle tools cost nothing as
+ * events arrive.
  */
 void ToolManager::addTool(AbstractTool* tool)
 {
-  if (!tool)
+  if (!tool || m_entries.contains(tool))
     return;
 
-  // when a tool is destroyed, remove it from the manager
-  QObject::connect(tool, &AbstractTool::destroyed, tool, [this, tool]()
+  ToolEntry& entry = m_entries[tool];
+  entry.toolName = tool->toolName();
+
+  // when a tool is destroyed, remove it from the manager. The tool cannot be
+  // asked for its name at this point, so the entry remembers it
+  entry.toolConnections.append(QObject::connect(tool, &AbstractTool::destroyed, this, [this, tool]()
+  {
+    forgetTool(tool, true);
+  }));
+
+  entry.toolConnections.append(QObject::connect(tool, &AbstractTool::activeChanged, this, [this, tool]()
+  {
+    updateSubscription(tool);
+  }));
+
+  entry.toolConnections.append(QObject::connect(tool, &AbstractTool::resourceProviderChanged, this, [this, tool]()
   {
-    removeTool(tool);
-  });
+    auto it = m_entries.find(tool);
+    if (it == m_entries.end())
+      return;
+
+    unsubscribe(it.value());
+    updateSubscription(tool);
+  }));
+
+  m_tools.insert(entry.toolName, tool);
+  updateSubscription(tool);
 
-  m_tools.insert(tool->toolName(), tool);
   emit toolAdded(tool);
 }
 
-/*! \brief Removes the \l AbstractTool called \a toolName from the manager.
+/*! \brief Removes every \l AbstractTool called \a toolName from the manager.
  */
 void ToolManager::removeTool(const QString& toolName)
 {
-  m_tools.remove(toolName);
+  const auto toolsWithName = m_tools.values(toolName);
+  for (auto tool : toolsWithName)
+    forgetTool(tool, false);
+
+  if (!toolsWithName.isEmpty())
+    emit toolRemoved(toolName);
 }
 
 /*! \brief Removes the \l AbstractTool \a tool from the manager.
@@ -85,33 +118,104 @@ void ToolManager::removeTool(AbstractTool* tool)
   if (tool == nullptr)
     return;
 
-  auto it = m_tools.begin();
-  auto itEnd = m_tools.end();
-  for(; it != itEnd; ++it)
-  {
-    if (it.value() == tool)
-    {
-      emit toolRemoved(it.key());
-      m_tools.erase(it);
-      return;
-    }
-  }
+  forgetTool(tool, true);
 }
 
 /*! \brief Clears all tools from the manager.
  */
 void ToolManager::clearTools()
 {
-  m_tools.clear();
+  const auto registeredTools = m_entries.keys();
+  for (auto tool : registeredTools)
+    forgetTool(tool, false);
 }
 
 /*! \brief Retrieve the \l AbsgtractTool with the name \a toolName.
+ *
+ * If several tools share the name, the one added most recently is returned.
  *
  * return \c nullptr if the tool cannot be found.
  */
 AbstractTool* ToolManager::tool(const QString& toolName) const
 {
-  return m_tools[toolName];
+  return m_tools.value(toolName, nullptr);
+}
+
+/*! \brief Returns every \l AbstractTool with the name \a toolName, the
+ * most recently added first.
+ */
+QList<AbstractTool*> ToolManager::tools(const QString& toolName) const
+{
+  return m_tools.values(toolName);
+}
+
+/*! \brief Returns whether \a tool is currently connected to the events of its
+ * resource provider.
+ */
+bool ToolManager::isSubscribed(AbstractTool* tool) const
+{
+  const auto it = m_entries.constFind(tool);
+  return it != m_entries.constEnd() && it->subscribed;
+}
+
+/*! \internal
+ *
+ * Connects \a tool to its event streams when it is active, and disconnects it when it is not.
+ */
+void ToolManager::updateSubscription(AbstractTool* tool)
+{
+  auto it = m_entries.find(tool);
+  if (it == m_entries.end())
+    return;
+
+  if (tool->isActive())
+    subscribe(tool, it.value());
+  else
+    unsubscribe(it.value());
+}
+
+/*! \internal
+ */
+void ToolManager::subscribe(AbstractTool* tool, ToolEntry& entry)
+{
+  if (entry.subscribed)
+    return;
+
+  entry.eventConnections = tool->connectEventStreams(tool->resourceProvider());
+  entry.subscribed = true;
+}
+
+/*! \internal
+ */
+void ToolManager::unsubscribe(ToolEntry& entry)
+{
+  for (const auto& connection : qAsConst(entry.eventConnections))
+    QObject::disconnect(connection);
+
+  entry.eventConnections.clear();
+  entry.subscribed = false;
+}
+
+/*! \internal
+ *
+ * Removes \a tool in constant time, emitting \l toolRemoved if \a notify is \c true.
+ */
+void ToolManager::forgetTool(AbstractTool* tool, bool notify)
+{
+  auto it = m_entries.find(tool);
+  if (it == m_entries.end())
+    return;
+
+  unsubscribe(it.value());
+  for (const auto& connection : qAsConst(it->toolConnections))
+    QObject::disconnect(connection);
+
+  const QString toolName = it->toolName;
+  m_entries.erase(it);
+  m_tools.remove(toolName, tool);
+
+  if (notify)
+    emit toolRemoved(toolName);
 }
 
 /*! \brief Returns a begin iterator to the list of tools.
@@ -18,12 +18,17 @@
 #include "Map.h"
 #include "Scene.h"
 #include "GeoView.h"
+#include "MapQuickView.h"
 #include "MapView.h"
+#include "SceneQuickView.h"
 #include "SceneView.h"
 #include "IdentifyGraphicsOverlayResult.h"
 
 #include "ToolResourceProvider.h"
+#include "ToolkitProfiler.h"
 
+#include <QMetaMethod>
+#include <QTimer>
 #include <QUuid>
 
 namespace Esri
@@ -34,9 +39,13 @@ namespace Toolkit
 {
 
 ToolResourceProvider::ToolResourceProvider(QObject* parent /*= nullptr*/):
-  QObject(parent)
+  QObject(parent),
+  m_mouseMoveTimer(new QTimer(this))
 {
-
+  // roughly one display frame
+  m_mouseMoveTimer->setSingleShot(true);
+  m_mouseMoveTimer->setInterval(16);
+  connect(m_mouseMoveTimer, &QTimer::timeout, this, &ToolResourceProvider::flushMouseMove);
 }
 
 ToolResourceProvider* ToolResourceProvider::instance()
@@ -46,6 +55,82 @@ ToolResourceProvider* ToolResourceProvider::instance()
   return &s_instance;
 }
 
+/*! \brief Returns the resource context for \a geoView, creating it if needed.
+ *
+ * Each context only carries the map, scene and events of its own view, so
+ * tools bound to it with \l {AbstractTool::setResourceProvider}{setResourceProvider}
+ * are not notified about other views. When \a geoView is a MapQuickView or a
+ * SceneQuickView, the context follows its map or scene and forwards its mouse
+ * and identify events automatically.
+ *
+ * The context is deleted when the view is destroyed. Returns the global
+ * \l instance if \a geoView is \c nullptr.
+ *
+ * \since Esri::ArcGISRuntime 100.5
+ */
+ToolResourceProvider* ToolResourceProvider::forGeoView(GeoView* geoView)
+{
+  ToolResourceProvider* global = instance();
+  if (!geoView)
+    return global;
+
+  const auto it = global->m_viewContexts.constFind(geoView);
+  if (it != global->m_viewContexts.constEnd())
+    return it.value();
+
+  auto context = new ToolResourceProvider(global);
+  context->setGeoView(geoView);
+
+  if (auto mapView = dynamic_cast<MapQuickView*>(geoView))
+  {
+    context->setMap(mapView->map());
+    connect(mapView, &MapQuickView::mapChanged, context, [context, mapView]()
+    {
+      context->setMap(mapView->map());
+    });
+
+    connect(mapView, &MapQuickView::mouseClicked, context, &ToolResourceProvider::onMouseClicked);
+    connect(mapView, &MapQuickView::mousePressed, context, &ToolResourceProvider::onMousePressed);
+    connect(mapView, &MapQuickView::mouseMoved, context, &ToolResourceProvider::onMouseMoved);
+    connect(mapView, &MapQuickView::mouseReleased, context, &ToolResourceProvider::onMouseReleased);
+    connect(mapView, &MapQuickView::mousePressedAndHeld, context, &ToolResourceProvider::onMousePressedAndHeld);
+    connect(mapView, &MapQuickView::mouseDoubleClicked, context, &ToolResourceProvider::onMouseDoubleClicked);
+    connect(mapView, &MapQuickView::identifyLayersCompleted, context, &ToolResourceProvider::onIdentifyLayersCompleted);
+    connect(mapView, &MapQuickView::identifyGraphicsOverlaysCompleted, context, &ToolResourceProvider::onIdentifyGraphicsOverlaysCompleted);
+  }
+  else if (auto sceneView = dynamic_cast<SceneQuickView*>(geoView))
+  {
+    context->setScene(sceneView->arcGISScene());
+    connect(sceneView, &SceneQuickView::sceneChanged, context, [context, sceneView]()
+    {
+      context->setScene(sceneView->arcGISScene());
+    });
+
+    connect(sceneView, &SceneQuickView::mouseClicked, context, &ToolResourceProvider::onMouseClicked);
+    connect(sceneView, &SceneQuickView::mousePressed, context, &ToolResourceProvider::onMousePressed);
+    connect(sceneView, &SceneQuickView::mouseMoved, context, &ToolResourceProvider::onMouseMoved);
+    connect(sceneView, &SceneQuickView::mouseReleased, context, &ToolResourceProvider::onMouseReleased);
+    connect(sceneView, &SceneQuickView::mousePressedAndHeld, context, &ToolResourceProvider::onMousePressedAndHeld);
+    connect(sceneView, &SceneQuickView::mouseDoubleClicked, context, &ToolResourceProvider::onMouseDoubleClicked);
+    connect(sceneView, &SceneQuickView::identifyLayersCompleted, context, &ToolResourceProvider::onIdentifyLayersCompleted);
+    connect(sceneView, &SceneQuickView::identifyGraphicsOverlaysCompleted, context, &ToolResourceProvider::onIdentifyGraphicsOverlaysCompleted);
+  }
+
+  QObject* geoViewObject = dynamic_cast<QObject*>(geoView);
+  if (geoViewObject)
+  {
+    connect(geoViewObject, &QObject::destroyed, global, [global, geoView]()
+    {
+      auto context = global->m_viewContexts.take(geoView);
+      if (context)
+        context->deleteLater();
+    });
+  }
+
+  global->m_viewContexts.insert(geoView, context);
+  return context;
+}
+
 ToolResourceProvider::~ToolResourceProvider()
 {
 
@@ -128,7 +213,19 @@ void ToolResourceProvider::setGeoView(GeoView* newGeoView)
   if (newGeoView == m_geoView)
     return;
 
+  m_mouseMovePending = false;
+  m_mouseMoveTimer->stop();
+
   m_geoView = newGeoView;
+
+  // work out the type of view once, rather than for every mouse event
+  if (dynamic_cast<SceneView*>(m_geoView))
+    m_viewType = ViewType::Scene;
+  else if (dynamic_cast<MapView*>(m_geoView))
+    m_viewType = ViewType::Map;
+  else
+    m_viewType = ViewType::None;
+
   emit geoViewChanged();
 
   if (m_geoView == nullptr)
@@ -143,6 +240,8 @@ void ToolResourceProvider::setGeoView(GeoView* newGeoView)
     connect(geoViewObject, &QObject::destroyed, this, [this]
     {
       m_geoView = nullptr;
+      m_viewType = ViewType::None;
+      m_mouseMovePending = false;
       emit geoViewChanged();
     });
   }
@@ -187,104 +286,156 @@ void ToolResourceProvider::setMouseCursor(const QCursor& cursor)
 
 void ToolResourceProvider::onMouseClicked(QMouseEvent& mouseEvent)
 {
-  emit mouseClicked(mouseEvent);
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::mouseClicked");
 
-  if (!m_geoView)
-    return;
+  flushMouseMove();
 
-  if (m_scene)
-    emit mouseClickedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (m_map)
-    emit mouseClickedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<SceneView*>(m_geoView))
-    emit mouseClickedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<MapView*>(m_geoView))
-    emit mouseClickedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
+  emit mouseClicked(mouseEvent);
+  emitMousePoint(&ToolResourceProvider::mouseClickedPoint, mouseEvent);
 }
 
 void ToolResourceProvider::onMousePressed(QMouseEvent &mouseEvent)
 {
-  emit mousePressed(mouseEvent);
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::mousePressed");
 
-  if (!m_geoView)
-    return;
+  flushMouseMove();
 
-  if (m_scene)
-    emit mousePressedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (m_map)
-    emit mousePressedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<SceneView*>(m_geoView))
-    emit mousePressedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<MapView*>(m_geoView))
-    emit mousePressedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
+  emit mousePressed(mouseEvent);
+  emitMousePoint(&ToolResourceProvider::mousePressedPoint, mouseEvent);
 }
 
 void ToolResourceProvider::onMouseMoved(QMouseEvent &mouseEvent)
 {
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::mouseMoved");
+
   emit mouseMoved(mouseEvent);
 
-  if (!m_geoView)
+  if (!m_coalescingMouseMoves)
+  {
+    emitMousePoint(&ToolResourceProvider::mouseMovedPoint, mouseEvent);
     return;
+  }
 
-  if (m_scene)
-    emit mouseMovedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (m_map)
-    emit mouseMovedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<SceneView*>(m_geoView))
-    emit mouseMovedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<MapView*>(m_geoView))
-    emit mouseMovedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
+  // only the latest position is projected when the timer fires
+  if (m_viewType == ViewType::None || !isSignalConnected(QMetaMethod::fromSignal(&ToolResourceProvider::mouseMovedPoint)))
+    return;
+
+  m_pendingMousePosition = mouseEvent.pos();
+  if (m_mouseMovePending)
+    return;
+
+  m_mouseMovePending = true;
+  m_mouseMoveTimer->start();
 }
 
 void ToolResourceProvider::onMouseReleased(QMouseEvent &mouseEvent)
 {
-  emit mouseReleased(mouseEvent);
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::mouseReleased");
 
-  if (!m_geoView)
-    return;
+  flushMouseMove();
 
-  if (m_scene)
-    emit mouseReleasedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (m_map)
-    emit mouseReleasedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<SceneView*>(m_geoView))
-    emit mouseReleasedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<MapView*>(m_geoView))
-    emit mouseReleasedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
+  emit mouseReleased(mouseEvent);
+  emitMousePoint(&ToolResourceProvider::mouseReleasedPoint, mouseEvent);
 }
 
 void ToolResourceProvider::onMousePressedAndHeld(QMouseEvent &mouseEvent)
 {
-  emit mousePressedAndHeld(mouseEvent);
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::mousePressedAndHeld");
 
-  if (!m_geoView)
-    return;
+  flushMouseMove();
 
-  if (m_scene)
-    emit mousePressedAndHeldPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (m_map)
-    emit mousePressedAndHeldPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<SceneView*>(m_geoView))
-    emit mousePressedAndHeldPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<MapView*>(m_geoView))
-    emit mousePressedAndHeldPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
+  emit mousePressedAndHeld(mouseEvent);
+  emitMousePoint(&ToolResourceProvider::mousePressedAndHeldPoint, mouseEvent);
 }
 
 void ToolResourceProvider::onMouseDoubleClicked(QMouseEvent &mouseEvent)
 {
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::mouseDoubleClicked");
+
+  flushMouseMove();
+
   emit mouseDoubleClicked(mouseEvent);
+  emitMousePoint(&ToolResourceProvider::mouseDoubleClickedPoint, mouseEvent);
+}
 
-  if (!m_geoView)
+/*! \brief Returns whether mouse move positions are projected at most once per frame.
+ *
+ * \sa setCoalescingMouseMoves
+ */
+bool ToolResourceProvider::isCoalescingMouseMoves() const
+{
+  return m_coalescingMouseMoves;
+}
+
+/*! \brief Sets whether mouse move positions are projected at most once per frame to
+ * \a coalescingMouseMoves.
+ *
+ * When \c true, \l mouseMoved is still emitted for every event but
+ * \l mouseMovedPoint is only emitted for the latest position, at most once
+ * every 16 milliseconds. Any pending position is delivered before the next
+ * press, release or click. This avoids projecting every move on devices which
+ * deliver events faster than the display refreshes.
+ *
+ * The default is \c false.
+ */
+void ToolResourceProvider::setCoalescingMouseMoves(bool coalescingMouseMoves)
+{
+  if (coalescingMouseMoves == m_coalescingMouseMoves)
     return;
 
-  if (m_scene)
-    emit mouseDoubleClickedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (m_map)
-    emit mouseDoubleClickedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<SceneView*>(m_geoView))
-    emit mouseDoubleClickedPoint(static_cast<SceneView*>(m_geoView)->screenToBaseSurface(mouseEvent.x(), mouseEvent.y()));
-  else if (dynamic_cast<MapView*>(m_geoView))
-    emit mouseDoubleClickedPoint(static_cast<MapView*>(m_geoView)->screenToLocation(mouseEvent.x(), mouseEvent.y()));
+  m_coalescingMouseMoves = coalescingMouseMoves;
+  if (!m_coalescingMouseMoves)
+    flushMouseMove();
+}
+
+/*! \internal
+ *
+ * Emits \a pointSignal with the map location of \a mouseEvent. The location is
+ * only calculated when something is connected to the signal.
+ */
+void ToolResourceProvider::emitMousePoint(void (ToolResourceProvider::*pointSignal)(const Point&), const QMouseEvent& mouseEvent)
+{
+  if (m_viewType == ViewType::None || !isSignalConnected(QMetaMethod::fromSignal(pointSignal)))
+    return;
+
+  emit (this->*pointSignal)(screenToPoint(mouseEvent.pos()));
+}
+
+/*! \internal
+ */
+Point ToolResourceProvider::screenToPoint(const QPoint& screenPoint) const
+{
+  switch (m_viewType)
+  {
+  case ViewType::Scene:
+    return static_cast<SceneView*>(m_geoView)->screenToBaseSurface(screenPoint.x(), screenPoint.y());
+  case ViewType::Map:
+    return static_cast<MapView*>(m_geoView)->screenToLocation(screenPoint.x(), screenPoint.y());
+  default:
+    break;
+  }
+
+  return Point();
+}
+
+/*! \internal
+ *
+ * Emits \l mouseMovedPoint for a coalesced mouse move which has not been delivered yet.
+ */
+void ToolResourceProvider::flushMouseMove()
+{
+  if (!m_mouseMovePending)
+    return;
+
+  TOOLKIT_PROFILE_SCOPE("ToolResourceProvider::flushMouseMove");
+
+  m_mouseMovePending = false;
+  m_mouseMoveTimer->stop();
+
+  if (m_viewType == ViewType::None)
+    return;
+
+  emit mouseMovedPoint(screenToPoint(m_pendingMousePosition));
 }
 
 void ToolResourceProvider::onIdentifyGraphicsOverlayCompleted(QUuid id, IdentifyGraphicsOverlayResult* identifyResult)
@@ -322,6 +473,9 @@ void ToolResourceProvider::clear()
   m_map = nullptr;
   m_scene = nullptr;
   m_geoView = nullptr;
+  m_viewType = ViewType::None;
+  m_mouseMovePending = false;
+  m_mouseMoveTimer->stop();
 
   emit mapChanged();
   emit sceneChanged();
@@ -0,0 +1,346 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ToolkitProfiler.h"
+
+// Qt headers
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+// STL headers
+#include <algorithm>
+#include <atomic>
+
+Q_LOGGING_CATEGORY(lcToolkitProfiling, "esri.toolkit.profiling")
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+bool enabledFromEnvironment()
+{
+#ifdef TOOLKIT_PROFILING
+  return qgetenv("ARCGIS_TOOLKIT_PROFILING") == "1";
+#else
+  return false;
+#endif // TOOLKIT_PROFILING
+}
+
+// read on every profiled scope, so kept outside the mutex
+std::atomic<bool> s_enabled(enabledFromEnvironment());
+
+const int histogramBuckets = 32;
+
+int histogramBucket(qint64 nanoseconds)
+{
+  qint64 microseconds = nanoseconds / 1000;
+  int bucket = 0;
+  while (microseconds > 1 && bucket < histogramBuckets - 1)
+  {
+    microseconds >>= 1;
+    ++bucket;
+  }
+
+  return bucket;
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ToolkitProfiler
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief Records how long the toolkit spends in its busiest code paths.
+
+  Profiling is opt-in twice over. The toolkit must be built with
+  \c {CONFIG+=toolkit_profiling}, which defines \c TOOLKIT_PROFILING;
+  without it the profiled scopes compile to nothing and \l available is
+  \c false. Recording then starts when \l enabled is set, or when the
+  \c ARCGIS_TOOLKIT_PROFILING environment variable is set to \c 1 when the
+  toolkit is loaded.
+
+  Each scope keeps a count, the total, minimum and maximum duration, and a
+  histogram of durations in power-of-two microsecond buckets. The results
+  can be read from QML with \l statistics or saved with \l dumpToFile.
+
+  When the \c esri.toolkit.profiling logging category is enabled for debug
+  messages, a begin and end trace marker is also logged for every scope.
+ */
+
+/*!
+  \brief Returns the profiler shared by the whole toolkit.
+ */
+ToolkitProfiler* ToolkitProfiler::instance()
+{
+  static ToolkitProfiler s_instance;
+
+  return &s_instance;
+}
+
+/*!
+  \brief Returns whether profiled scopes are currently being recorded.
+ */
+bool ToolkitProfiler::isActive()
+{
+#ifdef TOOLKIT_PROFILING
+  return s_enabled.load(std::memory_order_relaxed);
+#else
+  return false;
+#endif // TOOLKIT_PROFILING
+}
+
+/*!
+  \internal
+ */
+ToolkitProfiler::ToolkitProfiler(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+ToolkitProfiler::~ToolkitProfiler()
+{
+}
+
+/*!
+  \property ToolkitProfiler::available
+  \brief Whether the toolkit was built with profiling support.
+ */
+bool ToolkitProfiler::isAvailable() const
+{
+#ifdef TOOLKIT_PROFILING
+  return true;
+#else
+  return false;
+#endif // TOOLKIT_PROFILING
+}
+
+/*!
+  \property ToolkitProfiler::enabled
+  \brief Whether profiled scopes are recorded.
+
+  Setting this has no effect when \l available is \c false.
+ */
+bool ToolkitProfiler::isEnabled() const
+{
+  return isActive();
+}
+
+void ToolkitProfiler::setEnabled(bool enabled)
+{
+  if (!isAvailable() || enabled == s_enabled.load())
+    return;
+
+  s_enabled = enabled;
+  emit enabledChanged();
+}
+
+/*!
+  \brief Adds one call of \a scope which took \a nanoseconds.
+
+  This is normally called by the \c TOOLKIT_PROFILE_SCOPE macros, and may be
+  called from any thread.
+ */
+void ToolkitProfiler::record(const QString& scope, qint64 nanoseconds)
+{
+  if (!isActive())
+    return;
+
+  QMutexLocker locker(&m_mutex);
+  ScopeStatistics& statistics = m_statistics[scope];
+  if (statistics.histogram.isEmpty())
+  {
+    statistics.histogram.fill(0, histogramBuckets);
+    statistics.minimumNanoseconds = nanoseconds;
+  }
+
+  ++statistics.count;
+  statistics.totalNanoseconds += nanoseconds;
+  statistics.minimumNanoseconds = std::min(statistics.minimumNanoseconds, nanoseconds);
+  statistics.maximumNanoseconds = std::max(statistics.maximumNanoseconds, nanoseconds);
+  ++statistics.histogram[histogramBucket(nanoseconds)];
+}
+
+/*!
+  \brief Returns the names of the scopes recorded so far, in alphabetical order.
+ */
+QStringList ToolkitProfiler::scopes() const
+{
+  QMutexLocker locker(&m_mutex);
+  QStringList names = m_statistics.keys();
+  names.sort();
+  return names;
+}
+
+/*!
+  \brief Returns the statistics recorded for \a scope.
+
+  The map holds \c count, \c totalMicroseconds, \c meanMicroseconds,
+  \c minimumMicroseconds, \c maximumMicroseconds and \c histogram. Entry
+  \c i of the histogram counts the calls which took between \c {2^i} and
+  \c {2^(i+1)} microseconds; trailing empty buckets are left out.
+  The map is empty if \a scope has not been recorded.
+ */
+QVariantMap ToolkitProfiler::statistics(const QString& scope) const
+{
+  QMutexLocker locker(&m_mutex);
+  const auto it = m_statistics.constFind(scope);
+  if (it == m_statistics.constEnd())
+    return QVariantMap();
+
+  return toVariantMap(it.value());
+}
+
+/*!
+  \brief Returns the \l statistics of every recorded scope, keyed by scope name.
+ */
+QVariantMap ToolkitProfiler::allStatistics() const
+{
+  QMutexLocker locker(&m_mutex);
+  QVariantMap result;
+  for (auto it = m_statistics.constBegin(); it != m_statistics.constEnd(); ++it)
+    result.insert(it.key(), toVariantMap(it.value()));
+
+  return result;
+}
+
+/*!
+  \brief Returns \l allStatistics as an indented JSON document.
+ */
+QString ToolkitProfiler::toJson() const
+{
+  QJsonObject root;
+  root.insert(QStringLiteral("available"), isAvailable());
+  root.insert(QStringLiteral("scopes"), QJsonObject::fromVariantMap(allStatistics()));
+
+  return QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Indented));
+}
+
+/*!
+  \brief Writes \l toJson to \a filePath, replacing any existing file.
+
+  Returns \c false if the file could not be written.
+ */
+bool ToolkitProfiler::dumpToFile(const QString& filePath) const
+{
+  QFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+  {
+    qWarning("ToolkitProfiler: cannot write %s", qPrintable(filePath));
+    return false;
+  }
+
+  return file.write(toJson().toUtf8()) != -1;
+}
+
+/*!
+  \brief Discards everything recorded so far.
+ */
+void ToolkitProfiler::reset()
+{
+  QMutexLocker locker(&m_mutex);
+  m_statistics.clear();
+}
+
+/*!
+  \internal
+ */
+QVariantMap ToolkitProfiler::toVariantMap(const ScopeStatistics& statistics)
+{
+  QVariantList histogram;
+  int lastBucket = statistics.histogram.size() - 1;
+  while (lastBucket >= 0 && statistics.histogram.at(lastBucket) == 0)
+    --lastBucket;
+
+  for (int i = 0; i <= lastBucket; ++i)
+    histogram.append(statistics.histogram.at(i));
+
+  QVariantMap result;
+  result.insert(QStringLiteral("count"), statistics.count);
+  result.insert(QStringLiteral("totalMicroseconds"), statistics.totalNanoseconds / 1000.0);
+  result.insert(QStringLiteral("meanMicroseconds"), statistics.count > 0 ? statistics.totalNanoseconds / 1000.0 / statistics.count : 0.0);
+  result.insert(QStringLiteral("minimumMicroseconds"), statistics.minimumNanoseconds / 1000.0);
+  result.insert(QStringLiteral("maximumMicroseconds"), statistics.maximumNanoseconds / 1000.0);
+  result.insert(QStringLiteral("histogram"), histogram);
+  return result;
+}
+
+/*!
+  \fn void ToolkitProfiler::enabledChanged()
+  \brief Signal emitted when the \l enabled property changes.
+ */
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ToolkitProfileScope
+  \internal
+
+  Times the block it is declared in and records it with the \l ToolkitProfiler.
+  Use the \c TOOLKIT_PROFILE_SCOPE macros rather than this class so that the
+  scope disappears from builds without profiling.
+ */
+
+/*!
+  \internal
+ */
+ToolkitProfileScope::ToolkitProfileScope(const char* scope)
+{
+  if (!ToolkitProfiler::isActive())
+    return;
+
+  m_scope = QString::fromLatin1(scope);
+  qCDebug(lcToolkitProfiling).noquote() << "begin" << m_scope;
+  m_timer.start();
+}
+
+/*!
+  \internal
+ */
+ToolkitProfileScope::ToolkitProfileScope(const QString& scope)
+{
+  if (scope.isEmpty() || !ToolkitProfiler::isActive())
+    return;
+
+  m_scope = scope;
+  qCDebug(lcToolkitProfiling).noquote() << "begin" << m_scope;
+  m_timer.start();
+}
+
+/*!
+  \internal
+ */
+ToolkitProfileScope::~ToolkitProfileScope()
+{
+  if (m_scope.isEmpty())
+    return;
+
+  const qint64 nanoseconds = m_timer.nsecsElapsed();
+  ToolkitProfiler::instance()->record(m_scope, nanoseconds);
+  qCDebug(lcToolkitProfiling).noquote() << "end" << m_scope << nanoseconds / 1000.0 << "us";
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ToolkitStartupReport.h"
+
+// Qt headers
+#include <QQuickWindow>
+
+Q_LOGGING_CATEGORY(lcToolkitStartup, "esri.toolkit.startup")
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+double toMilliseconds(qint64 nanoseconds)
+{
+  return nanoseconds / 1000000.0;
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ToolkitStartupReport
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief Reports how much of the time to the first frame the toolkit takes.
+
+  The clock starts when the toolkit types are registered. Until the first
+  frame of a watched window is swapped, the report adds up the time spent
+  registering types and adding the toolkit's image providers
+  (\l registrationTime) and initializing tools (\l toolInitializationTime).
+  When the frame arrives, \l firstFrameTime is set and a summary is logged
+  to the \c esri.toolkit.startup category.
+
+  The toolkit plugin watches the windows created by a
+  QQmlApplicationEngine. Other applications pass their window to
+  \l watchWindow.
+
+  Building the toolkit with \c {CONFIG+=toolkit_startup} compiles its QML
+  ahead of time and defers the initialization of tools until they are
+  first shown or activated. \l startupOptimized tells which build is in
+  use.
+ */
+
+/*!
+  \brief Returns the report shared by the whole toolkit.
+ */
+ToolkitStartupReport* ToolkitStartupReport::instance()
+{
+  static ToolkitStartupReport s_instance;
+
+  return &s_instance;
+}
+
+/*!
+  \internal
+ */
+ToolkitStartupReport::ToolkitStartupReport(QObject* parent) :
+  QObject(parent)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+ToolkitStartupReport::~ToolkitStartupReport()
+{
+}
+
+/*!
+  \property ToolkitStartupReport::startupOptimized
+  \brief Whether the toolkit was built with \c {CONFIG+=toolkit_startup}.
+ */
+bool ToolkitStartupReport::isStartupOptimized() const
+{
+#ifdef TOOLKIT_DEFERRED_INITIALIZATION
+  return true;
+#else
+  return false;
+#endif // TOOLKIT_DEFERRED_INITIALIZATION
+}
+
+/*!
+  \property ToolkitStartupReport::registrationTime
+  \brief The milliseconds spent registering the toolkit types and image
+  providers.
+ */
+double ToolkitStartupReport::registrationTime() const
+{
+  return toMilliseconds(m_registrationNanoseconds);
+}
+
+/*!
+  \property ToolkitStartupReport::toolInitializationTime
+  \brief The milliseconds spent initializing tools before the first frame.
+ */
+double ToolkitStartupReport::toolInitializationTime() const
+{
+  return toMilliseconds(m_toolInitializationNanoseconds);
+}
+
+/*!
+  \property ToolkitStartupReport::firstFrameTime
+  \brief The milliseconds from the toolkit types being registered to the
+  first frame of a watched window, or \c -1 until that frame.
+ */
+double ToolkitStartupReport::firstFrameTime() const
+{
+  return m_firstFrameReported ? toMilliseconds(m_firstFrameNanoseconds) : -1.0;
+}
+
+/*!
+  \brief Starts the clock, unless it is already running.
+ */
+void ToolkitStartupReport::start()
+{
+  if (!m_timer.isValid())
+    m_timer.start();
+}
+
+/*!
+  \brief Adds \a nanoseconds to the \l registrationTime.
+ */
+void ToolkitStartupReport::addRegistrationTime(qint64 nanoseconds)
+{
+  m_registrationNanoseconds += nanoseconds;
+  emit reportChanged();
+}
+
+/*!
+  \brief Returns whether tool initialization times are still recorded,
+  which stops once the first frame has been reported.
+ */
+bool ToolkitStartupReport::isRecording() const
+{
+  return !m_firstFrameReported;
+}
+
+/*!
+  \brief Records that the tool \a toolName took \a nanoseconds to
+  initialize.
+
+  Tools initialized after the first frame are not recorded.
+ */
+void ToolkitStartupReport::addToolInitializationTime(const QString& toolName, qint64 nanoseconds)
+{
+  if (m_firstFrameReported)
+    return;
+
+  m_toolNanoseconds[toolName] += nanoseconds;
+  m_toolInitializationNanoseconds += nanoseconds;
+  emit reportChanged();
+}
+
+/*!
+  \brief Measures the first frame of \a window, which must be a QQuickWindow.
+
+  Only the first frame of the first watched window to draw is reported.
+ */
+void ToolkitStartupReport::watchWindow(QObject* window)
+{
+  auto quickWindow = qobject_cast<QQuickWindow*>(window);
+  if (!quickWindow || m_firstFrameReported)
+    return;
+
+  start();
+
+  // frameSwapped is emitted on the render thread, so only the time is taken there
+  m_windowConnections.append(connect(quickWindow, &QQuickWindow::frameSwapped, this, [this]()
+  {
+    qint64 unset = -1;
+    if (m_firstFrameNanoseconds.compare_exchange_strong(unset, m_timer.nsecsElapsed()))
+      QMetaObject::invokeMethod(this, "reportFirstFrame", Qt::QueuedConnection);
+  }, Qt::DirectConnection));
+}
+
+/*!
+  \brief Returns the report as a map.
+
+  The map holds the \c registrationTime, \c toolInitializationTime and
+  \c firstFrameTime, and a \c tools map of the milliseconds each tool took
+  to initialize before the first frame.
+ */
+QVariantMap ToolkitStartupReport::toVariantMap() const
+{
+  QVariantMap tools;
+  for (auto it = m_toolNanoseconds.constBegin(); it != m_toolNanoseconds.constEnd(); ++it)
+    tools.insert(it.key(), toMilliseconds(it.value()));
+
+  return QVariantMap
+  {
+    {QStringLiteral("startupOptimized"), isStartupOptimized()},
+    {QStringLiteral("registrationTime"), registrationTime()},
+    {QStringLiteral("toolInitializationTime"), toolInitializationTime()},
+    {QStringLiteral("firstFrameTime"), firstFrameTime()},
+    {QStringLiteral("tools"), tools}
+  };
+}
+
+/*!
+  \internal
+ */
+void ToolkitStartupReport::reportFirstFrame()
+{
+  if (m_firstFrameReported)
+    return;
+
+  m_firstFrameReported = true;
+  for (const auto& connection : qAsConst(m_windowConnections))
+    disconnect(connection);
+  m_windowConnections.clear();
+
+  qCInfo(lcToolkitStartup, "First frame after %.1f ms, of which the toolkit spent %.1f ms registering types and %.1f ms initializing %d tools%s",
+         firstFrameTime(), registrationTime(), toolInitializationTime(), m_toolNanoseconds.size(),
+         isStartupOptimized() ? " (startup optimized build)" : "");
+
+  emit reportChanged();
+}
+
+/*!
+  \fn void ToolkitStartupReport::reportChanged()
+  \brief Signal emitted when any of the times in the report change.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,393 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ViewpointObserver.h"
+
+// C++ API headers
+#include "Camera.h"
+#include "MapQuickView.h"
+#include "Polygon.h"
+#include "SceneQuickView.h"
+
+// Qt headers
+#include <QTimer>
+
+// STL headers
+#include <cmath>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// the smallest difference between two headings in degrees, allowing for wrap-around
+double headingDelta(double from, double to)
+{
+  double delta = std::fmod(to - from, 360.0);
+  if (delta > 180.0)
+    delta -= 360.0;
+  else if (delta < -180.0)
+    delta += 360.0;
+
+  return delta;
+}
+
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ViewpointObserver
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.5
+  \brief Shares the viewpoint of a view between the tools that follow it.
+
+  There is one observer per view, returned by \l forGeoView. Rather than
+  each tool querying the view on every \c viewpointChanged, the observer
+  samples the heading, scale and extent at most once per \l sampleInterval
+  while the viewpoint is changing, and publishes only the changes which are
+  larger than the matching epsilon.
+
+  For a MapQuickView the scale is the map scale and the extent is the
+  extent of the visible area. For a SceneQuickView the scale is the
+  altitude of the camera and no extent is published.
+ */
+
+/*!
+  \brief Returns the observer for \a geoView, creating it if needed.
+
+  The observer is deleted when the view is destroyed. Returns \c nullptr
+  if \a geoView is neither a MapQuickView nor a SceneQuickView.
+ */
+ViewpointObserver* ViewpointObserver::forGeoView(GeoView* geoView)
+{
+  if (!geoView)
+    return nullptr;
+
+  auto& registry = observers();
+  const auto it = registry.constFind(geoView);
+  if (it != registry.constEnd())
+    return it.value();
+
+  QObject* geoViewObject = dynamic_cast<QObject*>(geoView);
+  if (!geoViewObject || (!dynamic_cast<MapQuickView*>(geoView) && !dynamic_cast<SceneQuickView*>(geoView)))
+    return nullptr;
+
+  // the view owns its observer
+  auto observer = new ViewpointObserver(geoView, geoViewObject);
+  registry.insert(geoView, observer);
+  return observer;
+}
+
+/*!
+  \internal
+ */
+ViewpointObserver::ViewpointObserver(GeoView* geoView, QObject* parent) :
+  QObject(parent),
+  m_geoView(geoView),
+  m_mapView(dynamic_cast<MapQuickView*>(geoView)),
+  m_sceneView(dynamic_cast<SceneQuickView*>(geoView)),
+  m_sampleTimer(new QTimer(this))
+{
+  // roughly one display frame
+  m_sampleTimer->setSingleShot(true);
+  m_sampleTimer->setInterval(16);
+  connect(m_sampleTimer, &QTimer::timeout, this, &ViewpointObserver::sample);
+
+  if (m_mapView)
+  {
+    connect(m_mapView, &MapQuickView::viewpointChanged, this, &ViewpointObserver::scheduleSample);
+    connect(m_mapView, &MapQuickView::widthChanged, this, &ViewpointObserver::scheduleSample);
+    connect(m_mapView, &MapQuickView::heightChanged, this, &ViewpointObserver::scheduleSample);
+  }
+  else if (m_sceneView)
+  {
+    connect(m_sceneView, &SceneQuickView::viewpointChanged, this, &ViewpointObserver::scheduleSample);
+  }
+
+  sample();
+}
+
+/*!
+  \brief The destructor.
+ */
+ViewpointObserver::~ViewpointObserver()
+{
+  observers().remove(m_geoView);
+}
+
+/*!
+  \brief Returns the observed view.
+ */
+GeoView* ViewpointObserver::geoView() const
+{
+  return m_geoView;
+}
+
+/*!
+  \property ViewpointObserver::heading
+  \brief The heading of the view in degrees at the last published change.
+
+  For a map this is the map rotation.
+ */
+double ViewpointObserver::heading() const
+{
+  return m_heading;
+}
+
+/*!
+  \property ViewpointObserver::scale
+  \brief The map scale, or the camera altitude of a scene, at the last
+  published change.
+ */
+double ViewpointObserver::scale() const
+{
+  return m_scale;
+}
+
+/*!
+  \brief Returns the visible extent of a map at the last published change.
+
+  The extent is empty for a scene.
+ */
+Envelope ViewpointObserver::extent() const
+{
+  return m_extent;
+}
+
+/*!
+  \property ViewpointObserver::sampleInterval
+  \brief The minimum time in milliseconds between samples while the
+  viewpoint changes.
+
+  The default is \c 16, about one display frame.
+ */
+int ViewpointObserver::sampleInterval() const
+{
+  return m_sampleTimer->interval();
+}
+
+void ViewpointObserver::setSampleInterval(int sampleInterval)
+{
+  sampleInterval = qMax(0, sampleInterval);
+  if (sampleInterval == m_sampleTimer->interval())
+    return;
+
+  m_sampleTimer->setInterval(sampleInterval);
+  emit sampleIntervalChanged();
+}
+
+/*!
+  \property ViewpointObserver::headingEpsilon
+  \brief The smallest change of heading in degrees which is published.
+
+  The default is \c 0.01.
+ */
+double ViewpointObserver::headingEpsilon() const
+{
+  return m_headingEpsilon;
+}
+
+void ViewpointObserver::setHeadingEpsilon(double headingEpsilon)
+{
+  if (headingEpsilon == m_headingEpsilon)
+    return;
+
+  m_headingEpsilon = headingEpsilon;
+  emit headingEpsilonChanged();
+}
+
+/*!
+  \property ViewpointObserver::scaleEpsilon
+  \brief The smallest relative change of scale which is published.
+
+  The default is \c 1e-6.
+ */
+double ViewpointObserver::scaleEpsilon() const
+{
+  return m_scaleEpsilon;
+}
+
+void ViewpointObserver::setScaleEpsilon(double scaleEpsilon)
+{
+  if (scaleEpsilon == m_scaleEpsilon)
+    return;
+
+  m_scaleEpsilon = scaleEpsilon;
+  emit scaleEpsilonChanged();
+}
+
+/*!
+  \property ViewpointObserver::extentEpsilon
+  \brief The smallest movement of the extent which is published, as a
+  fraction of the size of the extent.
+
+  The default is \c 1e-6.
+ */
+double ViewpointObserver::extentEpsilon() const
+{
+  return m_extentEpsilon;
+}
+
+void ViewpointObserver::setExtentEpsilon(double extentEpsilon)
+{
+  if (extentEpsilon == m_extentEpsilon)
+    return;
+
+  m_extentEpsilon = extentEpsilon;
+  emit extentEpsilonChanged();
+}
+
+/*!
+  \brief Queries the view immediately and publishes any significant changes.
+
+  Samples are normally taken automatically while the viewpoint changes.
+ */
+void ViewpointObserver::sample()
+{
+  m_sampleTimer->stop();
+
+  double heading = m_heading;
+  double scale = m_scale;
+  Envelope extent;
+
+  if (m_mapView)
+  {
+    heading = m_mapView->mapRotation();
+    scale = m_mapView->mapScale();
+    extent = m_mapView->visibleArea().extent();
+  }
+  else if (m_sceneView)
+  {
+    // one camera query serves every listener
+    const Camera camera = m_sceneView->currentViewpointCamera();
+    heading = camera.heading();
+    scale = camera.location().z();
+  }
+
+  const bool firstSample = !m_sampled;
+  m_sampled = true;
+
+  const double headingChange = headingDelta(m_heading, heading);
+  if (firstSample || std::abs(headingChange) > m_headingEpsilon)
+  {
+    m_heading = heading;
+    emit headingChanged(m_heading, headingChange);
+  }
+
+  const double scaleChange = scale - m_scale;
+  const double scaleReference = std::abs(m_scale) > 0.0 ? std::abs(m_scale) : 1.0;
+  if (firstSample || std::abs(scaleChange) / scaleReference > m_scaleEpsilon)
+  {
+    m_scale = scale;
+    emit scaleChanged(m_scale, scaleChange);
+  }
+
+  if (!extent.isEmpty() && extentMoved(extent))
+  {
+    m_extent = extent;
+    emit extentChanged(m_extent);
+  }
+
+  emit viewpointSampled();
+}
+
+/*!
+  \internal
+ */
+void ViewpointObserver::scheduleSample()
+{
+  if (!m_sampleTimer->isActive())
+    m_sampleTimer->start();
+}
+
+/*!
+  \internal
+ */
+bool ViewpointObserver::extentMoved(const Envelope& extent) const
+{
+  if (m_extent.isEmpty())
+    return true;
+
+  const double tolerance = m_extentEpsilon * qMax(std::abs(m_extent.width()), std::abs(m_extent.height()));
+  return std::abs(extent.xMin() - m_extent.xMin()) > tolerance
+      || std::abs(extent.yMin() - m_extent.yMin()) > tolerance
+      || std::abs(extent.xMax() - m_extent.xMax()) > tolerance
+      || std::abs(extent.yMax() - m_extent.yMax()) > tolerance;
+}
+
+/*!
+  \internal
+ */
+QHash<GeoView*, ViewpointObserver*>& ViewpointObserver::observers()
+{
+  static QHash<GeoView*, ViewpointObserver*> s_observers;
+  return s_observers;
+}
+
+/*!
+  \fn void ViewpointObserver::headingChanged(double heading, double delta)
+  \brief Signal emitted when the heading changes by more than \l headingEpsilon.
+
+  \a heading is the new heading and \a delta the change since the last
+  published heading, both in degrees.
+ */
+
+/*!
+  \fn void ViewpointObserver::scaleChanged(double scale, double delta)
+  \brief Signal emitted when the scale changes by more than \l scaleEpsilon.
+
+  \a scale is the new scale and \a delta the change since the last
+  published scale.
+ */
+
+/*!
+  \fn void ViewpointObserver::extentChanged(const Esri::ArcGISRuntime::Envelope& extent)
+  \brief Signal emitted when the visible \a extent of a map moves by more
+  than \l extentEpsilon.
+ */
+
+/*!
+  \fn void ViewpointObserver::viewpointSampled()
+  \brief Signal emitted after each sample, whether or not anything was published.
+ */
+
+/*!
+  \fn void ViewpointObserver::sampleIntervalChanged()
+  \brief Signal emitted when the \l sampleInterval property changes.
+ */
+
+/*!
+  \fn void ViewpointObserver::headingEpsilonChanged()
+  \brief Signal emitted when the \l headingEpsilon property changes.
+ */
+
+/*!
+  \fn void ViewpointObserver::scaleEpsilonChanged()
+  \brief Signal emitted when the \l scaleEpsilon property changes.
+ */
+
+/*!
+  \fn void ViewpointObserver::extentEpsilonChanged()
+  \brief Signal emitted when the \l extentEpsilon property changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri